@@ -3,32 +3,44 @@ const Logger = require('./Logger');
 const EnhancedEventEmitter = require('./EnhancedEventEmitter');
 const utils = require('./utils');
 const errors = require('./errors');
+const binaryCodec = require('./binaryCodec');
 
 // netstring length for a 65536 bytes payload.
 const NS_MAX_SIZE = 65543;
+// Binary frame length for a 65536 bytes payload.
+const FRAME_MAX_SIZE = 65540;
+// Max size of received data not processed yet (binary data may be larger than
+// regular messages).
+const RECV_BUFFER_MAX_SIZE = (4 * 1024 * 1024) + 16;
 // Max time waiting for a response from the worker subprocess.
 const REQUEST_TIMEOUT = 20000;
 
+// Max number of requests in a worker batch (see Channel::Request in the worker).
+const BATCH_MAX_REQUESTS = 100;
+
 const logger = new Logger('Channel');
 const workerLogger = new Logger('mediasoup-worker');
 
 class Channel extends EnhancedEventEmitter
 {
-	constructor(socket)
+	constructor(socket, format = 'json')
 	{
 		super(logger);
 
-		logger.debug('constructor()');
+		logger.debug('constructor() [format:%s]', format);
 
 		// Unix Socket instance.
 		this._socket = socket;
 
+		// Whether messages are binary encoded instead of JSON netstrings.
+		this._binary = format === 'binary';
+
 		this._pendingSent = new Map();
 
 		// Buffer for incomplete data received from the Channel's socket.
 		this._recvBuffer = null;
 
-		// Last binary notification received.
+		// Last binary notification or response received.
 		this._lastBinaryNotification = null;
 
 		// Read Channel responses/notifications from the worker.
@@ -43,7 +55,7 @@ class Channel extends EnhancedEventEmitter
 				this._recvBuffer = Buffer.concat([ this._recvBuffer, buffer ],
 					this._recvBuffer.length + buffer.length);
 
-				if (this._recvBuffer.length > NS_MAX_SIZE)
+				if (this._recvBuffer.length > RECV_BUFFER_MAX_SIZE)
 				{
 					logger.error('recvBuffer is full, discarding all data in it');
 
@@ -56,6 +68,13 @@ class Channel extends EnhancedEventEmitter
 				}
 			}
 
+			if (this._binary)
+			{
+				this._readFrames();
+
+				return;
+			}
+
 			while (true) // eslint-disable-line no-constant-condition
 			{
 				let nsPayload;
@@ -127,8 +146,7 @@ class Channel extends EnhancedEventEmitter
 					// Reset.
 					this._lastBinaryNotification = null;
 
-					// Emit.
-					process.nextTick(() => this.emit(msg.targetId, msg.event, msg.data, nsPayload));
+					this._processBinaryData(msg, nsPayload);
 				}
 
 				// Remove the read payload from the recvBuffer.
@@ -180,10 +198,26 @@ class Channel extends EnhancedEventEmitter
 		logger.debug('request() [method:%s, id:%s]', method, id);
 
 		const request = { id, method, internal, data };
-		const ns = netstring.nsWrite(JSON.stringify(request));
+		let ns;
+
+		if (this._binary)
+		{
+			const payload = binaryCodec.encode(request);
 
-		if (Buffer.byteLength(ns) > NS_MAX_SIZE)
-			return Promise.reject(new Error('request too big'));
+			ns = Buffer.allocUnsafe(4 + payload.length);
+			ns.writeUInt32BE(payload.length, 0);
+			payload.copy(ns, 4);
+
+			if (ns.length > FRAME_MAX_SIZE)
+				return Promise.reject(new Error('request too big'));
+		}
+		else
+		{
+			ns = netstring.nsWrite(JSON.stringify(request));
+
+			if (Buffer.byteLength(ns) > NS_MAX_SIZE)
+				return Promise.reject(new Error('request too big'));
+		}
 
 		// This may raise if closed or remote side ended.
 		try
@@ -237,6 +271,135 @@ class Channel extends EnhancedEventEmitter
 		});
 	}
 
+	/**
+	 * Send several requests in a single round trip. The worker runs them in
+	 * order, and a rejected request does not prevent the next ones from running.
+	 * Requests are sent in batches of up to 100. If the responses of a batch do
+	 * not fit in a single message, its requests not run yet are rejected.
+	 *
+	 * @param {Array<Object>} requests - Objects with method, internal and data.
+	 *
+	 * @return {Promise} Resolves with an Object per request, in the same order,
+	 *   having either the response data or the rejection error.
+	 */
+	batch(requests)
+	{
+		logger.debug('batch() [requests:%d]', requests.length);
+
+		const promises = [];
+
+		for (let idx = 0; idx < requests.length; idx += BATCH_MAX_REQUESTS)
+		{
+			const batchRequests = requests
+				.slice(idx, idx + BATCH_MAX_REQUESTS)
+				.map(({ method, internal, data }) => ({ method, internal, data }));
+
+			promises.push(
+				this.request('worker.batch', null, { requests: batchRequests }));
+		}
+
+		return Promise.all(promises)
+			.then((batches) =>
+			{
+				return [].concat(...batches.map(({ responses }) => responses))
+					.map((response) =>
+					{
+						if (response.accepted)
+							return { data: response.data };
+						else
+							return { error: new Error(response.reason) };
+					});
+			});
+	}
+
+	_readFrames()
+	{
+		// Each frame is a 4 bytes length followed by the payload.
+		while (this._recvBuffer && this._recvBuffer.length >= 4)
+		{
+			const payloadLength = this._recvBuffer.readUInt32BE(0);
+
+			// Incomplete frame.
+			if (this._recvBuffer.length < 4 + payloadLength)
+				return;
+
+			const payload = this._recvBuffer.slice(4, 4 + payloadLength);
+
+			// We are not waiting for binary data for a previous binary event.
+			if (!this._lastBinaryNotification)
+			{
+				try
+				{
+					// We can receive binary messages (Channel messages) or log strings.
+					switch (payload[0])
+					{
+						// 68 = 'D' (a debug log).
+						case 68:
+							workerLogger.debug(payload.toString('utf8', 1));
+							break;
+
+						// 87 = 'W' (a warning log).
+						case 87:
+							workerLogger.warn(payload.toString('utf8', 1));
+							break;
+
+						// 69 = 'E' (an error log).
+						case 69:
+							workerLogger.error(payload.toString('utf8', 1));
+							break;
+
+						default:
+							this._processMessage(binaryCodec.decode(payload));
+					}
+				}
+				catch (error)
+				{
+					logger.error('received invalid message: %s', error.message);
+				}
+			}
+			// This is binary data for a previous binary event, so emit the full
+			// binary event with its binary data.
+			else
+			{
+				const msg = this._lastBinaryNotification;
+
+				// Reset.
+				this._lastBinaryNotification = null;
+
+				this._processBinaryData(msg, payload);
+			}
+
+			// Remove the read frame from the recvBuffer.
+			this._recvBuffer = this._recvBuffer.slice(4 + payloadLength);
+
+			if (!this._recvBuffer.length)
+				this._recvBuffer = null;
+		}
+	}
+
+	_processBinaryData(msg, binary)
+	{
+		// A binary response resolves its Request with the binary data on it.
+		if (msg.id)
+		{
+			const sent = this._pendingSent.get(msg.id);
+
+			if (!sent)
+			{
+				logger.error('received Response does not match any sent Request');
+
+				return;
+			}
+
+			sent.resolve(Object.assign({}, msg.data, { binary }));
+		}
+		// Otherwise emit the full binary event with its binary data.
+		else
+		{
+			process.nextTick(() => this.emit(msg.targetId, msg.event, msg.data, binary));
+		}
+	}
+
 	_processMessage(msg)
 	{
 		// If a Response, retrieve its associated Request.
@@ -247,6 +410,14 @@ class Channel extends EnhancedEventEmitter
 			else
 				logger.error('request failed [id:%s, reason:"%s"]', msg.id, msg.reason);
 
+			// If a binary response, keep this message until the binary data arrives.
+			if (msg.binary)
+			{
+				this._lastBinaryNotification = msg;
+
+				return;
+			}
+
 			const sent = this._pendingSent.get(msg.id);
 
 			if (!sent)
@@ -262,7 +433,7 @@ class Channel extends EnhancedEventEmitter
 				sent.reject(new Error(msg.reason));
 		}
 		// If a Notification emit it to the corresponding entity.
-		else if (msg.targetId && msg.event)
+		else if (msg.targetId !== undefined && msg.event)
 		{
 			// If a binary notification, keep this message until the binary
 			// data arrives.
@@ -275,6 +446,14 @@ class Channel extends EnhancedEventEmitter
 
 			this.emit(msg.targetId, msg.event, msg.data);
 		}
+		// If several coalesced Notifications emit them in order.
+		else if (Array.isArray(msg.events))
+		{
+			for (const event of msg.events)
+			{
+				this.emit(event.targetId, event.event, event.data);
+			}
+		}
 		// Otherwise unexpected message.
 		else
 		{
@@ -680,6 +680,39 @@ class Consumer extends EnhancedEventEmitter
 			});
 	}
 
+	/**
+	 * Whether comfort noise (CN or Opus DTX) packets should not be forwarded once
+	 * the remote already got one since the last speech packet.
+	 *
+	 * @param {Boolean} enabled
+	 */
+	suppressComfortNoise(enabled)
+	{
+		logger.debug('suppressComfortNoise() [enabled:%s]', enabled);
+
+		if (this._closed)
+		{
+			logger.error('suppressComfortNoise() | Consumer closed');
+
+			return;
+		}
+
+		if (this.kind !== 'audio')
+			return;
+
+		this._channel.request(
+			'consumer.suppressComfortNoise', this._internal, { enabled: Boolean(enabled) })
+			.then(() =>
+			{
+				logger.debug('"consumer.suppressComfortNoise" request succeeded');
+			})
+			.catch((error) =>
+			{
+				logger.error(
+					'"consumer.suppressComfortNoise" request failed: %s', String(error));
+			});
+	}
+
 	/**
 	 * Get the Consumer stats.
 	 *
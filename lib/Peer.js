@@ -741,9 +741,12 @@ class Peer extends EnhancedEventEmitter
 	}
 
 	/**
+	 * Create a Consumer for the given Producer without creating it in the
+	 * worker, so the caller can group the requests of several Consumers.
+	 *
 	 * @private
 	 */
-	addConsumerForProducer(producer, notifyClient = true)
+	createConsumerForProducer(producer)
 	{
 		const internal =
 		{
@@ -780,19 +783,16 @@ class Peer extends EnhancedEventEmitter
 			this._sendNotification(method, data2);
 		});
 
-		this._channel.request(
-			'router.createConsumer', internal, { kind: consumer.kind })
-			.then(() =>
-			{
-				logger.debug('"router.createConsumer" request succeeded');
-			})
-			.catch((error) =>
-			{
-				logger.error('"router.createConsumer" request failed: %s', String(error));
-
-				throw error;
-			});
+		return consumer;
+	}
 
+	/**
+	 * Emit a Consumer created by createConsumerForProducer().
+	 *
+	 * @private
+	 */
+	announceConsumer(consumer, notifyClient = true)
+	{
 		this.safeEmit('newconsumer', consumer);
 
 		if (notifyClient)
@@ -7,6 +7,7 @@ const Peer = require('./Peer');
 const Consumer = require('./Consumer');
 const PlainRtpTransport = require('./PlainRtpTransport');
 const plugins = require('./plugins');
+const statsSnapshot = require('./statsSnapshot');
 
 const logger = new Logger('Room');
 
@@ -42,6 +43,16 @@ class Room extends EnhancedEventEmitter
 		// @type {Map<producerId, Producer>}
 		this._producers = new Map();
 
+		// Peers whose Consumers are still being created. They get those created
+		// meanwhile in the join response instead of in a notification.
+		// @type {Set<Peer>}
+		this._joiningPeers = new Set();
+
+		// Open ActiveSpeakerDetector instances. The worker side detection runs
+		// while there is at least one of them.
+		// @type {Set<ActiveSpeakerDetector>}
+		this._activeSpeakerDetectors = new Set();
+
 		this._handleWorkerNotifications();
 	}
 
@@ -147,6 +158,43 @@ class Room extends EnhancedEventEmitter
 			});
 	}
 
+	/**
+	 * Get the stats of every Transport, Producer stream and Consumer with a
+	 * single request, along with the forwarding and retransmission latency
+	 * histograms of the Room.
+	 *
+	 * @param {Boolean} [delta=false] - Report counters since the previous call.
+	 *
+	 * @return {Promise}
+	 */
+	getStats(delta = false)
+	{
+		logger.debug('getStats()');
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Room closed'));
+
+		return this._channel.request('router.getStats', this._internal, { delta })
+			.then((data) =>
+			{
+				logger.debug('"router.getStats" request succeeded');
+
+				const snapshot = statsSnapshot.parse(data.binary);
+
+				// Histograms of the time (in microseconds) spent by sampled packets
+				// inside the worker until forwarded or retransmitted.
+				snapshot.latency = data.latency;
+
+				return snapshot;
+			})
+			.catch((error) =>
+			{
+				logger.error('"router.getStats" request failed: %s', String(error));
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Get Peer by name.
 	 *
@@ -194,21 +242,26 @@ class Room extends EnhancedEventEmitter
 					{
 						const { peerName, rtpCapabilities, spy, appData } = request;
 						const peer = this._createPeer(peerName, rtpCapabilities, spy, appData);
-						const response =
-						{
-							peers : this.peers
-								.filter((otherPeer) => otherPeer !== peer && !otherPeer.spy)
-								.map((otherPeer) =>
-								{
-									const consumers = peer.consumers
-										.filter((consumer) => consumer.peer === otherPeer)
-										.map((consumer) => consumer.toJson());
 
-									return Object.assign({ consumers }, otherPeer.toJson());
-								})
-						};
-
-						return response;
+						return this._createConsumersForPeer(peer)
+							.then(() =>
+							{
+								const response =
+								{
+									peers : this.peers
+										.filter((otherPeer) => otherPeer !== peer && !otherPeer.spy)
+										.map((otherPeer) =>
+										{
+											const consumers = peer.consumers
+												.filter((consumer) => consumer.peer === otherPeer)
+												.map((consumer) => consumer.toJson());
+
+											return Object.assign({ consumers }, otherPeer.toJson());
+										})
+								};
+
+								return response;
+							});
 					}
 
 					default:
@@ -223,15 +276,58 @@ class Room extends EnhancedEventEmitter
 			});
 	}
 
-	createActiveSpeakerDetector()
+	/**
+	 * Create an ActiveSpeakerDetector.
+	 *
+	 * @param {Object} [options]
+	 * @param {Number} [options.hysteresis] - Audio level (dB) by which a speaker
+	 *   must exceed the current active speaker to replace it.
+	 *
+	 * @return {ActiveSpeakerDetector}
+	 */
+	createActiveSpeakerDetector(options = {})
 	{
 		logger.debug('createActiveSpeakerDetector()');
 
-		const activeSpeakerDetector = new plugins.ActiveSpeakerDetector(this);
+		const activeSpeakerDetector = new plugins.ActiveSpeakerDetector(this, options);
 
 		return activeSpeakerDetector;
 	}
 
+	/**
+	 * Forward just the audio of the top-K loudest Producers (based on their
+	 * ssrc-audio-level values) to every Consumer.
+	 *
+	 * @param {Number} [topK] - 0 or null means forwarding every audio Producer.
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setAudioTopK(topK)
+	{
+		logger.debug('setAudioTopK() [topK:%s]', topK);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Room closed'));
+
+		if (typeof topK !== 'number' || topK < 0)
+			topK = 0;
+
+		return this._channel.request(
+			'router.setAudioTopK', this._internal, { topK })
+			.then(() =>
+			{
+				logger.debug('"router.setAudioTopK" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"router.setAudioTopK" request failed: %s', String(error));
+
+				throw error;
+			});
+	}
+
 	createRtpStreamer(producer, options)
 	{
 		logger.debug('createRtpStreamer()');
@@ -380,19 +476,6 @@ class Room extends EnhancedEventEmitter
 			}
 		});
 
-		// Create a Consumer for this Peer associated to each Producer in other
-		// Peers.
-		for (const otherPeer of this._peers.values())
-		{
-			if (otherPeer === peer)
-				continue;
-
-			for (const producer of otherPeer.producers)
-			{
-				peer.addConsumerForProducer(producer, false);
-			}
-		}
-
 		// Listen for new Producers so we can create new Consumers for other Peers.
 		peer.on('@newproducer', (producer) =>
 		{
@@ -422,14 +505,128 @@ class Room extends EnhancedEventEmitter
 		this._producers.set(producer.id, producer);
 		producer.on('@close', () => this._producers.delete(producer.id));
 
-		// Tell all the Peers (but us) about the new Producer.
+		// Tell all the Peers (but us) about the new Producer. Their Consumers are
+		// created in the worker with a single request.
+		const consumers = new Map();
+
 		for (const otherPeer of this._peers.values())
 		{
 			if (otherPeer === producer.peer)
 				continue;
 
-			otherPeer.addConsumerForProducer(producer);
+			consumers.set(otherPeer.createConsumerForProducer(producer), otherPeer);
+		}
+
+		if (consumers.size === 0)
+			return;
+
+		const internal =
+		{
+			routerId   : this._internal.routerId,
+			producerId : producer.id
+		};
+		const data =
+		{
+			kind      : producer.kind,
+			consumers : Array.from(consumers.keys())
+				.map((consumer) => ({ consumerId: consumer.id }))
+		};
+
+		this._channel.request('router.createConsumers', internal, data)
+			.then(() =>
+			{
+				logger.debug('"router.createConsumers" request succeeded');
+			})
+			.catch((error) =>
+			{
+				logger.error('"router.createConsumers" request failed: %s', String(error));
+			});
+
+		for (const [ consumer, otherPeer ] of consumers)
+		{
+			otherPeer.announceConsumer(consumer, !this._joiningPeers.has(otherPeer));
+		}
+	}
+
+	/**
+	 * Create a Consumer for the given Peer associated to each Producer in other
+	 * Peers, all of them in a single request to the worker. Just the Consumers
+	 * created in the worker are announced.
+	 *
+	 * @private
+	 *
+	 * @return {Promise}
+	 */
+	_createConsumersForPeer(peer)
+	{
+		const consumers = [];
+
+		for (const otherPeer of this._peers.values())
+		{
+			if (otherPeer === peer)
+				continue;
+
+			for (const producer of otherPeer.producers)
+			{
+				consumers.push(peer.createConsumerForProducer(producer));
+			}
 		}
+
+		if (consumers.length === 0)
+			return Promise.resolve();
+
+		const requests = consumers.map((consumer) =>
+		{
+			const internal =
+			{
+				routerId   : this._internal.routerId,
+				consumerId : consumer.id,
+				producerId : consumer.source.id
+			};
+
+			return {
+				method   : 'router.createConsumer',
+				internal : internal,
+				data     : { kind: consumer.kind }
+			};
+		});
+
+		// The client never heard about these Consumers, so don't notify it when
+		// closing the ones not created in the worker.
+		const discardConsumer = (consumer) =>
+		{
+			consumer.removeAllListeners('@notify');
+			consumer.close(false);
+		};
+
+		this._joiningPeers.add(peer);
+
+		return this._channel.batch(requests)
+			.then((results) =>
+			{
+				results.forEach(({ error }, idx) =>
+				{
+					const consumer = consumers[idx];
+
+					if (error)
+					{
+						logger.error('"router.createConsumer" request failed: %s', String(error));
+
+						discardConsumer(consumer);
+					}
+					else if (!consumer.closed)
+					{
+						peer.announceConsumer(consumer, false);
+					}
+				});
+			})
+			.catch((error) =>
+			{
+				logger.error('"router.createConsumer" batch request failed: %s', String(error));
+
+				consumers.forEach(discardConsumer);
+			})
+			.then(() => this._joiningPeers.delete(peer));
 	}
 
 	_createPlainRtpTransport(options)
@@ -462,6 +659,65 @@ class Room extends EnhancedEventEmitter
 			});
 	}
 
+	/**
+	 * Register an ActiveSpeakerDetector and enable the worker side active
+	 * speaker detection (or update its options).
+	 *
+	 * @private
+	 *
+	 * @param {ActiveSpeakerDetector} activeSpeakerDetector
+	 * @param {Object} [options]
+	 * @param {Number} [options.hysteresis]
+	 */
+	_addActiveSpeakerDetector(activeSpeakerDetector, options)
+	{
+		this._activeSpeakerDetectors.add(activeSpeakerDetector);
+		this._setActiveSpeakerEvent(true, options);
+	}
+
+	/**
+	 * Unregister an ActiveSpeakerDetector and disable the worker side active
+	 * speaker detection if it was the last one.
+	 *
+	 * @private
+	 *
+	 * @param {ActiveSpeakerDetector} activeSpeakerDetector
+	 */
+	_removeActiveSpeakerDetector(activeSpeakerDetector)
+	{
+		if (!this._activeSpeakerDetectors.delete(activeSpeakerDetector))
+			return;
+
+		if (this._activeSpeakerDetectors.size === 0)
+			this._setActiveSpeakerEvent(false);
+	}
+
+	/**
+	 * Enable or disable the worker side active speaker detection.
+	 *
+	 * @private
+	 *
+	 * @param {Boolean} enabled
+	 * @param {Object} [options]
+	 * @param {Number} [options.hysteresis]
+	 */
+	_setActiveSpeakerEvent(enabled, { hysteresis } = {})
+	{
+		logger.debug('_setActiveSpeakerEvent() [enabled:%s]', enabled);
+
+		this._channel.request(
+			'router.setActiveSpeakerEvent', this._internal, { enabled, hysteresis })
+			.then(() =>
+			{
+				logger.debug('"router.setActiveSpeakerEvent" request succeeded');
+			})
+			.catch((error) =>
+			{
+				logger.error(
+					'"router.setActiveSpeakerEvent" request failed: %s', String(error));
+			});
+	}
+
 	_handleWorkerNotifications()
 	{
 		// Subscribe to notifications.
@@ -496,6 +752,17 @@ class Room extends EnhancedEventEmitter
 					break;
 				}
 
+				case 'activespeakerchange':
+				{
+					const producer = data.producerId !== undefined
+						? this._producers.get(data.producerId)
+						: undefined;
+
+					this.emit('@activespeakerchange', producer);
+
+					break;
+				}
+
 				default:
 				{
 					logger.error('ignoring unknown event "%s"', event);
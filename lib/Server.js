@@ -9,6 +9,8 @@ const ortc = require('./ortc');
 const Worker = require('./Worker');
 
 const DEFAULT_NUM_WORKERS = Object.keys(os.cpus()).length;
+// Event loop utilization difference below which Workers are equally loaded.
+const UTILIZATION_MARGIN = 0.05;
 const VALID_WORKER_PARAMETERS =
 [
 	'logLevel',
@@ -20,7 +22,8 @@ const VALID_WORKER_PARAMETERS =
 	'rtcMinPort',
 	'rtcMaxPort',
 	'dtlsCertificateFile',
-	'dtlsPrivateKeyFile'
+	'dtlsPrivateKeyFile',
+	'metricsInterval'
 ];
 
 const logger = new Logger('Server');
@@ -46,6 +49,9 @@ class Server extends EnhancedEventEmitter
 		// Latest worker idx used.
 		this._latestWorkerIdx = 0;
 
+		// Shared metrics files of the workers.
+		this._metricsFiles = [];
+
 		// Clone options.
 		options = utils.cloneObject(options);
 
@@ -59,6 +65,12 @@ class Server extends EnhancedEventEmitter
 		const workerOptions = options.worker;
 		delete options.worker;
 
+		// Directory for the shared metrics files of the workers (if given).
+		const metricsDir =
+			check.nonEmptyString(options.metricsDir) ? path.resolve(options.metricsDir) : null;
+
+		delete options.metricsDir;
+
 		// Normalize some options.
 
 		if (!check.array(options.logTags))
@@ -88,6 +100,9 @@ class Server extends EnhancedEventEmitter
 		if (check.nonEmptyString(options.dtlsPrivateKeyFile))
 			options.dtlsPrivateKeyFile = path.resolve(options.dtlsPrivateKeyFile);
 
+		if (!check.positive(options.metricsInterval))
+			delete options.metricsInterval;
+
 		// Remove rtcMinPort/rtcMaxPort (will be added per worker).
 
 		const totalRtcMinPort = options.rtcMinPort;
@@ -143,6 +158,15 @@ class Server extends EnhancedEventEmitter
 			workerParameters.push(`--rtcMinPort=${rtcMinPort}`);
 			workerParameters.push(`--rtcMaxPort=${rtcMaxPort}`);
 
+			if (metricsDir)
+			{
+				const metricsFile =
+					path.join(metricsDir, `mediasoup-worker-${serverId}-${i}.metrics`);
+
+				workerParameters.push(`--metricsFile=${metricsFile}`);
+				this._metricsFiles.push(metricsFile);
+			}
+
 			// Create a Worker instance (do it in a separate method to avoid creating
 			// a callback function within a loop).
 			this._addWorker(new Worker(workerId, workerParameters, workerOptions));
@@ -164,6 +188,17 @@ class Server extends EnhancedEventEmitter
 		return this._workers.size;
 	}
 
+	/**
+	 * Shared metrics files of the workers (empty unless the metricsDir option
+	 * was given). Read them with mediasoup.readMetrics().
+	 *
+	 * @type {Array<String>}
+	 */
+	get metricsFiles()
+	{
+		return this._metricsFiles.slice(0);
+	}
+
 	/**
 	 * Close the Server.
 	 */
@@ -270,12 +305,7 @@ class Server extends EnhancedEventEmitter
 		}
 		else
 		{
-			// Increase latest worker idx.
-			this._latestWorkerIdx++;
-
-			// Move to 0 if out of range.
-			if (this._latestWorkerIdx === this._workers.size)
-				this._latestWorkerIdx = 0;
+			this._latestWorkerIdx = this._getLeastLoadedWorkerIdx();
 		}
 
 		const worker = Array.from(this._workers)[this._latestWorkerIdx];
@@ -286,6 +316,49 @@ class Server extends EnhancedEventEmitter
 		return room;
 	}
 
+	/**
+	 * Get the idx of the Worker with the lowest event loop utilization. Workers
+	 * with a similar utilization are told apart by their number of Rooms, since
+	 * Rooms created after the latest loop metrics are not reflected on them. If
+	 * any Worker did not report its loop metrics yet just pick the next one.
+	 *
+	 * @private
+	 *
+	 * @return {Number}
+	 */
+	_getLeastLoadedWorkerIdx()
+	{
+		const workers = Array.from(this._workers);
+		const nextIdx = (this._latestWorkerIdx + 1) % workers.length;
+
+		if (workers.some((worker) => !worker.loopMetrics))
+			return nextIdx;
+
+		const minUtilization =
+			Math.min(...workers.map((worker) => worker.loopMetrics.utilization));
+		let bestIdx = nextIdx;
+
+		// Start after the latest used Worker so ties are spread.
+		for (let i = 0; i < workers.length; i++)
+		{
+			const idx = (nextIdx + i) % workers.length;
+			const worker = workers[idx];
+
+			if (worker.loopMetrics.utilization > minUtilization + UTILIZATION_MARGIN)
+				continue;
+
+			if (
+				workers[bestIdx].loopMetrics.utilization > minUtilization + UTILIZATION_MARGIN ||
+				worker.numRooms < workers[bestIdx].numRooms
+			)
+			{
+				bestIdx = idx;
+			}
+		}
+
+		return bestIdx;
+	}
+
 	_addWorker(worker)
 	{
 		// Store the Worker instance and remove it when closed.
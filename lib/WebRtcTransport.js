@@ -321,6 +321,42 @@ class WebRtcTransport extends EnhancedEventEmitter
 			});
 	}
 
+	/**
+	 * Forward just the video of the N most recently active speakers. Other video
+	 * Consumers are paused in the worker.
+	 *
+	 * @param {Number} [lastN] - Null or a negative value disables Last-N.
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setLastN(lastN)
+	{
+		logger.debug('setLastN() [lastN:%s]', lastN);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('WebRtcTransport closed'));
+		else if (this.direction !== 'recv')
+			return Promise.reject(new Error('invalid WebRtcTransport direction'));
+
+		if (typeof lastN !== 'number' || lastN < 0)
+			lastN = undefined;
+
+		return this._channel.request(
+			'transport.setLastN', this._internal, { lastN })
+			.then(() =>
+			{
+				logger.debug('"transport.setLastN" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"transport.setLastN" request failed: %s', String(error));
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Tell the WebRtcTransport to generate new uFrag and password values.
 	 *
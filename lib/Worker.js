@@ -44,6 +44,9 @@ else
 	path.join(__dirname, '..', 'worker', 'out', 'Release', 'mediasoup-worker');
 }
 
+// Channel target of the notifications of the worker itself.
+const WORKER_TARGET_ID = 0;
+
 // Set environtment variable for the worker.
 process.env.MEDIASOUP_CHANNEL_FD = String(CHANNEL_FD);
 
@@ -71,6 +74,15 @@ class Worker extends EventEmitter
 				stdio : [ 'ignore', 'pipe', 'pipe', 'pipe' ]
 			};
 
+		// Channel messages format ('json' or 'binary').
+		const channelFormat = options.channelFormat === 'binary' ? 'binary' : 'json';
+
+		if (channelFormat === 'binary')
+		{
+			spawnOptions.env =
+				Object.assign({}, process.env, { MEDIASOUP_CHANNEL_FORMAT: 'binary' });
+		}
+
 		// Closed flag.
 		this._closed = false;
 
@@ -78,7 +90,7 @@ class Worker extends EventEmitter
 		this._child = spawn(workerPath, spawnArgs, spawnOptions);
 
 		// Channel instance.
-		this._channel = new Channel(this._child.stdio[CHANNEL_FD]);
+		this._channel = new Channel(this._child.stdio[CHANNEL_FD], channelFormat);
 
 		// Set of Room instances.
 		this._rooms = new Set();
@@ -145,6 +157,46 @@ class Worker extends EventEmitter
 				});
 			}, 1000);	
 		}
+
+		// Latest event loop metrics of the worker.
+		this._loopMetrics = null;
+
+		this._channel.on(WORKER_TARGET_ID, (event, data) =>
+		{
+			switch (event)
+			{
+				case 'loopmetrics':
+				{
+					this._loopMetrics = data;
+
+					break;
+				}
+
+				default:
+					logger.error('ignoring unknown event "%s"', event);
+			}
+		});
+	}
+
+	/**
+	 * Number of Rooms.
+	 *
+	 * @type {Number}
+	 */
+	get numRooms()
+	{
+		return this._rooms.size;
+	}
+
+	/**
+	 * Event loop metrics of the worker in the latest period (null until the
+	 * first one is received).
+	 *
+	 * @type {Object}
+	 */
+	get loopMetrics()
+	{
+		return this._loopMetrics;
 	}
 
 	close()
@@ -0,0 +1,260 @@
+/**
+ * Compact binary encoding of Channel messages. It must match the
+ * Channel::BinaryCodec implementation in the worker.
+ *
+ * Every value starts with a 1 byte type followed by its data (big-endian):
+ * - null, false, true: no data.
+ * - int32, uint32, double: 4, 4 and 8 bytes.
+ * - string: 4 bytes length and UTF-8 bytes.
+ * - array: 4 bytes count and items.
+ * - object: 4 bytes count and, per member, 2 bytes key length, key and value.
+ */
+
+const TYPE_NULL = 0;
+const TYPE_FALSE = 1;
+const TYPE_TRUE = 2;
+const TYPE_INT32 = 3;
+const TYPE_UINT32 = 4;
+const TYPE_DOUBLE = 5;
+const TYPE_STRING = 6;
+const TYPE_ARRAY = 7;
+const TYPE_OBJECT = 8;
+
+const MAX_DEPTH = 32;
+
+/**
+ * Encode the given value.
+ *
+ * @param {Any} value
+ *
+ * @return {Buffer}
+ */
+exports.encode = function(value)
+{
+	const chunks = [];
+
+	encodeValue(value, chunks);
+
+	return Buffer.concat(chunks);
+};
+
+/**
+ * Decode the given buffer.
+ *
+ * @param {Buffer} buffer
+ *
+ * @return {Any}
+ * @throws {Error} if the buffer is not a valid encoded value.
+ */
+exports.decode = function(buffer)
+{
+	const state = { offset: 0 };
+	const value = decodeValue(buffer, state, 0);
+
+	if (state.offset !== buffer.length)
+		throw new Error('trailing data in binary message');
+
+	return value;
+};
+
+function encodeValue(value, chunks)
+{
+	switch (typeof value)
+	{
+		case 'boolean':
+		{
+			chunks.push(Buffer.from([ value ? TYPE_TRUE : TYPE_FALSE ]));
+			break;
+		}
+
+		case 'number':
+		{
+			let chunk;
+
+			if (Number.isInteger(value) && value >= -2147483648 && value <= 2147483647)
+			{
+				chunk = Buffer.allocUnsafe(5);
+				chunk[0] = TYPE_INT32;
+				chunk.writeInt32BE(value, 1);
+			}
+			else if (Number.isInteger(value) && value >= 0 && value <= 4294967295)
+			{
+				chunk = Buffer.allocUnsafe(5);
+				chunk[0] = TYPE_UINT32;
+				chunk.writeUInt32BE(value, 1);
+			}
+			else
+			{
+				chunk = Buffer.allocUnsafe(9);
+				chunk[0] = TYPE_DOUBLE;
+				chunk.writeDoubleBE(value, 1);
+			}
+
+			chunks.push(chunk);
+			break;
+		}
+
+		case 'string':
+		{
+			const data = Buffer.from(value, 'utf8');
+			const header = Buffer.allocUnsafe(5);
+
+			header[0] = TYPE_STRING;
+			header.writeUInt32BE(data.length, 1);
+			chunks.push(header, data);
+			break;
+		}
+
+		case 'object':
+		{
+			if (value === null)
+			{
+				chunks.push(Buffer.from([ TYPE_NULL ]));
+			}
+			else if (Array.isArray(value))
+			{
+				const header = Buffer.allocUnsafe(5);
+
+				header[0] = TYPE_ARRAY;
+				header.writeUInt32BE(value.length, 1);
+				chunks.push(header);
+
+				for (const item of value)
+				{
+					encodeValue(item, chunks);
+				}
+			}
+			else
+			{
+				// Same as JSON.stringify(), ignore undefined members.
+				const keys = Object.keys(value)
+					.filter((key) => value[key] !== undefined && typeof value[key] !== 'function');
+				const header = Buffer.allocUnsafe(5);
+
+				header[0] = TYPE_OBJECT;
+				header.writeUInt32BE(keys.length, 1);
+				chunks.push(header);
+
+				for (const key of keys)
+				{
+					const keyData = Buffer.from(key, 'utf8');
+					const keyHeader = Buffer.allocUnsafe(2);
+
+					keyHeader.writeUInt16BE(keyData.length, 0);
+					chunks.push(keyHeader, keyData);
+					encodeValue(value[key], chunks);
+				}
+			}
+			break;
+		}
+
+		// Same as JSON.stringify() for array items.
+		default:
+		{
+			chunks.push(Buffer.from([ TYPE_NULL ]));
+		}
+	}
+}
+
+function decodeValue(buffer, state, depth)
+{
+	if (depth > MAX_DEPTH)
+		throw new Error('binary message too deep');
+
+	const type = buffer.readUInt8(state.offset);
+
+	state.offset += 1;
+
+	switch (type)
+	{
+		case TYPE_NULL:
+			return null;
+
+		case TYPE_FALSE:
+			return false;
+
+		case TYPE_TRUE:
+			return true;
+
+		case TYPE_INT32:
+		{
+			const value = buffer.readInt32BE(state.offset);
+
+			state.offset += 4;
+
+			return value;
+		}
+
+		case TYPE_UINT32:
+		{
+			const value = buffer.readUInt32BE(state.offset);
+
+			state.offset += 4;
+
+			return value;
+		}
+
+		case TYPE_DOUBLE:
+		{
+			const value = buffer.readDoubleBE(state.offset);
+
+			state.offset += 8;
+
+			return value;
+		}
+
+		case TYPE_STRING:
+		{
+			const len = buffer.readUInt32BE(state.offset);
+			const start = state.offset + 4;
+
+			if (start + len > buffer.length)
+				throw new Error('binary string out of bounds');
+
+			state.offset = start + len;
+
+			return buffer.toString('utf8', start, start + len);
+		}
+
+		case TYPE_ARRAY:
+		{
+			const count = buffer.readUInt32BE(state.offset);
+			const value = [];
+
+			state.offset += 4;
+
+			for (let i = 0; i < count; i++)
+			{
+				value.push(decodeValue(buffer, state, depth + 1));
+			}
+
+			return value;
+		}
+
+		case TYPE_OBJECT:
+		{
+			const count = buffer.readUInt32BE(state.offset);
+			const value = {};
+
+			state.offset += 4;
+
+			for (let i = 0; i < count; i++)
+			{
+				const keyLen = buffer.readUInt16BE(state.offset);
+				const start = state.offset + 2;
+
+				if (start + keyLen > buffer.length)
+					throw new Error('binary key out of bounds');
+
+				state.offset = start + keyLen;
+				value[buffer.toString('utf8', start, start + keyLen)] =
+					decodeValue(buffer, state, depth + 1);
+			}
+
+			return value;
+		}
+
+		default:
+			throw new Error(`unknown binary type ${type}`);
+	}
+}
@@ -1,5 +1,6 @@
 const Logger = require('./Logger');
 const Server = require('./Server');
+const sharedMetrics = require('./sharedMetrics');
 const errors = require('./errors');
 const PKG = require('../package.json');
 
@@ -30,6 +31,10 @@ const servers = new Set();
  * @param {number} [options.rtcMaxPort=59999] - Maximum RTC port.
  * @param {string} [options.dtlsCertificateFile] - Path to DTLS certificate.
  * @param {string} [options.dtlsPrivateKeyFile] - Path to DTLS private key.
+ * @param {string} [options.metricsDir] - Directory in which every worker
+ * publishes its metrics into a shared memory file (see server.metricsFiles).
+ * @param {number} [options.metricsInterval=1000] - Interval (ms) of the metrics
+ * files updates and of the workers' loop metrics.
  *
  * @return {Server}
  */
@@ -46,6 +51,19 @@ exports.Server = function(options)
 	return server;
 };
 
+/**
+ * Read the latest metrics published by a worker into the given file, without
+ * any request to it.
+ *
+ * @param {string} file - One of server.metricsFiles.
+ *
+ * @return {Object}
+ */
+exports.readMetrics = function(file)
+{
+	return sharedMetrics.read(file);
+};
+
 /**
  * Export mediasoup custom errors.
  */
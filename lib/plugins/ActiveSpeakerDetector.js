@@ -1,14 +1,19 @@
 const Logger = require('../Logger');
 const EnhancedEventEmitter = require('../EnhancedEventEmitter');
 
-const REQUIRED_MIN_AUDIO_LEVEL = -80; // dB.
-const REQUIRED_MAX_NUM_REPORTS = 4;
-
 const logger = new Logger('ActiveSpeakerDetector');
 
 class ActiveSpeakerDetector extends EnhancedEventEmitter
 {
-	constructor(room)
+	/**
+	 * The detection runs in the worker, which just notifies speaker changes.
+	 *
+	 * @param {Room} room
+	 * @param {Object} [options]
+	 * @param {Number} [options.hysteresis] - Audio level (dB) by which a speaker
+	 *   must exceed the current active speaker to replace it.
+	 */
+	constructor(room, { hysteresis } = {})
 	{
 		super(logger);
 
@@ -22,18 +27,14 @@ class ActiveSpeakerDetector extends EnhancedEventEmitter
 		// @type {Room}
 		this._room = room;
 
-		// Latest max audio level reports.
-		// @type {Array}
-		this._reports = [];
-
 		// Current active Producer.
 		// @type {Producer}
 		this._activeProducer = null;
 
-		// Bind the 'audiolevels' listener so we can remove it on closure.
-		this._onRoomAudioLevels = this._onRoomAudioLevels.bind(this);
+		// Bind the '@activespeakerchange' listener so we can remove it on closure.
+		this._onRoomActiveSpeakerChange = this._onRoomActiveSpeakerChange.bind(this);
 
-		this._handleRoom();
+		this._handleRoom({ hysteresis });
 	}
 
 	get closed()
@@ -54,107 +55,33 @@ class ActiveSpeakerDetector extends EnhancedEventEmitter
 		this._closed = true;
 
 		if (!this._room.closed)
-			this._room.removeListener('audiolevels', this._onRoomAudioLevels);
+		{
+			this._room.removeListener(
+				'@activespeakerchange', this._onRoomActiveSpeakerChange);
+			this._room._removeActiveSpeakerDetector(this);
+		}
 
 		this.safeEmit('close');
 	}
 
-	_handleRoom()
+	_handleRoom(options)
 	{
 		const room = this._room;
 
 		room.on('close', () => this.close());
-		room.on('audiolevels', this._onRoomAudioLevels);
+		room.on('@activespeakerchange', this._onRoomActiveSpeakerChange);
+		room._addActiveSpeakerDetector(this, options);
 	}
 
-	_onRoomAudioLevels(levels)
+	_onRoomActiveSpeakerChange(producer)
 	{
 		if (this._closed)
 			return;
 
-		let previousActiveProducer = this._activeProducer;
-		let requiredNumReports;
-
-		if (
-			previousActiveProducer &&
-			!previousActiveProducer.closed &&
-			!previousActiveProducer.paused
-		)
-		{
-			requiredNumReports = REQUIRED_MAX_NUM_REPORTS;
-		}
+		if (!producer || producer.closed || producer.paused)
+			this._mayUpdateActiveSpeaker(null);
 		else
-		{
-			previousActiveProducer = null;
-			requiredNumReports = 1;
-			this._reports = [];
-		}
-
-		const reports = this._reports;
-
-		// Insert the loudest audio level report into the reports array.
-		// NOTE: This may be undefined, meaning that nobody is producing audio.
-		reports.push(levels[0]);
-
-		// No more than REQUIRED_MAX_NUM_REPORTS.
-		if (reports.length > REQUIRED_MAX_NUM_REPORTS)
-		{
-			reports.shift();
-		}
-		// No less than requiredNumReports.
-		else if (reports.length < requiredNumReports)
-		{
-			this._mayUpdateActiveSpeaker(previousActiveProducer);
-
-			return;
-		}
-
-		// If the same Producer was the loudest speaker in the last N reports, make
-		// it the active speaker.
-
-		let currentActiveProducer;
-		const numReports = reports.length;
-
-		for (let i = numReports - 1; i >= numReports - requiredNumReports; --i)
-		{
-			const report = reports[i];
-
-			if (!report)
-			{
-				currentActiveProducer = null;
-
-				break;
-			}
-
-			const { producer, audioLevel } = report;
-
-			if (producer.closed || producer.paused || audioLevel < REQUIRED_MIN_AUDIO_LEVEL)
-			{
-				currentActiveProducer = null;
-
-				break;
-			}
-
-			if (currentActiveProducer && producer !== currentActiveProducer)
-			{
-				currentActiveProducer = null;
-
-				break;
-			}
-
-			currentActiveProducer = producer;
-		}
-
-		// If there is an effective new audio Producer, make it the active one.
-		if (currentActiveProducer)
-		{
-			this._mayUpdateActiveSpeaker(currentActiveProducer);
-		}
-		// Otherwise check the previous active speaker.
-		else
-		{
-			this._mayUpdateActiveSpeaker(previousActiveProducer);
-		}
+			this._mayUpdateActiveSpeaker(producer);
 	}
 
 	_mayUpdateActiveSpeaker(activeProducer)
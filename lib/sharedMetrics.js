@@ -0,0 +1,96 @@
+/**
+ * Reader of the shared metrics region published by each mediasoup-worker when
+ * the `metricsDir` Server option is given. See SharedMetrics.hpp in the worker
+ * for the layout.
+ *
+ * The region is a memory mapped file, so reading it does not involve the
+ * worker at all.
+ */
+
+const fs = require('fs');
+const os = require('os');
+const statsSnapshot = require('./statsSnapshot');
+
+const MAGIC = 0x4D534D52;
+const VERSION = 1;
+const HEADER_SIZE = 64;
+const FLAG_TRUNCATED = 0x01;
+const MAX_RETRIES = 100;
+
+// The region header is in host byte order.
+const LE = os.endianness() === 'LE';
+
+/**
+ * Read the latest metrics published in the given file.
+ *
+ * @param {String} file
+ *
+ * @return {Object} The parsed stats snapshot plus the sequence, the loop lag
+ *   (in microseconds) of the worker and whether records were left out.
+ * @throws {Error} if the file is not a metrics region or it could not be read
+ *   consistently.
+ */
+exports.read = function(file)
+{
+	const fd = fs.openSync(file, 'r');
+
+	try
+	{
+		const header = Buffer.alloc(HEADER_SIZE);
+
+		for (let retry = 0; retry < MAX_RETRIES; retry++)
+		{
+			fs.readSync(fd, header, 0, HEADER_SIZE, 0);
+
+			if (readUInt32(header, 0) !== MAGIC)
+				throw new Error('not a metrics file');
+
+			if (readUInt32(header, 4) !== VERSION)
+				throw new Error(`unsupported metrics version ${readUInt32(header, 4)}`);
+
+			const sequence = readUInt32(header, 8);
+			const capacity = readUInt32(header, 12);
+			const size = readUInt32(header, 16);
+
+			// Being written.
+			if ((sequence & 1) !== 0 || size > capacity)
+				continue;
+
+			const data = Buffer.alloc(size);
+
+			fs.readSync(fd, data, 0, size, HEADER_SIZE);
+			fs.readSync(fd, header, 0, HEADER_SIZE, 0);
+
+			// Updated meanwhile.
+			if (readUInt32(header, 8) !== sequence)
+				continue;
+
+			const snapshot = statsSnapshot.parse(data);
+
+			snapshot.sequence = sequence;
+			snapshot.loopLag = readUInt64(header, 24);
+			snapshot.truncated = Boolean(readUInt32(header, 20) & FLAG_TRUNCATED);
+
+			return snapshot;
+		}
+
+		throw new Error('metrics being updated, could not read them');
+	}
+	finally
+	{
+		fs.closeSync(fd);
+	}
+};
+
+function readUInt32(buffer, offset)
+{
+	return LE ? buffer.readUInt32LE(offset) : buffer.readUInt32BE(offset);
+}
+
+function readUInt64(buffer, offset)
+{
+	if (LE)
+		return (buffer.readUInt32LE(offset + 4) * 0x100000000) + buffer.readUInt32LE(offset);
+	else
+		return (buffer.readUInt32BE(offset) * 0x100000000) + buffer.readUInt32BE(offset + 4);
+}
@@ -0,0 +1,110 @@
+/**
+ * Parser of the router stats snapshot produced by RTC::StatsSnapshot in the
+ * worker. See its header file for the binary layout.
+ */
+
+const VERSION = 1;
+const HEADER_SIZE = 16;
+
+const RECORD_TYPES =
+{
+	1 : 'transport',
+	2 : 'producer',
+	3 : 'consumer'
+};
+
+/**
+ * Parse the given snapshot.
+ *
+ * @param {Buffer} buffer
+ *
+ * @return {Object} With timestamp, delta flag and the records of transports,
+ *   producers (one per stream) and consumers.
+ * @throws {Error} if the buffer is not a valid snapshot.
+ */
+exports.parse = function(buffer)
+{
+	if (buffer.length < HEADER_SIZE)
+		throw new Error('stats snapshot too short');
+
+	if (buffer.readUInt8(0) !== VERSION)
+		throw new Error(`unsupported stats snapshot version ${buffer.readUInt8(0)}`);
+
+	const delta = Boolean(buffer.readUInt8(1) & 0x01);
+	const recordSize = buffer.readUInt16BE(2);
+	const recordCount = buffer.readUInt32BE(4);
+	const timestamp = readUInt64(buffer, 8);
+
+	if (buffer.length < HEADER_SIZE + (recordSize * recordCount))
+		throw new Error('stats snapshot too short');
+
+	const snapshot =
+	{
+		timestamp,
+		delta,
+		transports : [],
+		producers  : [],
+		consumers  : []
+	};
+
+	for (let i = 0; i < recordCount; i++)
+	{
+		const offset = HEADER_SIZE + (recordSize * i);
+		const type = RECORD_TYPES[buffer.readUInt8(offset)];
+
+		switch (type)
+		{
+			case 'transport':
+			{
+				snapshot.transports.push(
+					{
+						id            : buffer.readUInt32BE(offset + 4),
+						bytesReceived : readUInt64(buffer, offset + 16),
+						bytesSent     : readUInt64(buffer, offset + 24)
+					});
+				break;
+			}
+
+			case 'producer':
+			case 'consumer':
+			{
+				const record =
+				{
+					id           : buffer.readUInt32BE(offset + 4),
+					ssrc         : buffer.readUInt32BE(offset + 8),
+					bitrate      : buffer.readUInt32BE(offset + 12),
+					fractionLost : buffer.readUInt8(offset + 1),
+					packetCount  : readUInt64(buffer, offset + 16),
+					byteCount    : readUInt64(buffer, offset + 24),
+					packetsLost  : buffer.readUInt32BE(offset + 32),
+					nackCount    : buffer.readUInt32BE(offset + 36),
+					pliCount     : buffer.readUInt32BE(offset + 40),
+					firCount     : buffer.readUInt32BE(offset + 44)
+				};
+
+				if (type === 'consumer')
+				{
+					record.rtt = buffer.readUInt16BE(offset + 2);
+					snapshot.consumers.push(record);
+				}
+				else
+				{
+					snapshot.producers.push(record);
+				}
+				break;
+			}
+
+			// Ignore unknown records.
+			default:
+				break;
+		}
+	}
+
+	return snapshot;
+};
+
+// Counters fit in a Number way before reaching 2^53.
+function readUInt64(buffer, offset)
+{
+	return (buffer.readUInt32BE(offset) * 0x100000000) + buffer.readUInt32BE(offset + 4);
+}
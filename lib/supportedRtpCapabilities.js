@@ -224,6 +224,19 @@ const supportedRtpCapabilities =
 				{ type: 'goog-remb' }
 			]
 		},
+		{
+			kind         : 'video',
+			name         : 'AV1',
+			mimeType     : 'video/AV1',
+			clockRate    : 90000,
+			rtcpFeedback :
+			[
+				{ type: 'nack' },
+				{ type: 'nack', parameter: 'pli' },
+				{ type: 'ccm', parameter: 'fir' },
+				{ type: 'goog-remb' }
+			]
+		},
 		{
 			kind         : 'video',
 			name         : 'H265',
@@ -292,6 +305,18 @@ const supportedRtpCapabilities =
 			uri              : 'urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id',
 			preferredId      : 6,
 			preferredEncrypt : false
+		},
+		{
+			kind             : 'video',
+			uri              : 'http://tools.ietf.org/html/draft-ietf-avtext-framemarking-07', // eslint-disable-line max-len
+			preferredId      : 7,
+			preferredEncrypt : false
+		},
+		{
+			kind             : 'video',
+			uri              : 'https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension', // eslint-disable-line max-len
+			preferredId      : 8,
+			preferredEncrypt : false
 		}
 	],
 	fecMechanisms : []
@@ -97,6 +97,39 @@ tap.test('server.Room() with workerIdx uses the specified worker', (t) =>
 	t.end();
 });
 
+tap.test('server.Room() allocates the least loaded worker', (t) =>
+{
+	const server = mediasoup.Server({ numWorkers: 3 });
+
+	t.tearDown(() => server.close());
+
+	// NOTE: Testing private properties here.
+
+	const workers = Array.from(server._workers);
+
+	workers[0]._loopMetrics = { utilization: 0.5 };
+	workers[1]._loopMetrics = { utilization: 0.1 };
+	workers[2]._loopMetrics = { utilization: 0.12 };
+
+	server.Room(mediaCodecs);
+	t.equal(server._latestWorkerIdx, 1, 'selected worker is the least loaded one');
+
+	server.Room(mediaCodecs);
+	t.equal(
+		server._latestWorkerIdx, 2, 'similar utilization selects the one with less rooms');
+
+	server.Room(mediaCodecs);
+	t.equal(server._latestWorkerIdx, 1, 'too loaded worker is not selected');
+
+	workers[0]._loopMetrics = null;
+
+	server.Room(mediaCodecs);
+	t.equal(
+		server._latestWorkerIdx, 2, 'missing loop metrics selects the next worker');
+
+	t.end();
+});
+
 tap.test(
 	'server.Room() with valid media codecs must succeed', { timeout: 2000 }, (t) =>
 	{
@@ -0,0 +1,54 @@
+#ifndef MS_CHANNEL_BINARY_CODEC_HPP
+#define MS_CHANNEL_BINARY_CODEC_HPP
+
+#include "common.hpp"
+#include <json/json.h>
+
+/* Binary encoding of Channel messages (same as lib/binaryCodec.js).
+ *
+ * Every value starts with a 1 byte type followed by its content. Numbers and
+ * lengths are big-endian:
+ *
+ *   0x00 null
+ *   0x01 false
+ *   0x02 true
+ *   0x03 int32          4 bytes
+ *   0x04 uint32         4 bytes
+ *   0x05 double         8 bytes (IEEE 754)
+ *   0x06 string         uint32 length + UTF-8 bytes
+ *   0x07 array          uint32 count + values
+ *   0x08 object         uint32 count + (uint16 key length + key + value) pairs
+ */
+
+namespace Channel
+{
+	class BinaryCodec
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			NULL_VALUE = 0x00,
+			FALSE      = 0x01,
+			TRUE       = 0x02,
+			INT32      = 0x03,
+			UINT32     = 0x04,
+			DOUBLE     = 0x05,
+			STRING     = 0x06,
+			ARRAY      = 0x07,
+			OBJECT     = 0x08
+		};
+
+	public:
+		// Returns the number of bytes written into the buffer, or 0 if it does not fit.
+		static size_t Encode(const Json::Value& value, uint8_t* buffer, size_t bufferLen);
+		static bool Decode(const uint8_t* data, size_t len, Json::Value& value);
+
+	private:
+		static bool EncodeValue(
+		  const Json::Value& value, uint8_t* buffer, size_t bufferLen, size_t& pos);
+		static bool DecodeValue(
+		  const uint8_t* data, size_t len, size_t& pos, Json::Value& value, uint8_t depth);
+	};
+} // namespace Channel
+
+#endif
@@ -3,18 +3,46 @@
 
 #include "common.hpp"
 #include "Channel/UnixStreamSocket.hpp"
+#include "handles/Timer.hpp"
 #include <json/json.h>
+#include <map>
 #include <string>
+#include <utility> // std::pair
+#include <vector>
 
 namespace Channel
 {
-	class Notifier
+	class Notifier : public Timer::Listener
 	{
+	public:
+		// Window in which coalesced events of the same target and name are merged.
+		static constexpr uint64_t CoalesceWindow{ 100 };
+		// Max number of coalesced events sent per window. The rest wait for the
+		// next one.
+		static constexpr size_t MaxEventsPerWindow{ 500 };
+		// Max number of events sent in a single message.
+		static constexpr size_t MaxEventsPerMessage{ 32 };
+
+	private:
+		struct PendingEvent
+		{
+			uint64_t sequence{ 0 };
+			Json::Value data;
+			bool hasData{ false };
+		};
+
+	private:
+		using PendingEvents = std::map<std::pair<uint32_t, std::string>, PendingEvent>;
+
 	public:
 		explicit Notifier(Channel::UnixStreamSocket* channel);
+		~Notifier() override;
 
+	public:
 		void Emit(uint32_t targetId, const std::string& event);
 		void Emit(uint32_t targetId, const std::string& event, Json::Value& data);
+		void EmitCoalesced(uint32_t targetId, const std::string& event);
+		void EmitCoalesced(uint32_t targetId, const std::string& event, Json::Value& data);
 		void EmitWithBinary(
 		  uint32_t targetId, const std::string& event, const uint8_t* binaryData, size_t binaryLen);
 		void EmitWithBinary(
@@ -23,11 +51,37 @@ namespace Channel
 		  const uint8_t* binaryData,
 		  size_t binaryLen,
 		  Json::Value& data);
+		void Flush(size_t maxEvents = 0);
+		size_t GetPendingCount() const;
+
+	private:
+		void AddPending(uint32_t targetId, const std::string& event, Json::Value* data);
+		void FlushTarget(uint32_t targetId);
+		void SendPending(std::vector<PendingEvents::iterator>& its, size_t maxEvents);
+		void SendEvents(Json::Value& jsonEvents, Json::ArrayIndex begin, Json::ArrayIndex end);
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
 
 	public:
 		// Passed by argument.
 		Channel::UnixStreamSocket* channel{ nullptr };
+
+	private:
+		// Allocated by this.
+		Timer* timer{ nullptr };
+		// Others.
+		PendingEvents pendingEvents;
+		uint64_t sequence{ 0 };
 	};
+
+	/* Inline instance methods. */
+
+	inline size_t Notifier::GetPendingCount() const
+	{
+		return this->pendingEvents.size();
+	}
 } // namespace Channel
 
 #endif
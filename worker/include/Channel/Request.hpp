@@ -20,13 +20,18 @@ namespace Channel
 			WORKER_DUMP = 1,
 			WORKER_UPDATE_SETTINGS,
 			WORKER_CREATE_ROUTER,
+			WORKER_BATCH,
 			ROUTER_CLOSE,
 			ROUTER_DUMP,
+			ROUTER_GET_STATS,
 			ROUTER_CREATE_WEBRTC_TRANSPORT,
 			ROUTER_CREATE_PLAIN_RTP_TRANSPORT,
 			ROUTER_CREATE_PRODUCER,
 			ROUTER_CREATE_CONSUMER,
+			ROUTER_CREATE_CONSUMERS,
 			ROUTER_SET_AUDIO_LEVELS_EVENT,
+			ROUTER_SET_ACTIVE_SPEAKER_EVENT,
+			ROUTER_SET_AUDIO_TOP_K,
 			TRANSPORT_CLOSE,
 			TRANSPORT_DUMP,
 			TRANSPORT_GET_STATS,
@@ -36,6 +41,7 @@ namespace Channel
 			TRANSPORT_CHANGE_UFRAG_PWD,
 			TRANSPORT_START_MIRRORING,
 			TRANSPORT_STOP_MIRRORING,
+			TRANSPORT_SET_LAST_N,
 			PRODUCER_CLOSE,
 			PRODUCER_DUMP,
 			PRODUCER_GET_STATS,
@@ -50,20 +56,34 @@ namespace Channel
 			CONSUMER_RESUME,
 			CONSUMER_SET_PREFERRED_PROFILE,
 			CONSUMER_SET_ENCODING_PREFERENCES,
-			CONSUMER_REQUEST_KEY_FRAME
+			CONSUMER_REQUEST_KEY_FRAME,
+			CONSUMER_SUPPRESS_COMFORT_NOISE
 		};
 
+	public:
+		// Keeps the rejections of the requests a full batch does not run small.
+		static constexpr size_t BatchMaxRequests{ 100 };
+
 	private:
 		static std::unordered_map<std::string, MethodId> string2MethodId;
 
 	public:
 		Request(Channel::UnixStreamSocket* channel, Json::Value& json);
+		// Request within a batch. Its reply is kept in reply rather than sent.
+		Request(Channel::Request* batch, Json::Value& json);
 		virtual ~Request();
 
 		void Accept();
 		void Accept(Json::Value& data);
+		void Accept(Json::Value& data, const uint8_t* binaryData, size_t binaryLen);
 		void Reject(std::string& reason);
 		void Reject(const char* reason = nullptr);
+		void AddBatchResponse(Json::Value& jsonResponse, size_t pending);
+
+	private:
+		void Parse(Json::Value& json);
+		void Reply(Json::Value& json);
+		bool Send(Json::Value& json);
 
 	public:
 		// Passed by argument.
@@ -75,6 +95,12 @@ namespace Channel
 		Json::Value data;
 		// Others.
 		bool replied{ false };
+		bool batched{ false };
+		Json::Value reply;
+		// Responses of the requests within this batch.
+		Json::Value batchResponses{ Json::arrayValue };
+		size_t batchResponsesSize{ 0 };
+		bool batchFull{ false };
 	};
 } // namespace Channel
 
@@ -10,6 +10,21 @@ namespace Channel
 {
 	class UnixStreamSocket : public ::UnixStreamSocket
 	{
+	public:
+		static constexpr size_t MessageMaxSize{ 65536 };
+		// Binary payloads bigger than a regular message are written without
+		// copying them into the write buffer.
+		static constexpr size_t BinaryMaxSize{ 4 * 1024 * 1024 };
+
+	public:
+		// Message encoding. JSON messages are netstrings. Binary messages (see
+		// Channel::BinaryCodec) are prefixed with their 4 bytes length.
+		enum class Format
+		{
+			JSON = 1,
+			BINARY
+		};
+
 	public:
 		class Listener
 		{
@@ -19,17 +34,24 @@ namespace Channel
 		};
 
 	public:
-		explicit UnixStreamSocket(int fd);
+		explicit UnixStreamSocket(int fd, Format format = Format::JSON);
 
 	private:
 		~UnixStreamSocket() override;
 
 	public:
 		void SetListener(Listener* listener);
-		void Send(Json::Value& msg);
+		bool Send(Json::Value& msg);
+		size_t GetEncodedSize(Json::Value& msg);
 		void SendLog(char* nsPayload, size_t nsPayloadLen);
 		void SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen);
 
+	private:
+		void WriteFrame(const uint8_t* payload, size_t payloadLen);
+		void WriteLarge(const uint8_t* payload, size_t payloadLen);
+		void ReadFrames();
+		void HandleMessage(Json::Value& json);
+
 		/* Pure virtual methods inherited from ::UnixStreamSocket. */
 	public:
 		void UserOnUnixStreamRead() override;
@@ -38,6 +60,7 @@ namespace Channel
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
+		Format format{ Format::JSON };
 		// Others.
 		Json::CharReader* jsonReader{ nullptr };
 		Json::StreamWriter* jsonWriter{ nullptr };
@@ -30,6 +30,13 @@
  *   Example:
  *     MS_WARN_TAG(ice, "ICE failed");
  *
+ *   Tagged logs are not formatted and sent right away. Their arguments are
+ *   copied into the log ring and formatted and sent once the current loop
+ *   iteration has processed its I/O. Every call site logs at most
+ *   Logger::MaxRecordsPerSecond times per second, and records exceeding that
+ *   or not fitting into the ring are dropped (and counted). Records still in
+ *   the ring are lost if the process aborts.
+ *
  * MS_DEBUG_2TAGS(tag1, tag2, ...)
  * MS_WARN_2TAGS(tag1, tag2, ...)
  *
@@ -52,7 +59,7 @@
  * MS_ERROR(...)
  *
  *   Logs an error. Must just be used for internal errors that should not
- *   happen.
+ *   happen. Tagged logs pending in the ring are sent before it.
  *
  * MS_ABORT(...)
  *
@@ -74,6 +81,8 @@
 #include <cstdlib> // std::abort()
 #include <cstring>
 #include <string>
+#include <tuple>
+#include <type_traits>
 
 // clang-format off
 
@@ -108,17 +117,202 @@
 
 class Logger
 {
+public:
+	static constexpr size_t RingSize{ 1024 * 1024 };
+	static constexpr uint32_t MaxRecordsPerSecond{ 100 };
+
+public:
+	// State of every call site logging through the ring.
+	struct CallSite
+	{
+		uint64_t windowStart{ 0 };
+		uint32_t count{ 0 };
+	};
+
+private:
+	using Formatter = int (*)(const uint8_t* args, const char* format);
+
+	// How arguments are copied into the ring and read back. Strings are copied
+	// since they may not outlive the call (so "%s" must get a char pointer). A
+	// null string is copied as "(null)".
+	template<typename T>
+	struct Arg
+	{
+		static_assert(
+		  std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+		  "unsupported log argument type");
+
+		// Type read back.
+		using Type = T;
+
+		static size_t Size(T /*value*/)
+		{
+			return sizeof(T);
+		}
+		static void Write(uint8_t*& data, T value)
+		{
+			std::memcpy(data, &value, sizeof(T));
+			data += sizeof(T);
+		}
+		static T Read(const uint8_t*& data)
+		{
+			T value;
+
+			std::memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+
+			return value;
+		}
+	};
+
+	template<int...>
+	struct Indexes
+	{
+	};
+
+	template<int N, int... Is>
+	struct MakeIndexes : MakeIndexes<N - 1, N - 1, Is...>
+	{
+	};
+
+	template<int... Is>
+	struct MakeIndexes<0, Is...>
+	{
+		using Type = Indexes<Is...>;
+	};
+
 public:
 	static void Init(const std::string &id, Channel::UnixStreamSocket* channel);
 	static void Init(const std::string &id);
+	static void ClassDestroy();
+	static bool Admit(CallSite& callSite);
+	template<typename... Args>
+	static void Enqueue(CallSite& callSite, const char* format, Args... args);
+	static void Flush();
+	static void CheckFormat(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+private:
+	template<typename... Args>
+	static int Format(const uint8_t* data, const char* format);
+	template<typename... Args, int... Is>
+	static int Format(std::tuple<Args...>& args, const char* format, Indexes<Is...> /*indexes*/);
 
 public:
 	static std::string id;
 	static Channel::UnixStreamSocket* channel;
 	static const size_t bufferSize {10000};
 	static char buffer[];
+	static uint64_t droppedRecords;
+
+private:
+	static uint8_t ring[];
+	static size_t ringLen;
+	static uint64_t reportedDroppedRecords;
+	static bool flushing;
+};
+
+template<>
+struct Logger::Arg<const char*>
+{
+	using Type = const char*;
+
+	static size_t Size(const char* value)
+	{
+		if (value == nullptr)
+			value = "(null)";
+
+		return sizeof(size_t) + std::strlen(value) + 1;
+	}
+	static void Write(uint8_t*& data, const char* value)
+	{
+		if (value == nullptr)
+			value = "(null)";
+
+		size_t len = std::strlen(value) + 1;
+
+		std::memcpy(data, &len, sizeof(size_t));
+		std::memcpy(data + sizeof(size_t), value, len);
+		data += sizeof(size_t) + len;
+	}
+	static const char* Read(const uint8_t*& data)
+	{
+		size_t len;
+
+		std::memcpy(&len, data, sizeof(size_t));
+
+		auto* value = reinterpret_cast<const char*>(data + sizeof(size_t));
+
+		data += sizeof(size_t) + len;
+
+		return value;
+	}
 };
 
+template<>
+struct Logger::Arg<char*> : public Logger::Arg<const char*>
+{
+};
+
+/* Inline static methods. */
+
+template<typename... Args>
+inline void Logger::Enqueue(CallSite& callSite, const char* format, Args... args)
+{
+	if (Logger::channel == nullptr || !Logger::Admit(callSite))
+		return;
+
+	size_t sizes[] = { 0, Arg<Args>::Size(args)... };
+	size_t size = sizeof(size_t) + sizeof(Formatter) + sizeof(const char*);
+
+	for (auto argSize : sizes)
+	{
+		size += argSize;
+	}
+
+	if (Logger::ringLen + size > Logger::RingSize)
+	{
+		Logger::droppedRecords++;
+
+		return;
+	}
+
+	uint8_t* data = Logger::ring + Logger::ringLen;
+	Formatter formatter = &Logger::Format<typename Arg<Args>::Type...>;
+
+	std::memcpy(data, &size, sizeof(size_t));
+	std::memcpy(data + sizeof(size_t), &formatter, sizeof(Formatter));
+	std::memcpy(data + sizeof(size_t) + sizeof(Formatter), &format, sizeof(const char*));
+	data += sizeof(size_t) + sizeof(Formatter) + sizeof(const char*);
+
+	int written[] = { 0, (Arg<Args>::Write(data, args), 0)... };
+
+	(void)written;
+
+	Logger::ringLen += size;
+}
+
+template<typename... Args>
+inline int Logger::Format(const uint8_t* data, const char* format)
+{
+	// Arguments in a braced list are read in order.
+	std::tuple<Args...> args{ Arg<Args>::Read(data)... };
+
+	// Not read if there are no arguments.
+	(void)data;
+
+	return Logger::Format(args, format, typename MakeIndexes<sizeof...(Args)>::Type());
+}
+
+template<typename... Args, int... Is>
+inline int Logger::Format(std::tuple<Args...>& args, const char* format, Indexes<Is...> /*indexes*/)
+{
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+	return std::snprintf(Logger::buffer, Logger::bufferSize, format, std::get<Is>(args)...);
+#pragma GCC diagnostic pop
+}
+
 /* Logging macros. */
 
 #define _MS_LOG_SEPARATOR_CHAR_STD "\n"
@@ -172,8 +366,9 @@ public:
 	{ \
 		if (LogLevel::LOG_DEBUG == Settings::configuration.logLevel && (_MS_TAG_ENABLED(tag) || _MS_LOG_DEV_ENABLED)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, loggerWritten); \
+			static Logger::CallSite loggerCallSite; \
+			(void)sizeof(Logger::CheckFormat(_MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__), 0); \
+			Logger::Enqueue(loggerCallSite, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -194,8 +389,9 @@ public:
 	{ \
 		if (LogLevel::LOG_WARN <= Settings::configuration.logLevel && (_MS_TAG_ENABLED(tag) || _MS_LOG_DEV_ENABLED)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, loggerWritten); \
+			static Logger::CallSite loggerCallSite; \
+			(void)sizeof(Logger::CheckFormat(_MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__), 0); \
+			Logger::Enqueue(loggerCallSite, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -216,8 +412,9 @@ public:
 	{ \
 		if (LogLevel::LOG_DEBUG == Settings::configuration.logLevel && (_MS_TAG_ENABLED_2(tag1, tag2) || _MS_LOG_DEV_ENABLED)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, loggerWritten); \
+			static Logger::CallSite loggerCallSite; \
+			(void)sizeof(Logger::CheckFormat(_MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__), 0); \
+			Logger::Enqueue(loggerCallSite, "D" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -238,8 +435,9 @@ public:
 	{ \
 		if (LogLevel::LOG_WARN <= Settings::configuration.logLevel && (_MS_TAG_ENABLED_2(tag1, tag2) || _MS_LOG_DEV_ENABLED)) \
 		{ \
-			int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
-			Logger::channel->SendLog(Logger::buffer, loggerWritten); \
+			static Logger::CallSite loggerCallSite; \
+			(void)sizeof(Logger::CheckFormat(_MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__), 0); \
+			Logger::Enqueue(loggerCallSite, "W" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		} \
 	} \
 	while (false)
@@ -325,6 +523,7 @@ public:
 #define MS_ERROR(desc, ...) \
 	do \
 	{ \
+		Logger::Flush(); \
 		int loggerWritten = std::snprintf(Logger::buffer, Logger::bufferSize, "E" _MS_LOG_STR_DESC desc, _MS_LOG_ARG, ##__VA_ARGS__); \
 		Logger::channel->SendLog(Logger::buffer, loggerWritten); \
 	} \
@@ -0,0 +1,87 @@
+#ifndef MS_LOOP_METRICS_HPP
+#define MS_LOOP_METRICS_HPP
+
+#include "common.hpp"
+#include "RTC/LatencyHistogram.hpp"
+#include <json/json.h>
+#include <uv.h>
+
+// Event loop utilization. Every loop iteration is split into idle time (blocked
+// in the poll phase waiting for I/O) and busy time, which is also accounted by
+// handler category. The lag histogram counts the busy time (in microseconds) of
+// every iteration, that is, how long new I/O had to wait to be processed.
+class LoopMetrics
+{
+public:
+	enum class Category : uint8_t
+	{
+		UDP = 0,
+		TCP,
+		CHANNEL,
+		TIMER
+	};
+
+	static constexpr size_t NumCategories{ 4 };
+
+public:
+	// Accounts the time spent in its scope to the given category.
+	class Scope
+	{
+	public:
+		explicit Scope(Category category);
+		~Scope();
+
+	private:
+		size_t idx{ 0 };
+		uint64_t startTime{ 0 };
+	};
+
+private:
+	struct Counters
+	{
+		uint64_t iterations{ 0 };
+		uint64_t busyTime{ 0 };
+		uint64_t idleTime{ 0 };
+		uint64_t handlerTime[NumCategories]{ 0 };
+		RTC::LatencyHistogram lag;
+	};
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static Json::Value ToJson();
+	static Json::Value TakeWindow();
+
+private:
+	static Json::Value ToJson(const Counters& counters);
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnUvPrepare();
+	static void OnUvCheck();
+
+private:
+	static uv_prepare_t* prepareHandle;
+	static uv_check_t* checkHandle;
+	static uint64_t iterationStartTime;
+	static uint64_t iterationIdleTime;
+	// Time spent in handlers in the current iteration, in nanoseconds.
+	static uint64_t handlerTime[];
+	// Since the start and since the latest window taken.
+	static Counters total;
+	static Counters window;
+};
+
+/* Inline methods. */
+
+inline LoopMetrics::Scope::Scope(Category category)
+  : idx(static_cast<size_t>(category)), startTime(uv_hrtime())
+{
+}
+
+inline LoopMetrics::Scope::~Scope()
+{
+	LoopMetrics::handlerTime[this->idx] += uv_hrtime() - this->startTime;
+}
+
+#endif
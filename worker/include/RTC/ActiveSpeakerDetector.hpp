@@ -0,0 +1,91 @@
+#ifndef MS_RTC_ACTIVE_SPEAKER_DETECTOR_HPP
+#define MS_RTC_ACTIVE_SPEAKER_DETECTOR_HPP
+
+#include "common.hpp"
+#include <unordered_map>
+
+namespace RTC
+{
+	// Dominant speaker detection over the ssrc-audio-level values of the audio
+	// Producers. Each Producer keeps a fixed-size ring with its average energy
+	// during the latest intervals, and a new dominant speaker is announced
+	// only when it beats the current one by the configured hysteresis.
+	class ActiveSpeakerDetector
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual void OnActiveSpeakerChanged(
+			  RTC::ActiveSpeakerDetector* activeSpeakerDetector, uint32_t producerId) = 0;
+			virtual void OnActiveSpeakerLost(RTC::ActiveSpeakerDetector* activeSpeakerDetector) = 0;
+		};
+
+	public:
+		// Number of intervals in the energy window.
+		static constexpr size_t RingSize{ 10 };
+		// Min window energy (127 - dBov) to be a speaker (-60 dBov). Background
+		// noise usually stays below it.
+		static constexpr uint8_t MinEnergy{ 67 };
+		static constexpr uint8_t DefaultHysteresis{ 6 }; // In dB.
+
+	private:
+		struct Speaker
+		{
+			// Energy of the latest intervals.
+			uint8_t energies[RingSize]{ 0 };
+			size_t energiesIdx{ 0 };
+			uint32_t energiesSum{ 0 };
+			// Levels received in the current interval.
+			uint32_t intervalEnergySum{ 0 };
+			uint32_t intervalCount{ 0 };
+		};
+
+	public:
+		explicit ActiveSpeakerDetector(Listener* listener);
+
+	public:
+		void SetHysteresis(uint8_t hysteresis);
+		void ReceiveAudioLevel(uint32_t producerId, uint8_t volume);
+		void RemoveProducer(uint32_t producerId);
+		void Process();
+		bool HasActiveSpeaker() const;
+		uint32_t GetActiveSpeaker() const;
+
+	private:
+		uint8_t GetEnergy(const Speaker& speaker) const;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		std::unordered_map<uint32_t, Speaker> speakers;
+		uint8_t hysteresis{ DefaultHysteresis };
+		bool hasActiveSpeaker{ false };
+		uint32_t activeSpeaker{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline void ActiveSpeakerDetector::SetHysteresis(uint8_t hysteresis)
+	{
+		this->hysteresis = hysteresis;
+	}
+
+	inline bool ActiveSpeakerDetector::HasActiveSpeaker() const
+	{
+		return this->hasActiveSpeaker;
+	}
+
+	inline uint32_t ActiveSpeakerDetector::GetActiveSpeaker() const
+	{
+		return this->activeSpeaker;
+	}
+
+	inline uint8_t ActiveSpeakerDetector::GetEnergy(const Speaker& speaker) const
+	{
+		return static_cast<uint8_t>(speaker.energiesSum / RingSize);
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef MS_RTC_AUDIO_TOP_K_HPP
+#define MS_RTC_AUDIO_TOP_K_HPP
+
+#include "common.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+	// Selection of the K loudest audio Producers by the smoothed energy
+	// (127 - dBov) of their packets. A Producer only replaces a forwarded one if
+	// it is clearly louder, or if the forwarded one stopped sending packets.
+	class AudioTopK
+	{
+	public:
+		// Weight of the latest packet in the smoothed energy is 1/Smoothing.
+		static constexpr uint16_t Smoothing{ 8 };
+		static constexpr uint16_t Hysteresis{ 6 }; // In dB.
+		// Forwarded Producers without packets for this long lose their slot.
+		static constexpr uint64_t InactivityTimeout{ 1000 }; // In ms.
+
+	public:
+		AudioTopK() = default;
+
+	public:
+		// Sets K (0 means forwarding all the Producers) and starts the selection again.
+		void SetK(uint32_t k);
+		uint32_t GetK() const;
+		// Returns whether the Producer is forwarded, and sets added if it just
+		// got a slot.
+		bool Update(uint32_t producerId, uint8_t energy, uint64_t now, bool& added);
+		bool IsForwarded(uint32_t producerId) const;
+		void Remove(uint32_t producerId);
+
+	private:
+		struct Activity
+		{
+			uint16_t energy{ 0 };
+			uint64_t lastPacketTime{ 0 };
+			bool forwarded{ false };
+		};
+
+	private:
+		uint32_t k{ 0 };
+		std::unordered_map<uint32_t, Activity> activities;
+		std::vector<uint32_t> forwardedProducers;
+	};
+
+	/* Inline instance methods. */
+
+	inline uint32_t AudioTopK::GetK() const
+	{
+		return this->k;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef MS_RTC_CODECS_AV1_HPP
+#define MS_RTC_CODECS_AV1_HPP
+
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <limits> // std::numeric_limits
+#include <vector>
+
+/* RTP Payload Format For AV1 (v1.0.0)
+ * Dependency Descriptor RTP Header Extension
+ *
+
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |S|E|  TEMPLATE |          FRAME NUMBER         |T|A|D|F|C|     |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    | template dependency structure (if T), active decode targets   |
+    | (if A), custom dtis (if D), custom fdiffs (if F) ...          |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+ * AV1 Aggregation Header (first payload byte)
+ *
+      0 1 2 3 4 5 6 7
+     +-+-+-+-+-+-+-+-+
+     |Z|Y| W |N|-|-|-|
+     +-+-+-+-+-+-+-+-+
+*/
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class AV1
+		{
+		public:
+			// Layers and number of referenced frames of a frame dependency template.
+			struct FrameDependencyTemplate
+			{
+				uint8_t spatialLayer{ 0 };
+				uint8_t temporalLayer{ 0 };
+				uint8_t fdiffCount{ 0 };
+			};
+
+			// Latest template dependency structure announced by the sender.
+			class DecodingContext : public RTC::Codecs::DecodingContext
+			{
+			public:
+				~DecodingContext() = default;
+
+			public:
+				bool hasStructure{ false };
+				uint8_t templateIdOffset{ 0 };
+				uint8_t decodeTargetCount{ 0 };
+				std::vector<FrameDependencyTemplate> templates;
+			};
+
+			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			{
+				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
+				~PayloadDescriptor() = default;
+				void Dump() const;
+
+				// Dependency descriptor mandatory fields.
+				uint8_t startOfFrame : 1;
+				uint8_t endOfFrame : 1;
+				uint8_t templateId : 6;
+				uint16_t frameNumber;
+				// Resolved from the frame dependency template.
+				uint8_t spatialLayer{ 0 };
+				uint8_t temporalLayer{ 0 };
+
+				bool isKeyFrame   = { false };
+				bool hasStructure = { false };
+				bool hasLayers    = { false };
+			};
+
+		public:
+			static AV1::PayloadDescriptor* Parse(
+			  uint8_t* data,
+			  size_t len,
+			  const uint8_t* dependencyDescriptor,
+			  size_t dependencyDescriptorLen,
+			  DecodingContext* context);
+			static void ProcessRtpPacket(RTC::RtpPacket* packet, DecodingContext* context = nullptr);
+
+		private:
+			static bool ParseStructure(
+			  const uint8_t* data, size_t len, size_t& bitOffset, DecodingContext* context);
+
+		public:
+			class EncodingContext : public RTC::Codecs::EncodingContext
+			{
+			public:
+				~EncodingContext() = default;
+
+				/* Pure virtual methods inherited from RTC::Codecs::EncodingContext. */
+			public:
+				void SyncRequired() override;
+
+			public:
+				// Highest spatial layer being forwarded. Switching to a higher one
+				// requires a key frame.
+				uint8_t currentSpatialLayer{ 0 };
+				// Highest temporal layer being forwarded. Switching to a higher one
+				// happens at the beginning of a base temporal layer frame.
+				uint8_t currentTemporalLayer{ std::numeric_limits<uint8_t>::max() };
+			};
+
+			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			{
+			public:
+				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
+				~PayloadDescriptorHandler() = default;
+
+			public:
+				void Dump() const;
+				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker);
+				void Restore(uint8_t* data);
+				bool IsKeyFrame() const;
+
+			private:
+				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+			};
+		};
+
+		/* Inline EncondingContext methods */
+
+		inline void AV1::EncodingContext::SyncRequired(){};
+
+		/* Inline PayloadDescriptorHandler methods */
+
+		inline void AV1::PayloadDescriptorHandler::Restore(uint8_t* data)
+		{
+			(void)data;
+
+			return;
+		}
+
+		inline bool AV1::PayloadDescriptorHandler::IsKeyFrame() const
+		{
+			return this->payloadDescriptor->isKeyFrame;
+		};
+
+		inline void AV1::PayloadDescriptorHandler::Dump() const
+		{
+			this->payloadDescriptor->Dump();
+		}
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
@@ -2,9 +2,11 @@
 #define MS_RTC_CODECS_HPP
 
 #include "common.hpp"
+#include "RTC/Codecs/AV1.hpp"
 #include "RTC/Codecs/H264.hpp"
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/Codecs/VP8.hpp"
+#include "RTC/Codecs/VP9.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
 
@@ -13,8 +15,13 @@ namespace RTC
 	namespace Codecs
 	{
 		bool CanBeKeyFrame(const RTC::RtpCodecMimeType& mimeType);
-		void ProcessRtpPacket(RTC::RtpPacket* packet, const RTC::RtpCodecMimeType& mimeType);
+		void ProcessRtpPacket(
+		  RTC::RtpPacket* packet,
+		  const RTC::RtpCodecMimeType& mimeType,
+		  DecodingContext* decodingContext = nullptr);
 		EncodingContext* GetEncodingContext(const RTC::RtpCodecMimeType& mimeType);
+		DecodingContext* GetDecodingContext(const RTC::RtpCodecMimeType& mimeType);
+		bool IsComfortNoise(const RTC::RtpPacket* packet, const RTC::RtpCodecMimeType& mimeType);
 
 		// Inline namespace methods.
 
@@ -26,7 +33,9 @@ namespace RTC
 			switch (mimeType.subtype)
 			{
 				case RTC::RtpCodecMimeType::Subtype::VP8:
+				case RTC::RtpCodecMimeType::Subtype::VP9:
 				case RTC::RtpCodecMimeType::Subtype::H264:
+				case RTC::RtpCodecMimeType::Subtype::AV1:
 					return true;
 				default:
 					return false;
@@ -42,12 +51,42 @@ namespace RTC
 			{
 				case RTC::RtpCodecMimeType::Subtype::VP8:
 					return new Codecs::VP8::EncodingContext();
+				case RTC::RtpCodecMimeType::Subtype::VP9:
+					return new Codecs::VP9::EncodingContext();
 				case RTC::RtpCodecMimeType::Subtype::H264:
 					return new Codecs::H264::EncodingContext();
+				case RTC::RtpCodecMimeType::Subtype::AV1:
+					return new Codecs::AV1::EncodingContext();
 				default:
 					return nullptr;
 			}
 		}
+
+		inline DecodingContext* GetDecodingContext(const RTC::RtpCodecMimeType& mimeType)
+		{
+			switch (mimeType.subtype)
+			{
+				case RTC::RtpCodecMimeType::Subtype::AV1:
+					return new Codecs::AV1::DecodingContext();
+				default:
+					return nullptr;
+			}
+		}
+
+		inline bool IsComfortNoise(const RTC::RtpPacket* packet, const RTC::RtpCodecMimeType& mimeType)
+		{
+			switch (mimeType.subtype)
+			{
+				// RFC 3389 comfort noise payload.
+				case RTC::RtpCodecMimeType::Subtype::CN:
+					return true;
+				// Opus DTX frames carry just the TOC byte (plus an optional extra byte).
+				case RTC::RtpCodecMimeType::Subtype::OPUS:
+					return packet->GetPayloadLength() <= 2;
+				default:
+					return false;
+			}
+		}
 	} // namespace Codecs
 } // namespace RTC
 
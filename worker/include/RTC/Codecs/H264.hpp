@@ -5,6 +5,20 @@
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
+#include <limits> // std::numeric_limits
+
+/* draft-ietf-avtext-framemarking-07
+ * Frame Marking RTP Header Extension
+ *
+
+  Short (non-scalable) form             Long (scalable) form
+ ===========================            ======================================
+
+      0 1 2 3 4 5 6 7                       0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+     |S|E|I|D|B| TID |                     |S|E|I|D|B| TID |      LID      |   TL0PICIDX   |
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
 
 namespace RTC
 {
@@ -19,11 +33,24 @@ namespace RTC
 				~PayloadDescriptor() = default;
 				void Dump() const;
 
+				// frame-marking fields.
+				uint8_t start : 1;
+				uint8_t end : 1;
+				uint8_t independent : 1;
+				uint8_t discardable : 1;
+				uint8_t baseLayerSync : 1;
+				uint8_t tlIndex : 3;
+
 				bool isKeyFrame = { false };
+				bool hasTlIndex = { false };
 			};
 
 		public:
-			static H264::PayloadDescriptor* Parse(uint8_t* data, size_t len);
+			static H264::PayloadDescriptor* Parse(
+			  uint8_t* data,
+			  size_t len,
+			  const uint8_t* frameMarking = nullptr,
+			  size_t frameMarkingLen      = 0);
 			static void ProcessRtpPacket(RTC::RtpPacket* packet);
 
 		public:
@@ -35,6 +62,11 @@ namespace RTC
 				/* Pure virtual methods inherited from RTC::Codecs::EncodingContext. */
 			public:
 				void SyncRequired() override;
+
+			public:
+				// Highest temporal layer being forwarded. Switching to a higher one
+				// requires an independent frame or a base layer sync frame.
+				uint8_t currentTemporalLayer{ std::numeric_limits<uint8_t>::max() };
 			};
 
 			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
@@ -45,7 +77,7 @@ namespace RTC
 
 			public:
 				void Dump() const;
-				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data);
+				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker);
 				void Restore(uint8_t* data);
 				bool IsKeyFrame() const;
 
@@ -60,15 +92,6 @@ namespace RTC
 
 		/* Inline PayloadDescriptorHandler methods */
 
-		inline bool H264::PayloadDescriptorHandler::Encode(
-		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* data)
-		{
-			(void)encodingContext;
-			(void)data;
-
-			return true;
-		};
-
 		inline void H264::PayloadDescriptorHandler::Restore(uint8_t* data)
 		{
 			(void)data;
@@ -2,7 +2,8 @@
 #define MS_RTC_PAYLOAD_DESCRIPTOR_HANDLER_HPP
 
 #include "common.hpp"
-#include <limits> // std::numeric_limits
+#include <algorithm> // std::min()
+#include <limits>    // std::numeric_limits
 
 namespace RTC
 {
@@ -15,6 +16,14 @@ namespace RTC
 			virtual void Dump() const    = 0;
 		};
 
+		// Decoding context kept by each receiving stream for codecs whose payload
+		// descriptor can only be interpreted with state from previous packets.
+		class DecodingContext
+		{
+		public:
+			virtual ~DecodingContext() = default;
+		};
+
 		// Encoding context used by PayloadDescriptorHandler to properly rewrite the PayloadDescriptor.
 		class EncodingContext
 		{
@@ -31,21 +40,29 @@ namespace RTC
 		public:
 			virtual void SyncRequired() = 0;
 			virtual void SetPreferences(Preferences preferences);
+			// Temporarily forward no temporal layer higher than the given one (i.e.
+			// on congestion) regardless of the preferences.
+			void SetTemporalLayerLimit(uint8_t temporalLayerLimit);
+			uint8_t GetTargetTemporalLayer() const;
 
 		public:
 			virtual ~EncodingContext() = default;
 
 		public:
 			Preferences preferences;
+			uint8_t temporalLayerLimit{ std::numeric_limits<uint8_t>::max() };
 		};
 
 		class PayloadDescriptorHandler
 		{
 		public:
-			virtual void Dump() const                                                 = 0;
-			virtual bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data) = 0;
-			virtual void Restore(uint8_t* data)                                       = 0;
-			virtual bool IsKeyFrame() const                                           = 0;
+			virtual void Dump() const = 0;
+			// The handler may set 'marker' to true when the packet ends the frame as
+			// seen by the receiver (i.e. higher spatial layers are being dropped).
+			virtual bool Encode(
+			  RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker) = 0;
+			virtual void Restore(uint8_t* data)                                   = 0;
+			virtual bool IsKeyFrame() const                                       = 0;
 
 		public:
 			virtual ~PayloadDescriptorHandler() = default;
@@ -55,6 +72,16 @@ namespace RTC
 		{
 			this->preferences = preferences;
 		}
+
+		inline void EncodingContext::SetTemporalLayerLimit(uint8_t temporalLayerLimit)
+		{
+			this->temporalLayerLimit = temporalLayerLimit;
+		}
+
+		inline uint8_t EncodingContext::GetTargetTemporalLayer() const
+		{
+			return std::min(this->preferences.temporalLayer, this->temporalLayerLimit);
+		}
 	} // namespace Codecs
 } // namespace RTC
 
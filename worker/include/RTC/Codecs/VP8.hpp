@@ -89,6 +89,7 @@ namespace RTC
 			public:
 				SeqManager<uint16_t> pictureIdManager;
 				SeqManager<uint8_t> tl0PictureIndexManager;
+				uint8_t currentTemporalLayer{ std::numeric_limits<uint8_t>::max() };
 				bool syncRequired{ false };
 			};
 
@@ -100,7 +101,7 @@ namespace RTC
 
 			public:
 				void Dump() const;
-				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data);
+				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker);
 				void Restore(uint8_t* data);
 				bool IsKeyFrame() const;
 
@@ -0,0 +1,138 @@
+#ifndef MS_RTC_CODECS_VP9_HPP
+#define MS_RTC_CODECS_VP9_HPP
+
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/SeqManager.hpp"
+
+/* draft-ietf-payload-vp9
+ * VP9 Payload Descriptor
+ *
+
+  Flexible mode (F = 1)                 Non-flexible mode (F = 0)
+ =======================                ==========================
+
+      0 1 2 3 4 5 6 7                       0 1 2 3 4 5 6 7
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+     |I|P|L|F|B|E|V|-| (REQUIRED)          |I|P|L|F|B|E|V|-| (REQUIRED)
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+I:   |M| PICTURE ID  | (RECOMMENDED)    I: |M| PICTURE ID  | (RECOMMENDED)
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+M:   | EXTENDED PID  | (RECOMMENDED)    M: | EXTENDED PID  | (RECOMMENDED)
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+L:   | TID |U| SID |D| (CONDITIONALLY)  L: | TID |U| SID |D| (CONDITIONALLY)
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+     |   P_DIFF    |N| (CONDITIONALLY)     |   TL0PICIDX   | (CONDITIONALLY)
+     +-+-+-+-+-+-+-+-+ - up to 3 times     +-+-+-+-+-+-+-+-+
+V:   | SS            |                  V: | SS            |
+     | ..            |                     | ..            |
+     +-+-+-+-+-+-+-+-+                     +-+-+-+-+-+-+-+-+
+*/
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class VP9
+		{
+		public:
+			struct PayloadDescriptor : public RTC::Codecs::PayloadDescriptor
+			{
+				/* Pure virtual methods inherited from RTC::Codecs::PayloadDescriptor. */
+				~PayloadDescriptor() = default;
+				void Dump() const;
+
+				// Rewrite the buffer with the given pictureId and tl0PictureIndex values.
+				void Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PictureIndex) const;
+				void Restore(uint8_t* data) const;
+
+				// mandatory fields.
+				uint8_t i : 1; // PictureID present.
+				uint8_t p : 1; // Inter-picture predicted frame.
+				uint8_t l : 1; // Layer indices present.
+				uint8_t f : 1; // Flexible mode.
+				uint8_t b : 1; // Start of a frame.
+				uint8_t e : 1; // End of a frame.
+				uint8_t v : 1; // Scalability structure present.
+				// optional fields.
+				uint16_t pictureId;
+				uint8_t tlIndex : 3;
+				uint8_t switchingUpPoint : 1;
+				uint8_t slIndex : 3;
+				uint8_t interLayerDependency : 1;
+				uint8_t tl0PictureIndex;
+
+				bool isKeyFrame           = { false };
+				bool hasPictureId         = { false };
+				bool hasOneBytePictureId  = { false };
+				bool hasTwoBytesPictureId = { false };
+				bool hasTl0PictureIndex   = { false };
+				bool hasSlIndex           = { false };
+				bool hasTlIndex           = { false };
+			};
+
+		public:
+			static VP9::PayloadDescriptor* Parse(uint8_t* data, size_t len);
+			static void ProcessRtpPacket(RTC::RtpPacket* packet);
+
+		public:
+			class EncodingContext : public RTC::Codecs::EncodingContext
+			{
+			public:
+				~EncodingContext() = default;
+
+				/* Pure virtual methods inherited from RTC::Codecs::EncodingContext. */
+			public:
+				void SyncRequired() override;
+
+			public:
+				SeqManager<uint16_t> pictureIdManager;
+				SeqManager<uint8_t> tl0PictureIndexManager;
+				// Highest spatial layer being forwarded. Switching to a higher one
+				// requires a key frame.
+				uint8_t currentSpatialLayer{ 0 };
+				uint8_t currentTemporalLayer{ std::numeric_limits<uint8_t>::max() };
+				bool syncRequired{ false };
+			};
+
+			class PayloadDescriptorHandler : public RTC::Codecs::PayloadDescriptorHandler
+			{
+			public:
+				explicit PayloadDescriptorHandler(PayloadDescriptor* payloadDescriptor);
+				~PayloadDescriptorHandler() = default;
+
+			public:
+				void Dump() const;
+				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data, bool& marker);
+				void Restore(uint8_t* data);
+				bool IsKeyFrame() const;
+
+			private:
+				std::unique_ptr<PayloadDescriptor> payloadDescriptor;
+			};
+		};
+
+		/* Inline EncondingContext methods */
+
+		inline void VP9::EncodingContext::SyncRequired()
+		{
+			this->syncRequired = true;
+		};
+
+		/* Inline PayloadDescriptorHandler methods */
+
+		inline bool VP9::PayloadDescriptorHandler::IsKeyFrame() const
+		{
+			return this->payloadDescriptor->isKeyFrame;
+		};
+
+		inline void VP9::PayloadDescriptorHandler::Dump() const
+		{
+			this->payloadDescriptor->Dump();
+		}
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
@@ -5,18 +5,25 @@
 #include "Channel/Notifier.hpp"
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/ConsumerListener.hpp"
+#include "RTC/FlexFec.hpp"
+#include "RTC/LatencyHistogram.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
 #include "RTC/RTCP/Sdes.hpp"
+#include "RTC/RedEncoder.hpp"
+#include "RTC/RetransmissionBudget.hpp"
 #include "RTC/RtpDataCounter.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpMonitor.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpParametersCache.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include "RTC/SeqManager.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include "RTC/Transport.hpp"
 #include <json/json.h>
+#include <memory>
 #include <set>
 #include <unordered_set>
 
@@ -42,36 +49,47 @@ namespace RTC
 		void Destroy();
 		Json::Value ToJson() const;
 		Json::Value GetStats() const;
+		void FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const;
 		void AddListener(RTC::ConsumerListener* listener);
 		void RemoveListener(RTC::ConsumerListener* listener);
-		void Enable(RTC::Transport* transport, RTC::RtpParameters& rtpParameters);
+		void Enable(
+		  RTC::Transport* transport,
+		  std::shared_ptr<const RTC::SharedRtpParameters> rtpParameters,
+		  const RTC::RtpEncodingParameters& encoding);
 		void Pause();
 		void Resume();
 		void SourcePause();
 		void SourceResume();
+		void RequireSync();
 		void AddProfile(const RTC::RtpEncodingParameters::Profile profile, const RTC::RtpStream* rtpStream);
 		void RemoveProfile(const RTC::RtpEncodingParameters::Profile profile);
 		void SetPreferredProfile(const RTC::RtpEncodingParameters::Profile profile);
 		void SetSourcePreferredProfile(const RTC::RtpEncodingParameters::Profile profile);
 		void SetEncodingPreferences(const RTC::Codecs::EncodingContext::Preferences preferences);
+		void SetComfortNoiseSuppression(bool enabled);
 		void Disable();
 		bool IsEnabled() const;
-		const RTC::RtpParameters& GetParameters() const;
+		RTC::Transport* GetTransport() const;
+		const RTC::RtpEncodingParameters& GetEncoding() const;
 		bool IsPaused() const;
 		RTC::RtpEncodingParameters::Profile GetPreferredProfile() const;
-		void SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpEncodingParameters::Profile profile);
+		RTC::RtpEncodingParameters::Profile GetTargetProfile() const;
+		bool IsWaitingForKeyFrame() const;
+		bool SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpEncodingParameters::Profile profile);
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now);
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket);
 		void ReceiveKeyFrameRequest(RTCP::FeedbackPs::MessageType messageType);
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
 		uint32_t GetTransmissionRate(uint64_t now);
 		float GetLossPercentage() const;
+		float GetRtt() const;
 		void RequestKeyFrame();
 
 	private:
-		void FillSupportedCodecPayloadTypes();
-		void CreateRtpStream(RTC::RtpEncodingParameters& encoding);
+		void CreateRtpStream();
 		void RetransmitRtpPacket(RTC::RtpPacket* packet);
+		void SendRedPacket(RTC::RtpPacket* packet);
+		void SendFecPacket(RTC::RtpPacket* packet);
 		void RecalculateTargetProfile(bool force = false);
 		void SetEffectiveProfile(RTC::RtpEncodingParameters::Profile profile);
 		void MayRunProbation();
@@ -94,13 +112,16 @@ namespace RTC
 		// Passed by argument.
 		Channel::Notifier* notifier{ nullptr };
 		RTC::Transport* transport{ nullptr };
-		RTC::RtpParameters rtpParameters;
+		// Shared with other Consumers, the SSRCs are in the encoding.
+		std::shared_ptr<const RTC::SharedRtpParameters> rtpParameters;
+		RTC::RtpEncodingParameters encoding;
 		std::unordered_set<RTC::ConsumerListener*> listeners;
 		// Allocated by this.
 		RTC::RtpStreamSend* rtpStream{ nullptr };
 		RtpMonitor* rtpMonitor{ nullptr };
+		RTC::FlexFecEncoder* fecEncoder{ nullptr };
+		RTC::RedEncoder* redEncoder{ nullptr };
 		// Others.
-		std::unordered_set<uint8_t> supportedCodecPayloadTypes;
 		bool paused{ false };
 		bool sourcePaused{ false };
 		// Timestamp when last RTCP was sent.
@@ -108,6 +129,12 @@ namespace RTC
 		uint16_t maxRtcpInterval{ 0 };
 		// RTP counters.
 		RTC::RtpDataCounter retransmittedCounter;
+		RTC::RtpDataCounter fecCounter;
+		// Retransmission bitrate limit.
+		RTC::RetransmissionBudget retransmissionBudget;
+		// Key frame requested because the budget was exhausted. Not requested again
+		// until a key frame is forwarded or the budget is reset.
+		bool budgetKeyFrameRequested{ false };
 		// RTP sequence number and timestamp.
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		RTC::SeqManager<uint32_t> rtpTimestampManager;
@@ -123,6 +150,17 @@ namespace RTC
 		RTC::RtpEncodingParameters::Profile targetProfile{ RTC::RtpEncodingParameters::Profile::DEFAULT };
 		RTC::RtpEncodingParameters::Profile effectiveProfile{ RTC::RtpEncodingParameters::Profile::NONE };
 		RTC::RtpEncodingParameters::Profile probingProfile{ RTC::RtpEncodingParameters::Profile::NONE };
+		// Profile switch latency (time from the target profile change until the
+		// effective profile is the target one).
+		uint64_t profileSwitchStartedAt{ 0 };
+		RTC::LatencyHistogram upSwitchLatencyHistogram;
+		RTC::LatencyHistogram downSwitchLatencyHistogram;
+		// Key frames requested by this Consumer (i.e. to spot key frame storms).
+		size_t keyFrameRequestCount{ 0 };
+		// Comfort noise (RFC 3389 CN or Opus DTX) suppression.
+		bool suppressComfortNoise{ false };
+		bool comfortNoiseSent{ false };
+		size_t comfortNoiseDroppedCount{ 0 };
 		// RTP probation.
 		uint16_t rtpPacketsBeforeProbation{ RtpPacketsBeforeProbation };
 		uint16_t probationPackets{ 0 };
@@ -145,9 +183,19 @@ namespace RTC
 		return this->transport != nullptr;
 	}
 
-	inline const RTC::RtpParameters& Consumer::GetParameters() const
+	inline RTC::Transport* Consumer::GetTransport() const
 	{
-		return this->rtpParameters;
+		return this->transport;
+	}
+
+	inline const RTC::RtpEncodingParameters& Consumer::GetEncoding() const
+	{
+		return this->encoding;
+	}
+
+	inline float Consumer::GetRtt() const
+	{
+		return this->rtpStream != nullptr ? this->rtpStream->GetRtt() : 0;
 	}
 
 	inline bool Consumer::IsPaused() const
@@ -176,9 +224,26 @@ namespace RTC
 		return this->preferredProfile;
 	}
 
+	inline RTC::RtpEncodingParameters::Profile Consumer::GetTargetProfile() const
+	{
+		return this->targetProfile;
+	}
+
+	// Whether the next packet sent must start a new decodable sequence.
+	inline bool Consumer::IsWaitingForKeyFrame() const
+	{
+		return this->syncRequired || this->effectiveProfile != this->targetProfile;
+	}
+
 	inline uint32_t Consumer::GetTransmissionRate(uint64_t now)
 	{
-		return this->rtpStream->GetRate(now) + this->retransmittedCounter.GetRate(now);
+		uint32_t rate = this->rtpStream->GetRate(now) + this->retransmittedCounter.GetRate(now) +
+		                this->fecCounter.GetRate(now);
+
+		if (this->redEncoder != nullptr)
+			rate += this->redEncoder->GetBitrate(now);
+
+		return rate;
 	}
 
 	inline bool Consumer::IsProbing() const
@@ -1,7 +1,9 @@
 #ifndef MS_RTC_CONSUMER_LISTENER_HPP
 #define MS_RTC_CONSUMER_LISTENER_HPP
 
+#include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
+#include <vector>
 
 namespace RTC
 {
@@ -14,6 +16,12 @@ namespace RTC
 	public:
 		virtual void OnConsumerClosed(RTC::Consumer* consumer)           = 0;
 		virtual void OnConsumerKeyFrameRequired(RTC::Consumer* consumer) = 0;
+		virtual void OnConsumerRetransmissionRequired(
+		  RTC::Consumer* consumer,
+		  RTC::RtpEncodingParameters::Profile profile,
+		  const std::vector<uint16_t>& seqs) = 0;
+		// Just called for sampled packets, latency in microseconds.
+		virtual void OnConsumerRtpPacketRetransmitted(RTC::Consumer* consumer, uint64_t latency) = 0;
 	};
 } // namespace RTC
 
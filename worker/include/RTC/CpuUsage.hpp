@@ -0,0 +1,68 @@
+#ifndef MS_RTC_CPU_USAGE_HPP
+#define MS_RTC_CPU_USAGE_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+namespace RTC
+{
+	// CPU time spent on behalf of an object (a Transport, a Router). Scopes may
+	// be nested (a Transport receiving a packet makes other Transports send it)
+	// and the time spent in an inner scope is not accounted to the outer one.
+	// Scopes must not be kept around code that may destroy the owner, but if
+	// that happens the time of the live scopes is discarded.
+	class CpuUsage
+	{
+	public:
+		// Time window (in milliseconds) of the usage rate.
+		static constexpr uint64_t WindowSize{ 1000 };
+
+	public:
+		// Accounts the time spent in its scope to the given CpuUsage.
+		class Scope
+		{
+		public:
+			explicit Scope(CpuUsage* cpuUsage);
+			~Scope();
+
+		private:
+			friend class CpuUsage;
+
+		private:
+			CpuUsage* cpuUsage{ nullptr };
+			Scope* parent{ nullptr };
+			uint64_t startTime{ 0 };
+			uint64_t childTime{ 0 };
+		};
+
+	public:
+		CpuUsage() = default;
+		~CpuUsage();
+
+	public:
+		// Time in nanoseconds, now in milliseconds.
+		void Add(uint64_t time, uint64_t now);
+		// Total time in microseconds.
+		uint64_t GetTime() const;
+		// Microseconds per second during the latest complete window.
+		uint32_t GetRate(uint64_t now) const;
+
+	private:
+		static Scope* currentScope;
+
+	private:
+		uint64_t totalTime{ 0 };
+		uint64_t windowStartTime{ 0 };
+		uint64_t windowTime{ 0 };
+		uint64_t lastWindowTime{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint64_t CpuUsage::GetTime() const
+	{
+		return this->totalTime / 1000;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef MS_RTC_FLEX_FEC_HPP
+#define MS_RTC_FLEX_FEC_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+/* draft-ietf-payload-flexible-fec-scheme-03
+ * FlexFEC header with a single protected SSRC and a 15 bits packet mask.
+ *
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |R|F|P|X|  CC   |M| PT recovery |        length recovery        |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                          TS recovery                          |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |   SSRCCount   |                    reserved                   |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                             SSRC_i                            |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |           SN base_i           |k|          Mask [0-14]        |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ */
+
+namespace RTC
+{
+	class FlexFec
+	{
+	public:
+		// FlexFEC header size for a single SSRC and a 15 bits packet mask.
+		static constexpr size_t HeaderSize{ 20 };
+		// Max number of media packets protected by a single FEC packet.
+		static constexpr uint8_t MaxGroupSize{ 15 };
+
+	public:
+		static void Xor(uint8_t* dst, const uint8_t* src, size_t len);
+		static RtpPacket* RecoverPacket(
+		  const RtpPacket* fecPacket, const std::vector<RtpPacket*>& packets, uint8_t* buffer);
+	};
+
+	// Generates a FlexFEC packet every groupSize consecutive media packets.
+	class FlexFecEncoder
+	{
+	public:
+		FlexFecEncoder(uint8_t payloadType, uint32_t ssrc);
+
+	public:
+		RtpPacket* AddPacket(const RtpPacket* packet);
+		void SetFractionLost(uint8_t fractionLost);
+		void SetGroupSize(uint8_t groupSize);
+		uint8_t GetGroupSize() const;
+		uint32_t GetSsrc() const;
+
+	private:
+		void ResetGroup();
+		RtpPacket* CreateFecPacket();
+
+	private:
+		// Passed by argument.
+		uint8_t payloadType{ 0 };
+		uint32_t ssrc{ 0 };
+		// Others.
+		uint16_t seq{ 0 };
+		// Number of media packets per FEC packet (0 means disabled).
+		uint8_t groupSize{ 0 };
+		// Current group.
+		uint8_t numPackets{ 0 };
+		uint32_t mediaSsrc{ 0 };
+		uint16_t seqBase{ 0 };
+		uint32_t lastTimestamp{ 0 };
+		uint8_t headerRecovery[2];
+		uint16_t lengthRecovery{ 0 };
+		uint32_t timestampRecovery{ 0 };
+		size_t payloadRecoveryLength{ 0 };
+		uint8_t payloadRecovery[RTC::MtuSize];
+	};
+
+	/* Inline instance methods. */
+
+	inline uint8_t FlexFecEncoder::GetGroupSize() const
+	{
+		return this->groupSize;
+	}
+
+	inline uint32_t FlexFecEncoder::GetSsrc() const
+	{
+		return this->ssrc;
+	}
+} // namespace RTC
+
+#endif
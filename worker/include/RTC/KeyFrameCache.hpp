@@ -0,0 +1,78 @@
+#ifndef MS_RTC_KEY_FRAME_CACHE_HPP
+#define MS_RTC_KEY_FRAME_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <memory>
+#include <vector>
+
+namespace RTC
+{
+	// Keeps the packets of the latest key frame of a stream and every packet
+	// received after it (up to a bound), so new receivers can start decoding
+	// without waiting for a new key frame from the sender.
+	class KeyFrameCache
+	{
+	public:
+		static constexpr size_t MaxPackets{ 250 };
+		static constexpr uint64_t MaxAge{ 2000 }; // In ms.
+
+	public:
+		struct StorageItem
+		{
+			uint8_t store[RTC::MtuSize];
+		};
+
+	public:
+		class Item
+		{
+		public:
+			Item(const RTC::RtpPacket* packet, std::unique_ptr<StorageItem> storage);
+			~Item();
+
+		public:
+			std::unique_ptr<StorageItem> storage;
+			RTC::RtpPacket* packet{ nullptr };
+		};
+
+	public:
+		using Packets = std::vector<std::shared_ptr<Item>>;
+
+	public:
+		explicit KeyFrameCache(const RTC::RtpCodecMimeType& mimeType);
+
+	public:
+		void ReceivePacket(const RTC::RtpPacket* packet, uint64_t now);
+		bool IsValid(uint64_t now) const;
+		const Packets& GetPackets() const;
+		void Reset();
+
+	private:
+		void AddPacket(const RTC::RtpPacket* packet);
+
+	private:
+		// Passed by argument.
+		RTC::RtpCodecMimeType mimeType;
+		// Others.
+		std::unique_ptr<RTC::Codecs::DecodingContext> decodingContext;
+		Packets packets;
+		// Storage of the packets no longer cached, reused for the next ones.
+		std::vector<std::unique_ptr<StorageItem>> freeStorage;
+		bool hasKeyFrame{ false };
+		bool keyFrameComplete{ false };
+		uint32_t keyFrameTimestamp{ 0 };
+		uint64_t keyFrameTime{ 0 };
+		uint16_t lastSeq{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline const KeyFrameCache::Packets& KeyFrameCache::GetPackets() const
+	{
+		return this->packets;
+	}
+} // namespace RTC
+
+#endif
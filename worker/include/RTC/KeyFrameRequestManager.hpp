@@ -0,0 +1,99 @@
+#ifndef MS_RTC_KEY_FRAME_REQUEST_MANAGER_HPP
+#define MS_RTC_KEY_FRAME_REQUEST_MANAGER_HPP
+
+#include "common.hpp"
+#include "handles/Timer.hpp"
+#include <json/json.h>
+#include <map>
+
+namespace RTC
+{
+	// Schedules the key frame requests of the streams of a Producer. Requests for
+	// a stream within its min interval (derived from the RTT of the receivers
+	// asking for key frames, or the max one if unknown) are coalesced into a
+	// single PLI or FIR sent once the interval expires.
+	class KeyFrameRequestManager : public Timer::Listener
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual void OnKeyFrameRequestManagerSendPli(
+			  RTC::KeyFrameRequestManager* keyFrameRequestManager, uint32_t ssrc) = 0;
+			virtual void OnKeyFrameRequestManagerSendFir(
+			  RTC::KeyFrameRequestManager* keyFrameRequestManager, uint32_t ssrc, uint8_t seqNumber) = 0;
+		};
+
+	public:
+		static constexpr uint64_t MinRequestInterval{ 300 };     // In ms.
+		static constexpr uint64_t MaxRequestInterval{ 1000 };    // In ms.
+		static constexpr uint64_t RequestIntervalRttFactor{ 3 }; // Interval = factor * RTT.
+
+	private:
+		struct StreamState
+		{
+			bool usePli{ false };
+			bool useFir{ false };
+			uint64_t lastSentAt{ 0 };
+			// A request is waiting for the interval to expire.
+			bool pending{ false };
+			// A PLI/FIR was sent and no key frame was received yet.
+			bool waitingForKeyFrame{ false };
+			bool keyFrameReceived{ false };
+			uint8_t firSeqNumber{ 0 };
+			// RTT of the latest receiver asking for a key frame (0 if unknown).
+			uint32_t rtt{ 0 };
+			// Stats.
+			size_t requestCount{ 0 };
+			size_t coalescedCount{ 0 };
+			size_t servedCount{ 0 };
+		};
+
+	public:
+		explicit KeyFrameRequestManager(Listener* listener);
+		~KeyFrameRequestManager() override;
+
+	public:
+		void AddStream(uint32_t ssrc, bool usePli, bool useFir);
+		void SetRtt(uint32_t ssrc, uint32_t rtt);
+		void KeyFrameNeeded(uint32_t ssrc, bool force = false);
+		void KeyFrameReceived(uint32_t ssrc);
+		Json::Value GetStats(uint32_t ssrc) const;
+
+	private:
+		static uint64_t GetRequestInterval(const StreamState& stream);
+		void SendRequest(uint32_t ssrc, StreamState& stream, uint64_t now);
+		void MayRunTimer(uint64_t now);
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		Timer* timer{ nullptr };
+		// Others.
+		std::map<uint32_t, StreamState> streams;
+	};
+
+	/* Inline static methods. */
+
+	inline uint64_t KeyFrameRequestManager::GetRequestInterval(const StreamState& stream)
+	{
+		if (stream.rtt == 0)
+			return MaxRequestInterval;
+
+		uint64_t interval = RequestIntervalRttFactor * stream.rtt;
+
+		if (interval < MinRequestInterval)
+			return MinRequestInterval;
+		else if (interval > MaxRequestInterval)
+			return MaxRequestInterval;
+
+		return interval;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MS_RTC_LAST_N_HPP
+#define MS_RTC_LAST_N_HPP
+
+#include "common.hpp"
+#include <unordered_map>
+
+namespace RTC
+{
+	// Last-N selection. Each Transport with a limit N just gets the video of the
+	// N first Producers given in a selection (most active first), all the others
+	// are paused. Every Consumer of a Producer in the same Transport gets the same
+	// decision, so the Consumers of a Producer must be given together.
+	class LastN
+	{
+	public:
+		LastN() = default;
+
+	public:
+		void SetLimit(uint32_t transportId, uint32_t limit);
+		bool RemoveLimit(uint32_t transportId);
+		void Clear();
+		bool IsEmpty() const;
+		const std::unordered_map<uint32_t, uint32_t>& GetLimits() const;
+		// Starts a new selection.
+		void Begin();
+		bool Forward(uint32_t producerId, uint32_t transportId);
+
+	private:
+		struct Selection
+		{
+			uint32_t forwarded{ 0 };
+			// Latest Producer decided for the Transport.
+			uint32_t producerId{ 0 };
+			bool hasProducer{ false };
+			bool forward{ false };
+		};
+
+	private:
+		std::unordered_map<uint32_t, uint32_t> limits;
+		std::unordered_map<uint32_t, Selection> selections;
+	};
+
+	/* Inline instance methods. */
+
+	inline void LastN::SetLimit(uint32_t transportId, uint32_t limit)
+	{
+		this->limits[transportId] = limit;
+	}
+
+	inline bool LastN::RemoveLimit(uint32_t transportId)
+	{
+		return this->limits.erase(transportId) != 0;
+	}
+
+	inline void LastN::Clear()
+	{
+		this->limits.clear();
+		this->selections.clear();
+	}
+
+	inline bool LastN::IsEmpty() const
+	{
+		return this->limits.empty();
+	}
+
+	inline const std::unordered_map<uint32_t, uint32_t>& LastN::GetLimits() const
+	{
+		return this->limits;
+	}
+
+	inline void LastN::Begin()
+	{
+		this->selections.clear();
+	}
+} // namespace RTC
+
+#endif
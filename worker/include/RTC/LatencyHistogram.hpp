@@ -0,0 +1,48 @@
+#ifndef MS_RTC_LATENCY_HISTOGRAM_HPP
+#define MS_RTC_LATENCY_HISTOGRAM_HPP
+
+#include "common.hpp"
+#include <json/json.h>
+
+namespace RTC
+{
+	// Histogram of latency values with power of two buckets, so bucket 0 counts
+	// values in [0, 1], bucket 1 those in [2, 3], bucket 2 those in [4, 7] and so
+	// on. The last bucket also counts any higher value.
+	class LatencyHistogram
+	{
+	public:
+		static constexpr size_t NumBuckets{ 16 };
+
+	public:
+		LatencyHistogram() = default;
+
+	public:
+		void Add(uint64_t value);
+		uint64_t GetCount() const;
+		uint64_t GetMax() const;
+		uint64_t GetPercentile(uint8_t percentile) const;
+		void Reset();
+		Json::Value ToJson() const;
+
+	private:
+		uint64_t buckets[NumBuckets]{ 0 };
+		uint64_t count{ 0 };
+		uint64_t sum{ 0 };
+		uint64_t max{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint64_t LatencyHistogram::GetCount() const
+	{
+		return this->count;
+	}
+
+	inline uint64_t LatencyHistogram::GetMax() const
+	{
+		return this->max;
+	}
+} // namespace RTC
+
+#endif
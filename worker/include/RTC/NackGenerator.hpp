@@ -5,34 +5,34 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/SeqManager.hpp"
 #include "handles/Timer.hpp"
-#include <map>
-#include <set>
+#include <cstring> // std::memset()
 #include <vector>
 
 namespace RTC
 {
 	class NackGenerator : public Timer::Listener
 	{
+		// Number of slots in the NACK ring. Must be a power of 2 bigger than the
+		// max packet age so two alive items never share the same slot.
+		static constexpr uint16_t NackRingSize{ 8192 };
+
 	public:
-		class Listener
+		// A NACK FCI item (RFC 4585) in host byte order.
+		struct NackItem
 		{
-		public:
-			virtual void OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers) = 0;
-			virtual void OnNackGeneratorKeyFrameRequired()                                    = 0;
+			uint16_t packetId{ 0 };
+			uint16_t lostPacketBitmask{ 0 };
 		};
 
-	private:
-		struct NackInfo
+	public:
+		class Listener
 		{
-			NackInfo(){};
-			explicit NackInfo(uint16_t seq, uint16_t sendAtSeq);
-
-			uint16_t seq{ 0 };
-			uint16_t sendAtSeq{ 0 };
-			uint64_t sentAtTime{ 0 };
-			uint8_t retries{ 0 };
+		public:
+			virtual void OnNackGeneratorNackRequired(const std::vector<NackItem>& nackItems) = 0;
+			virtual void OnNackGeneratorKeyFrameRequired()                                   = 0;
 		};
 
+	private:
 		enum class NackFilter
 		{
 			SEQ,
@@ -44,6 +44,7 @@ namespace RTC
 		~NackGenerator() override;
 
 		bool ReceivePacket(RTC::RtpPacket* packet);
+		void RequestPackets(const std::vector<uint16_t>& seqs);
 		size_t GetNackListLength() const;
 		void Reset();
 
@@ -51,8 +52,13 @@ namespace RTC
 		void CleanOldNackItems(uint16_t seq);
 		void AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd);
 		void RemoveNackItemsUntilKeyFrame();
-		std::vector<uint16_t> GetNackBatch(NackFilter filter);
+		void RemoveNackItems(uint16_t seqStart, uint16_t seqEnd);
+		void GetNackBatch(NackFilter filter);
+		bool AddToNackBatch(uint16_t seq, uint64_t now);
 		void MayRunTimer() const;
+		bool IsInNackList(uint16_t seq) const;
+		void SetInNackList(uint16_t seq, bool value);
+		uint16_t GetNextNackSeq(uint16_t seq, uint16_t seqEnd) const;
 
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
@@ -64,9 +70,19 @@ namespace RTC
 		// Allocated by this.
 		Timer* timer{ nullptr };
 		// Others.
-		std::map<uint16_t, NackInfo, SeqManager<uint16_t>::SeqLowerThan> nackList;
-		// This set is just supposed to hold zero or one entries.
-		std::set<uint16_t, SeqManager<uint16_t>::SeqLowerThan> keyFrameList;
+		// Bitmap of missing packets indexed by seq (modulo NackRingSize).
+		uint64_t nackBitmap[NackRingSize / 64];
+		// Per slot NACK state, just meaningful if the slot bit is set.
+		uint64_t sentAtTime[NackRingSize];
+		uint8_t retries[NackRingSize];
+		size_t nackListLength{ 0 };
+		// Lower bound of the seq numbers in the NACK list.
+		uint16_t oldestSeq{ 0 };
+		// Batch of NACK items reused across calls.
+		std::vector<NackItem> nackBatch;
+		// Seq of the latest key frame (if hasKeyFrame is true).
+		bool hasKeyFrame{ false };
+		uint16_t keyFrameSeq{ 0 };
 		bool started{ false };
 		uint16_t lastSeq{ 0 }; // Seq number of last valid packet.
 		uint32_t rtt{ 0 };     // Round trip time (ms).
@@ -74,14 +90,9 @@ namespace RTC
 
 	// Inline instance methods.
 
-	inline NackGenerator::NackInfo::NackInfo(uint16_t seq, uint16_t sendAtSeq)
-	  : seq(seq), sendAtSeq(sendAtSeq)
-	{
-	}
-
 	inline size_t NackGenerator::GetNackListLength() const
 	{
-		return this->nackList.size();
+		return this->nackListLength;
 	}
 
 	inline void NackGenerator::Reset()
@@ -90,11 +101,29 @@ namespace RTC
 		this->lastSeq = 0;
 		this->rtt     = 0;
 
-		this->nackList.clear();
-		this->keyFrameList.clear();
+		std::memset(this->nackBitmap, 0, sizeof(this->nackBitmap));
+		this->nackListLength = 0;
+		this->hasKeyFrame    = false;
 
 		this->timer->Stop();
 	}
+
+	inline bool NackGenerator::IsInNackList(uint16_t seq) const
+	{
+		size_t slot = seq % NackRingSize;
+
+		return (this->nackBitmap[slot / 64] & (uint64_t{ 1 } << (slot % 64))) != 0;
+	}
+
+	inline void NackGenerator::SetInNackList(uint16_t seq, bool value)
+	{
+		size_t slot = seq % NackRingSize;
+
+		if (value)
+			this->nackBitmap[slot / 64] |= (uint64_t{ 1 } << (slot % 64));
+		else
+			this->nackBitmap[slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+	}
 } // namespace RTC
 
 #endif
@@ -0,0 +1,65 @@
+#ifndef MS_RTC_PACKET_LATENCY_HPP
+#define MS_RTC_PACKET_LATENCY_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+namespace RTC
+{
+	// Time spent by received packets inside the worker. Packets are processed
+	// synchronously from the moment they are read from the socket until they are
+	// sent, so the ingress time of the packet being processed is kept here while
+	// it is in scope. Just one of every SampleRate packets is timestamped.
+	class PacketLatency
+	{
+	public:
+		static constexpr uint32_t SampleRate{ 16 };
+
+		static_assert((SampleRate & (SampleRate - 1)) == 0, "SampleRate must be a power of 2");
+
+	public:
+		// Marks the packet received while in scope as the ingress one.
+		class Ingress
+		{
+		public:
+			Ingress();
+			~Ingress();
+		};
+
+	public:
+		static bool IsSampled();
+		// Microseconds since the ingress of the current packet.
+		static uint64_t GetElapsed();
+
+	private:
+		static uint32_t packetCount;
+		static uint64_t ingressTime;
+	};
+
+	/* Inline static methods. */
+
+	inline bool PacketLatency::IsSampled()
+	{
+		return PacketLatency::ingressTime != 0;
+	}
+
+	inline uint64_t PacketLatency::GetElapsed()
+	{
+		return (uv_hrtime() - PacketLatency::ingressTime) / 1000;
+	}
+
+	/* Inline Ingress methods. */
+
+	inline PacketLatency::Ingress::Ingress()
+	{
+		if ((++PacketLatency::packetCount & (SampleRate - 1)) == 0)
+			PacketLatency::ingressTime = uv_hrtime();
+	}
+
+	inline PacketLatency::Ingress::~Ingress()
+	{
+		PacketLatency::ingressTime = 0;
+	}
+} // namespace RTC
+
+#endif
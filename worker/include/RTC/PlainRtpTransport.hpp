@@ -34,6 +34,8 @@ namespace RTC
 	public:
 		Json::Value ToJson() const override;
 		Json::Value GetStats() const override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
 		void SetRemoteParameters(const std::string& ip, uint16_t port);
 		void SendRtpPacket(RTC::RtpPacket* packet) override;
 		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
@@ -3,6 +3,8 @@
 
 #include "common.hpp"
 #include "Channel/Notifier.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/KeyFrameRequestManager.hpp"
 #include "RTC/ProducerListener.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Feedback.hpp"
@@ -10,8 +12,8 @@
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStreamRecv.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include "RTC/Transport.hpp"
-#include "handles/Timer.hpp"
 #include <json/json.h>
 #include <map>
 #include <string>
@@ -20,7 +22,8 @@
 
 namespace RTC
 {
-	class Producer : public RtpStreamRecv::Listener, public Timer::Listener
+	class Producer : public RtpStreamRecv::Listener,
+	                 public RTC::KeyFrameRequestManager::Listener
 	{
 	public:
 		struct RtpMapping
@@ -32,16 +35,19 @@ namespace RTC
 	private:
 		struct HeaderExtensionIds
 		{
-			uint8_t ssrcAudioLevel{ 0 }; // 0 means no ssrc-audio-level id.
-			uint8_t absSendTime{ 0 };    // 0 means no abs-send-time id.
-			uint8_t mid{ 0 };            // 0 means no MID id.
-			uint8_t rid{ 0 };            // 0 means no RID id.
+			uint8_t ssrcAudioLevel{ 0 };       // 0 means no ssrc-audio-level id.
+			uint8_t absSendTime{ 0 };          // 0 means no abs-send-time id.
+			uint8_t mid{ 0 };                  // 0 means no MID id.
+			uint8_t rid{ 0 };                  // 0 means no RID id.
+			uint8_t frameMarking{ 0 };         // 0 means no frame-marking id.
+			uint8_t dependencyDescriptor{ 0 }; // 0 means no dependency-descriptor id.
 		};
 
 	private:
 		struct RtpStreamInfo
 		{
 			RTC::RtpStreamRecv* rtpStream{ nullptr };
+			RTC::KeyFrameCache* keyFrameCache{ nullptr };
 			std::string rid{};
 			RTC::RtpEncodingParameters::Profile profile{ RTC::RtpEncodingParameters::Profile::NONE };
 			uint32_t rtxSsrc{ 0 };
@@ -66,6 +72,7 @@ namespace RTC
 		void Destroy();
 		Json::Value ToJson() const;
 		Json::Value GetStats() const;
+		void FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const;
 		void AddListener(RTC::ProducerListener* listener);
 		void RemoveListener(RTC::ProducerListener* listener);
 		void Pause();
@@ -73,6 +80,7 @@ namespace RTC
 		void SetPreferredProfile(const RTC::RtpEncodingParameters::Profile profile);
 		const RTC::RtpParameters& GetParameters() const;
 		const struct RTC::Transport::HeaderExtensionIds& GetTransportHeaderExtensionIds() const;
+		RTC::Transport* GetTransport() const;
 		bool IsPaused() const;
 		RTC::RtpEncodingParameters::Profile GetPreferredProfile() const;
 		void ReceiveRtpPacket(RTC::RtpPacket* packet);
@@ -81,6 +89,10 @@ namespace RTC
 		void ReceiveRtcpFeedback(RTC::RTCP::FeedbackPsPacket* packet) const;
 		void ReceiveRtcpFeedback(RTC::RTCP::FeedbackRtpPacket* packet) const;
 		void RequestKeyFrame(bool force = false);
+		void RequestKeyFrame(RTC::RtpEncodingParameters::Profile profile, uint32_t rtt = 0);
+		void RequestRtpRetransmission(
+		  RTC::RtpEncodingParameters::Profile profile, const std::vector<uint16_t>& seqs);
+		const RTC::KeyFrameCache* GetKeyFrameCache(RTC::RtpEncodingParameters::Profile profile) const;
 		const std::map<RTC::RtpEncodingParameters::Profile, const RTC::RtpStream*>& GetActiveProfiles() const;
 
 	private:
@@ -96,14 +108,20 @@ namespace RTC
 		/* Pure virtual methods inherited from RTC::RtpStreamRecv::Listener. */
 	public:
 		void OnRtpStreamRecvNackRequired(
-		  RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers) override;
-		void OnRtpStreamRecvPliRequired(RTC::RtpStreamRecv* rtpStream) override;
+		  RTC::RtpStreamRecv* rtpStream,
+		  const std::vector<RTC::NackGenerator::NackItem>& nackItems) override;
+		void OnRtpStreamRecvKeyFrameRequired(RTC::RtpStreamRecv* rtpStream, bool force) override;
 		void OnRtpStreamInactive(RTC::RtpStream* rtpStream) override;
 		void OnRtpStreamActive(RTC::RtpStream* rtpStream) override;
 
-		/* Pure virtual methods inherited from Timer::Listener. */
+		/* Pure virtual methods inherited from RTC::KeyFrameRequestManager::Listener. */
 	public:
-		void OnTimer(Timer* timer) override;
+		void OnKeyFrameRequestManagerSendPli(
+		  RTC::KeyFrameRequestManager* keyFrameRequestManager, uint32_t ssrc) override;
+		void OnKeyFrameRequestManagerSendFir(
+		  RTC::KeyFrameRequestManager* keyFrameRequestManager,
+		  uint32_t ssrc,
+		  uint8_t seqNumber) override;
 
 	public:
 		// Passed by argument.
@@ -120,13 +138,12 @@ namespace RTC
 		// Allocated by this.
 		std::map<uint32_t, RtpStreamInfo> mapSsrcRtpStreamInfo;
 		std::map<RTC::RtpEncodingParameters::Profile, const RTC::RtpStream*> mapActiveProfiles;
-		Timer* keyFrameRequestBlockTimer{ nullptr };
+		RTC::KeyFrameRequestManager* keyFrameRequestManager{ nullptr };
 		// Others.
 		std::vector<RtpEncodingParameters> outputEncodings;
 		struct RTC::Transport::HeaderExtensionIds transportHeaderExtensionIds;
 		struct HeaderExtensionIds headerExtensionIds;
 		bool paused{ false };
-		bool isKeyFrameRequested{ false };
 		// Timestamp when last RTCP was sent.
 		uint64_t lastRtcpSentTime{ 0 };
 		uint16_t maxRtcpInterval{ 0 };
@@ -166,6 +183,11 @@ namespace RTC
 		return this->transportHeaderExtensionIds;
 	}
 
+	inline RTC::Transport* Producer::GetTransport() const
+	{
+		return this->transport;
+	}
+
 	inline bool Producer::IsPaused() const
 	{
 		return this->paused;
@@ -0,0 +1,107 @@
+#ifndef MS_RTC_RED_ENCODER_HPP
+#define MS_RTC_RED_ENCODER_HPP
+
+#include "common.hpp"
+#include "RTC/RtpDataCounter.hpp"
+#include "RTC/RtpPacket.hpp"
+
+/* RFC 2198
+ * RED header for each redundant block, followed by the primary block header.
+ *
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |F|   block PT  |  timestamp offset         |   block length    |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+     0 1 2 3 4 5 6 7
+    +-+-+-+-+-+-+-+-+
+    |0|   Block PT  |
+    +-+-+-+-+-+-+-+-+
+ */
+
+namespace RTC
+{
+	// Wraps outgoing audio packets into RED packets carrying the payloads of
+	// the previous packets as redundant blocks.
+	class RedEncoder
+	{
+	public:
+		// Max number of redundant blocks in a RED packet.
+		static constexpr uint8_t MaxDistance{ 2 };
+		static constexpr size_t BlockHeaderSize{ 4 };
+		static constexpr size_t PrimaryHeaderSize{ 1 };
+		static constexpr uint32_t MaxTimestampOffset{ 0x3FFF };
+		static constexpr size_t MaxBlockLength{ 0x3FF };
+
+	private:
+		struct Block
+		{
+			uint8_t payloadType{ 0 };
+			uint16_t seq{ 0 };
+			uint32_t timestamp{ 0 };
+			size_t length{ 0 };
+			uint8_t data[MaxBlockLength];
+		};
+
+	public:
+		explicit RedEncoder(uint8_t payloadType);
+
+	public:
+		RtpPacket* Encode(const RtpPacket* packet);
+		void SetFractionLost(uint8_t fractionLost);
+		void SetDistance(uint8_t distance);
+		uint8_t GetDistance() const;
+		uint8_t GetPayloadType() const;
+		uint32_t GetBitrate(uint64_t now);
+		size_t GetPacketCount() const;
+		size_t GetRedundantBytes() const;
+
+	private:
+		void StoreBlock(const RtpPacket* packet);
+
+	private:
+		// Passed by argument.
+		uint8_t payloadType{ 0 };
+		// Others.
+		// Number of previous payloads carried in each packet (0 means disabled).
+		uint8_t distance{ 0 };
+		// Circular history of the latest sent payloads.
+		Block blocks[MaxDistance];
+		uint8_t blocksIdx{ 0 };
+		uint8_t numBlocks{ 0 };
+		// Extra bytes sent due to RED encapsulation.
+		RTC::RateCalculator redundantRate;
+		size_t packetCount{ 0 };
+		size_t redundantBytes{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint8_t RedEncoder::GetDistance() const
+	{
+		return this->distance;
+	}
+
+	inline uint8_t RedEncoder::GetPayloadType() const
+	{
+		return this->payloadType;
+	}
+
+	inline uint32_t RedEncoder::GetBitrate(uint64_t now)
+	{
+		return this->redundantRate.GetRate(now);
+	}
+
+	inline size_t RedEncoder::GetPacketCount() const
+	{
+		return this->packetCount;
+	}
+
+	inline size_t RedEncoder::GetRedundantBytes() const
+	{
+		return this->redundantBytes;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef MS_RTC_RETRANSMISSION_BUDGET_HPP
+#define MS_RTC_RETRANSMISSION_BUDGET_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	// Token bucket limiting the retransmission bitrate to a fraction of the
+	// media bitrate.
+	class RetransmissionBudget
+	{
+	public:
+		// Max retransmission bitrate as a fraction of the media bitrate.
+		static constexpr float MaxRetransmissionRatio{ 0.5f };
+		// Min retransmission bitrate regardless of the media bitrate (bps).
+		static constexpr uint32_t MinBitrate{ 64000 };
+		// Bucket depth, in ms of budget.
+		static constexpr uint64_t BurstWindow{ 500 };
+
+	public:
+		RetransmissionBudget() = default;
+
+	public:
+		bool Consume(size_t size, uint32_t mediaBitrate, uint64_t now);
+		uint32_t GetBitrate() const;
+		size_t GetPacketsDropped() const;
+		size_t GetBytesDropped() const;
+		// The next usage starts with a full bucket. Dropped counters are kept.
+		void Reset();
+
+	private:
+		void Refill(uint32_t mediaBitrate, uint64_t now);
+
+	private:
+		// Effective budget (bps).
+		uint32_t bitrate{ 0 };
+		// Available budget (bytes).
+		size_t tokens{ 0 };
+		uint64_t lastRefillTime{ 0 };
+		size_t packetsDropped{ 0 };
+		size_t bytesDropped{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint32_t RetransmissionBudget::GetBitrate() const
+	{
+		return this->bitrate;
+	}
+
+	inline size_t RetransmissionBudget::GetPacketsDropped() const
+	{
+		return this->packetsDropped;
+	}
+
+	inline size_t RetransmissionBudget::GetBytesDropped() const
+	{
+		return this->bytesDropped;
+	}
+
+	inline void RetransmissionBudget::Reset()
+	{
+		this->bitrate        = 0;
+		this->tokens         = 0;
+		this->lastRefillTime = 0;
+	}
+} // namespace RTC
+
+#endif
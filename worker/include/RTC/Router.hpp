@@ -4,22 +4,32 @@
 #include "common.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
+#include "RTC/ActiveSpeakerDetector.hpp"
+#include "RTC/AudioTopK.hpp"
 #include "RTC/Consumer.hpp"
 #include "RTC/ConsumerListener.hpp"
+#include "RTC/CpuUsage.hpp"
+#include "RTC/LastN.hpp"
+#include "RTC/LatencyHistogram.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/ProducerListener.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpParametersCache.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include "RTC/Transport.hpp"
 #include "handles/Timer.hpp"
 #include <json/json.h>
+#include <list>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace RTC
 {
 	class Router : public RTC::Transport::Listener,
 	               public RTC::ProducerListener,
 	               public RTC::ConsumerListener,
+	               public RTC::ActiveSpeakerDetector::Listener,
 	               public Timer::Listener
 	{
 	public:
@@ -45,6 +55,7 @@ namespace RTC
 	public:
 		void Destroy();
 		Json::Value ToJson() const;
+		void FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const;
 		void HandleRequest(Channel::Request* request);
 
 	private:
@@ -54,6 +65,14 @@ namespace RTC
 		RTC::Producer* GetProducerFromRequest(Channel::Request* request) const;
 		uint32_t GetNewConsumerIdFromRequest(Channel::Request* request) const;
 		RTC::Consumer* GetConsumerFromRequest(Channel::Request* request) const;
+		RTC::Consumer* CreateConsumer(
+		  uint32_t consumerId, RTC::Media::Kind kind, RTC::Producer* producer);
+		void MayUpdateActiveSpeakerDetector();
+		void ApplyLastN();
+		bool ScheduleKeyFrameFromCache(RTC::Consumer* consumer, RTC::Producer* producer);
+		bool SendKeyFrameFromCache(RTC::Consumer* consumer, RTC::Producer* producer);
+		bool UpdateAudioTopK(RTC::Producer* producer, const RTC::RtpPacket* packet);
+		void RemoveAudioTopKProducer(RTC::Producer* producer);
 
 		/* Pure virtual methods inherited from RTC::Transport::Listener. */
 	public:
@@ -81,6 +100,17 @@ namespace RTC
 	public:
 		void OnConsumerClosed(RTC::Consumer* consumer) override;
 		void OnConsumerKeyFrameRequired(RTC::Consumer* consumer) override;
+		void OnConsumerRetransmissionRequired(
+		  RTC::Consumer* consumer,
+		  RTC::RtpEncodingParameters::Profile profile,
+		  const std::vector<uint16_t>& seqs) override;
+		void OnConsumerRtpPacketRetransmitted(RTC::Consumer* consumer, uint64_t latency) override;
+
+		/* Pure virtual methods inherited from RTC::ActiveSpeakerDetector::Listener. */
+	public:
+		void OnActiveSpeakerChanged(
+		  RTC::ActiveSpeakerDetector* activeSpeakerDetector, uint32_t producerId) override;
+		void OnActiveSpeakerLost(RTC::ActiveSpeakerDetector* activeSpeakerDetector) override;
 
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
@@ -96,6 +126,9 @@ namespace RTC
 		Channel::Notifier* notifier{ nullptr };
 		// Allocated by this.
 		Timer* audioLevelsTimer{ nullptr };
+		Timer* activeSpeakerTimer{ nullptr };
+		Timer* keyFrameCacheTimer{ nullptr };
+		RTC::ActiveSpeakerDetector* activeSpeakerDetector{ nullptr };
 		// Others.
 		std::unordered_map<uint32_t, RTC::Transport*> transports;
 		std::unordered_map<uint32_t, RTC::Producer*> producers;
@@ -104,6 +137,27 @@ namespace RTC
 		std::unordered_map<const RTC::Consumer*, RTC::Producer*> mapConsumerProducer;
 		std::unordered_map<RTC::Producer*, struct AudioLevelContainer> mapProducerAudioLevelContainer;
 		bool audioLevelsEventEnabled{ false };
+		bool activeSpeakerEventEnabled{ false };
+		// Last-N: max number of video Producers forwarded to each Transport.
+		RTC::LastN lastN;
+		// Video Producers sorted by speaker activity (most recent first).
+		std::list<RTC::Producer*> lastNRanking;
+		// Consumers paused by Last-N.
+		std::unordered_set<RTC::Consumer*> lastNPausedConsumers;
+		// Consumers to be sent a key frame from the Producer key frame cache.
+		std::unordered_set<RTC::Consumer*> keyFrameCacheConsumers;
+		// Max number of audio Producers forwarded at the same time (0 means all).
+		RTC::AudioTopK audioTopK;
+		// RTP parameters shared by the Consumers.
+		RTC::RtpParametersCache rtpParametersCache;
+		// Reused for every router.getStats request, keeps the counters for deltas.
+		RTC::StatsSnapshot statsSnapshot;
+		// Time (in microseconds) from the reception of sampled packets until they
+		// are sent to each Consumer, or retransmitted when they are NACKs.
+		RTC::LatencyHistogram forwardingLatencyHistogram;
+		RTC::LatencyHistogram retransmissionLatencyHistogram;
+		// CPU time of the Router timers (Transports account their own).
+		RTC::CpuUsage cpuUsage;
 	};
 } // namespace RTC
 
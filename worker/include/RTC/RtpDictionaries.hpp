@@ -58,6 +58,7 @@ namespace RTC
 			H264,
 			X_H264UC,
 			H265,
+			AV1,
 			// Complementary codecs:
 			CN = 300,
 			TELEPHONE_EVENT,
@@ -129,13 +130,15 @@ namespace RTC
 	public:
 		enum class Type : uint8_t
 		{
-			UNKNOWN           = 0,
-			SSRC_AUDIO_LEVEL  = 1,
-			TO_OFFSET         = 2,
-			ABS_SEND_TIME     = 3,
-			VIDEO_ORIENTATION = 4,
-			MID               = 5,
-			RTP_STREAM_ID     = 6
+			UNKNOWN               = 0,
+			SSRC_AUDIO_LEVEL      = 1,
+			TO_OFFSET             = 2,
+			ABS_SEND_TIME         = 3,
+			VIDEO_ORIENTATION     = 4,
+			MID                   = 5,
+			RTP_STREAM_ID         = 6,
+			FRAME_MARKING         = 7,
+			DEPENDENCY_DESCRIPTOR = 8
 		};
 
 	private:
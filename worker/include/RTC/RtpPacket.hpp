@@ -119,6 +119,8 @@ namespace RTC
 		bool ReadAbsSendTime(uint32_t* time) const;
 		bool ReadMid(const uint8_t** data, size_t* len) const;
 		bool ReadRid(const uint8_t** data, size_t* len) const;
+		bool ReadFrameMarking(const uint8_t** data, size_t* len) const;
+		bool ReadDependencyDescriptor(const uint8_t** data, size_t* len) const;
 		uint8_t* GetPayload() const;
 		size_t GetPayloadLength() const;
 		uint8_t GetPayloadPadding() const;
@@ -148,6 +150,8 @@ namespace RTC
 		size_t size{ 0 }; // Full size of the packet in bytes.
 		// Codecs
 		std::unique_ptr<Codecs::PayloadDescriptorHandler> payloadDescriptorHandler;
+		// Whether EncodePayload() modified the marker bit.
+		bool markerEncoded{ false };
 	};
 
 	/* Inline static methods. */
@@ -374,6 +378,40 @@ namespace RTC
 		return true;
 	}
 
+	inline bool RtpPacket::ReadFrameMarking(const uint8_t** data, size_t* len) const
+	{
+		uint8_t extenLen;
+		uint8_t* extenValue;
+
+		extenValue = GetExtension(RTC::RtpHeaderExtensionUri::Type::FRAME_MARKING, &extenLen);
+
+		// Short (non scalable) form is 1 byte, long (scalable) form is 3 bytes.
+		if (!extenValue || (extenLen != 1 && extenLen != 3))
+			return false;
+
+		*data = extenValue;
+		*len  = static_cast<size_t>(extenLen);
+
+		return true;
+	}
+
+	inline bool RtpPacket::ReadDependencyDescriptor(const uint8_t** data, size_t* len) const
+	{
+		uint8_t extenLen;
+		uint8_t* extenValue;
+
+		extenValue = GetExtension(RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR, &extenLen);
+
+		// Mandatory fields take 3 bytes.
+		if (!extenValue || extenLen < 3)
+			return false;
+
+		*data = extenValue;
+		*len  = static_cast<size_t>(extenLen);
+
+		return true;
+	}
+
 	inline uint8_t* RtpPacket::GetPayload() const
 	{
 		return this->payload;
@@ -0,0 +1,104 @@
+#ifndef MS_RTC_RTP_PARAMETERS_CACHE_HPP
+#define MS_RTC_RTP_PARAMETERS_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include <json/json.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace RTC
+{
+	// Immutable RTP parameters shared by the Consumers negotiated with the same
+	// capabilities, along with data derived from them. SSRCs are not part of
+	// them since every Consumer has its own ones.
+	class SharedRtpParameters
+	{
+	public:
+		explicit SharedRtpParameters(Json::Value& data);
+		SharedRtpParameters(const SharedRtpParameters&) = delete;
+		SharedRtpParameters& operator=(const SharedRtpParameters&) = delete;
+
+	public:
+		const RTC::RtpParameters& GetRtpParameters() const;
+		RTC::RtpEncodingParameters GetEncoding(const Json::Value& data) const;
+		bool IsSupportedPayloadType(uint8_t payloadType) const;
+		bool IsComfortNoisePayloadType(uint8_t payloadType) const;
+		const RTC::RtpCodecParameters* GetCodec(uint8_t payloadType) const;
+		const RTC::RtpCodecParameters* GetRtxCodec(uint8_t payloadType) const;
+
+	private:
+		RTC::RtpParameters rtpParameters;
+		// Codecs indexed by payload type.
+		std::unordered_map<uint8_t, const RTC::RtpCodecParameters*> codecs;
+		// RTX codecs indexed by the payload type of their associated codec.
+		std::unordered_map<uint8_t, const RTC::RtpCodecParameters*> rtxCodecs;
+		std::unordered_set<uint8_t> comfortNoisePayloadTypes;
+	};
+
+	// Interns SharedRtpParameters by the canonical form of their JSON, so
+	// Consumers of the same Producer with the same capabilities share a single
+	// instance. Instances are released once no Consumer uses them.
+	class RtpParametersCache
+	{
+	public:
+		std::shared_ptr<const SharedRtpParameters> Get(Json::Value& data);
+		size_t GetSize() const;
+
+	private:
+		void RemoveUnused();
+
+	private:
+		std::unordered_map<std::string, std::weak_ptr<const SharedRtpParameters>> entries;
+		// Encoding buffer for the canonical keys.
+		std::vector<uint8_t> keyBuffer;
+	};
+
+	/* Inline instance methods. */
+
+	inline const RTC::RtpParameters& SharedRtpParameters::GetRtpParameters() const
+	{
+		return this->rtpParameters;
+	}
+
+	inline bool SharedRtpParameters::IsSupportedPayloadType(uint8_t payloadType) const
+	{
+		return this->codecs.find(payloadType) != this->codecs.end();
+	}
+
+	inline bool SharedRtpParameters::IsComfortNoisePayloadType(uint8_t payloadType) const
+	{
+		return this->comfortNoisePayloadTypes.find(payloadType) !=
+		       this->comfortNoisePayloadTypes.end();
+	}
+
+	inline const RTC::RtpCodecParameters* SharedRtpParameters::GetCodec(uint8_t payloadType) const
+	{
+		auto it = this->codecs.find(payloadType);
+
+		if (it == this->codecs.end())
+			return nullptr;
+
+		return it->second;
+	}
+
+	inline const RTC::RtpCodecParameters* SharedRtpParameters::GetRtxCodec(uint8_t payloadType) const
+	{
+		auto it = this->rtxCodecs.find(payloadType);
+
+		if (it == this->rtxCodecs.end())
+			return nullptr;
+
+		return it->second;
+	}
+
+	inline size_t RtpParametersCache::GetSize() const
+	{
+		return this->entries.size();
+	}
+} // namespace RTC
+
+#endif
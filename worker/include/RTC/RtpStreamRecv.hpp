@@ -1,6 +1,7 @@
 #ifndef MS_RTC_RTP_STREAM_RECV_HPP
 #define MS_RTC_RTP_STREAM_RECV_HPP
 
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/NackGenerator.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
 #include "RTC/RTCP/SenderReport.hpp"
@@ -15,10 +16,11 @@ namespace RTC
 		{
 		public:
 			virtual void OnRtpStreamRecvNackRequired(
-			  RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers) = 0;
-			virtual void OnRtpStreamRecvPliRequired(RTC::RtpStreamRecv* rtpStream)    = 0;
-			virtual void OnRtpStreamInactive(RTC::RtpStream* rtpStream)               = 0;
-			virtual void OnRtpStreamActive(RTC::RtpStream* rtpStream)                 = 0;
+			  RTC::RtpStreamRecv* rtpStream,
+			  const std::vector<RTC::NackGenerator::NackItem>& nackItems)               = 0;
+			virtual void OnRtpStreamRecvKeyFrameRequired(RTC::RtpStreamRecv* rtpStream, bool force) = 0;
+			virtual void OnRtpStreamInactive(RTC::RtpStream* rtpStream)                 = 0;
+			virtual void OnRtpStreamActive(RTC::RtpStream* rtpStream)                   = 0;
 		};
 
 	public:
@@ -31,7 +33,8 @@ namespace RTC
 		RTC::RTCP::ReceiverReport* GetRtcpReceiverReport();
 		void ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report);
 		void SetRtx(uint8_t payloadType, uint32_t ssrc);
-		void RequestKeyFrame();
+		void RequestKeyFrame(bool force = false);
+		void RequestRtpRetransmission(const std::vector<uint16_t>& seqs);
 		bool IsActive() const;
 
 	private:
@@ -43,7 +46,8 @@ namespace RTC
 
 		/* Pure virtual methods inherited from RTC::NackGenerator. */
 	protected:
-		void OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers) override;
+		void OnNackGeneratorNackRequired(
+		  const std::vector<RTC::NackGenerator::NackItem>& nackItems) override;
 		void OnNackGeneratorKeyFrameRequired() override;
 
 	private:
@@ -58,6 +62,8 @@ namespace RTC
 		                               // arrival.
 		uint32_t transit{ 0 };         // Relative trans time for prev pkt.
 		std::unique_ptr<RTC::NackGenerator> nackGenerator;
+		// Codec state needed to parse the payload descriptor (if any).
+		std::unique_ptr<RTC::Codecs::DecodingContext> decodingContext;
 		// RTX related.
 		bool hasRtx{ false };
 		uint8_t rtxPayloadType{ 0 };
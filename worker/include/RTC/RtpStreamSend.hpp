@@ -32,7 +32,7 @@ namespace RTC
 		Json::Value GetStats() override;
 		bool ReceivePacket(RTC::RtpPacket* packet) override;
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
-		void RequestRtpRetransmission(
+		uint32_t RequestRtpRetransmission(
 		  uint16_t seq, uint16_t bitmask, std::vector<RTC::RtpPacket*>& container);
 		RTC::RTCP::SenderReport* GetRtcpSenderReport(uint64_t now);
 		void SetRtx(uint8_t payloadType, uint32_t ssrc);
@@ -40,6 +40,8 @@ namespace RTC
 		void RtxEncode(RtpPacket* packet);
 		void ClearRetransmissionBuffer();
 		bool IsHealthy() const;
+		uint32_t GetRetransmissionWindow() const;
+		float GetRtt() const;
 
 	private:
 		void StorePacket(RTC::RtpPacket* packet);
@@ -55,6 +57,7 @@ namespace RTC
 		Buffer buffer;
 		// Stats.
 		float rtt{ 0 };
+		uint32_t jitter{ 0 }; // Interarrival jitter reported by the receiver (RTP units).
 
 	private:
 		// Retransmittion related.
@@ -64,6 +67,11 @@ namespace RTC
 		uint16_t rtxSeq{ 0 };
 	};
 
+	inline float RtpStreamSend::GetRtt() const
+	{
+		return this->rtt;
+	}
+
 	inline bool RtpStreamSend::HasRtx() const
 	{
 		return this->hasRtx;
@@ -40,11 +40,16 @@ namespace RTC
 		void Drop(T input);
 		void Offset(T offset);
 		bool Input(const T input, T& output);
+		bool GetInput(const T output, T& input) const;
 		T GetMaxInput() const;
 		T GetMaxOutput() const;
 
+	private:
+		size_t CountDroppedLowerThan(T input) const;
+
 	private:
 		T base{ 0 };
+		T syncOutput{ 0 };
 		T maxOutput{ 0 };
 		T maxInput{ 0 };
 		std::set<T, SeqLowerThan> dropped;
@@ -0,0 +1,157 @@
+#ifndef MS_RTC_STATS_SNAPSHOT_HPP
+#define MS_RTC_STATS_SNAPSHOT_HPP
+
+#include "common.hpp"
+#include <unordered_map>
+#include <vector>
+
+/* Router stats snapshot (all fields in network byte order).
+ *
+ * Header (16 bytes):
+
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |    version    |     flags     |          record size          |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                         record count                          |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                       timestamp (64 bits)                     |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+ * Producer stream and Consumer record (48 bytes). Counters are deltas if the
+ * delta flag is set, unless any of them went backwards (the object was reset).
+
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |     type      | fraction lost |            rtt (ms)           |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                              id                               |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                             ssrc                              |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                            bitrate                            |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                     packet count (64 bits)                    |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                      byte count (64 bits)                     |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                         packets lost                          |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                          NACK count                           |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                           PLI count                           |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                           FIR count                           |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+ * Transport record (48 bytes). Reserved fields are zero. Counters are deltas
+ * if the delta flag is set, unless any of them went backwards.
+
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |     type      |                   reserved                    |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                              id                               |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                      reserved (64 bits)                       |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                   bytes received (64 bits)                    |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                     bytes sent (64 bits)                      |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                      reserved (128 bits)                      |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+*/
+
+namespace RTC
+{
+	// Writes the stats of every Transport, Producer stream and Consumer of a
+	// Router as fixed size records into a single buffer.
+	class StatsSnapshot
+	{
+	public:
+		static constexpr uint8_t Version{ 1 };
+		static constexpr size_t HeaderSize{ 16 };
+		static constexpr size_t RecordSize{ 48 };
+
+	public:
+		enum class RecordType : uint8_t
+		{
+			TRANSPORT = 1,
+			PRODUCER_STREAM,
+			CONSUMER
+		};
+
+	public:
+		struct Record
+		{
+			RecordType type;
+			uint8_t fractionLost{ 0 };
+			uint16_t rtt{ 0 };
+			uint32_t id{ 0 };
+			uint32_t ssrc{ 0 };
+			uint32_t bitrate{ 0 };
+			// Counters.
+			uint64_t packetCount{ 0 };
+			uint64_t byteCount{ 0 };
+			uint32_t packetsLost{ 0 };
+			uint32_t nackCount{ 0 };
+			uint32_t pliCount{ 0 };
+			uint32_t firCount{ 0 };
+			// Transport counters.
+			uint64_t bytesReceived{ 0 };
+			uint64_t bytesSent{ 0 };
+		};
+
+	private:
+		struct Counters
+		{
+			uint64_t packetCount{ 0 };
+			uint64_t byteCount{ 0 };
+			uint32_t packetsLost{ 0 };
+			uint32_t nackCount{ 0 };
+			uint32_t pliCount{ 0 };
+			uint32_t firCount{ 0 };
+			uint64_t bytesReceived{ 0 };
+			uint64_t bytesSent{ 0 };
+		};
+
+	public:
+		void Begin(uint64_t now, bool delta);
+		void AddRecord(const Record& record);
+		const uint8_t* GetData() const;
+		size_t GetSize() const;
+		size_t GetRecordCount() const;
+
+	private:
+		std::vector<uint8_t> buffer;
+		size_t recordCount{ 0 };
+		bool delta{ false };
+		// Counters in the previous snapshot and in the current one, indexed by
+		// record type and then by id and SSRC.
+		std::unordered_map<uint64_t, Counters> previousCounters[3];
+		std::unordered_map<uint64_t, Counters> currentCounters[3];
+	};
+
+	/* Inline instance methods. */
+
+	inline const uint8_t* StatsSnapshot::GetData() const
+	{
+		return this->buffer.data();
+	}
+
+	inline size_t StatsSnapshot::GetSize() const
+	{
+		return this->buffer.size();
+	}
+
+	inline size_t StatsSnapshot::GetRecordCount() const
+	{
+		return this->recordCount;
+	}
+} // namespace RTC
+
+#endif
@@ -4,6 +4,7 @@
 #include "common.hpp"
 #include "Channel/Notifier.hpp"
 #include "RTC/ConsumerListener.hpp"
+#include "RTC/CpuUsage.hpp"
 #include "RTC/ProducerListener.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/FeedbackPsAfb.hpp"
@@ -48,9 +49,11 @@ namespace RTC
 		// maps them to the corresponding ids in the room).
 		struct HeaderExtensionIds
 		{
-			uint8_t absSendTime{ 0 }; // 0 means no abs-send-time id.
-			uint8_t mid{ 0 };         // 0 means no MID id.
-			uint8_t rid{ 0 };         // 0 means no RID id.
+			uint8_t absSendTime{ 0 };          // 0 means no abs-send-time id.
+			uint8_t mid{ 0 };                  // 0 means no MID id.
+			uint8_t rid{ 0 };                  // 0 means no RID id.
+			uint8_t frameMarking{ 0 };         // 0 means no frame-marking id.
+			uint8_t dependencyDescriptor{ 0 }; // 0 means no dependency-descriptor id.
 		};
 
 	public:
@@ -77,6 +80,9 @@ namespace RTC
 		void Destroy();
 		virtual Json::Value ToJson() const   = 0;
 		virtual Json::Value GetStats() const = 0;
+		virtual size_t GetRecvBytes() const  = 0;
+		virtual size_t GetSentBytes() const  = 0;
+		const RTC::CpuUsage& GetCpuUsage() const;
 		void HandleProducer(RTC::Producer* producer);
 		void HandleConsumer(RTC::Consumer* consumer);
 		virtual void SendRtpPacket(RTC::RtpPacket* packet)     = 0;
@@ -114,6 +120,11 @@ namespace RTC
 	public:
 		void OnConsumerClosed(RTC::Consumer* consumer) override;
 		void OnConsumerKeyFrameRequired(RTC::Consumer* consumer) override;
+		void OnConsumerRetransmissionRequired(
+		  RTC::Consumer* consumer,
+		  RTC::RtpEncodingParameters::Profile profile,
+		  const std::vector<uint16_t>& seqs) override;
+		void OnConsumerRtpPacketRetransmitted(RTC::Consumer* consumer, uint64_t latency) override;
 
 		/* Pure virtual methods inherited from Timer::Listener. */
 	public:
@@ -148,7 +159,16 @@ namespace RTC
 		struct sockaddr_storage mirrorAddrStorage;
 		// Others (REMB)
 		std::tuple<uint64_t, std::vector<uint32_t>> recvRemb;
+		// Others (CPU accounting).
+		RTC::CpuUsage cpuUsage;
 	};
+
+	/* Inline instance methods. */
+
+	inline const RTC::CpuUsage& Transport::GetCpuUsage() const
+	{
+		return this->cpuUsage;
+	}
 } // namespace RTC
 
 #endif
@@ -49,6 +49,8 @@ namespace RTC
 	public:
 		Json::Value ToJson() const override;
 		Json::Value GetStats() const override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
 		RTC::DtlsTransport::Role SetRemoteDtlsParameters(
 		  RTC::DtlsTransport::Fingerprint& fingerprint, RTC::DtlsTransport::Role role);
 		void SetMaxBitrate(uint32_t bitrate);
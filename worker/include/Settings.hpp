@@ -38,6 +38,8 @@ public:
 		uint16_t rtcMaxPort{ 59999 };
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
+		std::string metricsFile;
+		uint32_t metricsInterval{ 1000 };
 		// Private fields.
 		bool hasIPv4{ false };
 		bool hasIPv6{ false };
@@ -0,0 +1,114 @@
+#ifndef MS_SHARED_METRICS_HPP
+#define MS_SHARED_METRICS_HPP
+
+#include "common.hpp"
+#include "RTC/StatsSnapshot.hpp"
+#include "handles/Timer.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+
+/* Shared metrics region (a memory mapped file).
+ *
+ * Header (64 bytes, host byte order since it is only readable in this host):
+
+     0                   1                   2                   3
+     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                         magic ("MSMR")                        |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                            version                            |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                           sequence                            |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                           capacity                            |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                             size                              |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                             flags                             |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                      loop lag (µs, 64 bits)                   |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    |                             ...                               |
+    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+ * The header is followed by a RTC::StatsSnapshot of the whole worker (in
+ * network byte order) of the given size.
+ *
+ * The region is updated as a seqlock: the sequence is odd while the writer is
+ * updating it, so readers must copy what they need and retry if the sequence
+ * was odd or changed meanwhile.
+ */
+
+class SharedMetrics : public Timer::Listener
+{
+public:
+	static constexpr uint32_t Magic{ 0x4D534D52 }; // "MSMR".
+	static constexpr uint32_t Version{ 1 };
+	static constexpr size_t HeaderSize{ 64 };
+	// Enough for more than 87000 records.
+	static constexpr size_t Capacity{ 4 * 1024 * 1024 };
+	// Flag set when the snapshot did not fit and records were left out.
+	static constexpr uint32_t FlagTruncated{ 0x01 };
+
+public:
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		std::atomic<uint32_t> sequence;
+		uint32_t capacity;
+		uint32_t size;
+		uint32_t flags;
+		uint64_t loopLag;
+	};
+
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnSharedMetricsCollect(
+		  SharedMetrics* sharedMetrics, RTC::StatsSnapshot& snapshot, uint64_t now) = 0;
+	};
+
+public:
+	static bool Read(const uint8_t* region, std::vector<uint8_t>& snapshot, uint64_t& loopLag);
+
+public:
+	SharedMetrics(Listener* listener, const std::string& path, uint64_t interval);
+	~SharedMetrics() override;
+
+public:
+	void Publish();
+	uint32_t GetSequence() const;
+
+	/* Pure virtual methods inherited from Timer::Listener. */
+public:
+	void OnTimer(Timer* timer) override;
+
+private:
+	// Passed by argument.
+	Listener* listener{ nullptr };
+	std::string path;
+	uint64_t interval{ 0 };
+	// Allocated by this.
+	Timer* timer{ nullptr };
+	// Others.
+	int fd{ -1 };
+	uint8_t* region{ nullptr };
+	RTC::StatsSnapshot snapshot;
+	uint64_t lastTick{ 0 };
+	uint64_t loopLag{ 0 };
+};
+
+/* Inline instance methods. */
+
+inline uint32_t SharedMetrics::GetSequence() const
+{
+	return reinterpret_cast<const Header*>(this->region)->sequence.load(std::memory_order_acquire);
+}
+
+#endif
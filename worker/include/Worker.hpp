@@ -5,13 +5,17 @@
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
 #include "Channel/UnixStreamSocket.hpp"
+#include "SharedMetrics.hpp"
 #include "RTC/Router.hpp"
 #include "handles/SignalsHandler.hpp"
+#include "handles/Timer.hpp"
 #include <unordered_map>
 
 class Worker : public SignalsHandler::Listener,
                public Channel::UnixStreamSocket::Listener,
-               public RTC::Router::Listener
+               public RTC::Router::Listener,
+               public SharedMetrics::Listener,
+               public Timer::Listener
 {
 public:
 	explicit Worker(Channel::UnixStreamSocket* channel);
@@ -34,12 +38,23 @@ public:
 public:
 	void OnRouterClosed(RTC::Router* router) override;
 
+	/* Methods inherited from SharedMetrics::Listener. */
+public:
+	void OnSharedMetricsCollect(
+	  SharedMetrics* sharedMetrics, RTC::StatsSnapshot& snapshot, uint64_t now) override;
+
+	/* Methods inherited from Timer::Listener. */
+public:
+	void OnTimer(Timer* timer) override;
+
 private:
 	// Passed by argument.
 	Channel::UnixStreamSocket* channel{ nullptr };
 	// Allocated by this.
 	Channel::Notifier* notifier{ nullptr };
 	SignalsHandler* signalsHandler{ nullptr };
+	SharedMetrics* sharedMetrics{ nullptr };
+	Timer* loopMetricsTimer{ nullptr };
 	// Others.
 	bool closed{ false };
 	std::unordered_map<uint32_t, RTC::Router*> routers;
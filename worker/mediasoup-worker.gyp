@@ -16,21 +16,36 @@
       'src/DepLibUV.cpp',
       'src/DepOpenSSL.cpp',
       'src/Logger.cpp',
+      'src/LoopMetrics.cpp',
       'src/Settings.cpp',
+      'src/SharedMetrics.cpp',
       'src/Worker.cpp',
+      'src/Channel/BinaryCodec.cpp',
       'src/Channel/Notifier.cpp',
       'src/Channel/Request.cpp',
       'src/Channel/UnixStreamSocket.cpp',
+      'src/RTC/ActiveSpeakerDetector.cpp',
+      'src/RTC/AudioTopK.cpp',
       'src/RTC/Consumer.cpp',
+      'src/RTC/CpuUsage.cpp',
       'src/RTC/DtlsTransport.cpp',
+      'src/RTC/FlexFec.cpp',
       'src/RTC/IceCandidate.cpp',
       'src/RTC/IceServer.cpp',
+      'src/RTC/KeyFrameCache.cpp',
+      'src/RTC/KeyFrameRequestManager.cpp',
+      'src/RTC/LastN.cpp',
+      'src/RTC/LatencyHistogram.cpp',
       'src/RTC/NackGenerator.cpp',
+      'src/RTC/PacketLatency.cpp',
       'src/RTC/PlainRtpTransport.cpp',
       'src/RTC/Producer.cpp',
+      'src/RTC/RedEncoder.cpp',
+      'src/RTC/RetransmissionBudget.cpp',
       'src/RTC/Router.cpp',
       'src/RTC/RtpListener.cpp',
       'src/RTC/RtpMonitor.cpp',
+      'src/RTC/RtpParametersCache.cpp',
       'src/RTC/RtpPacket.cpp',
       'src/RTC/RtpStream.cpp',
       'src/RTC/RtpStreamRecv.cpp',
@@ -38,6 +53,7 @@
       'src/RTC/RtpDataCounter.cpp',
       'src/RTC/SeqManager.cpp',
       'src/RTC/SrtpSession.cpp',
+      'src/RTC/StatsSnapshot.cpp',
       'src/RTC/StunMessage.cpp',
       'src/RTC/TcpConnection.cpp',
       'src/RTC/TcpServer.cpp',
@@ -46,8 +62,10 @@
       'src/RTC/UdpSocket.cpp',
       'src/RTC/WebRtcTransport.cpp',
       'src/RTC/Codecs/Codecs.cpp',
+      'src/RTC/Codecs/AV1.cpp',
       'src/RTC/Codecs/H264.cpp',
       'src/RTC/Codecs/VP8.cpp',
+      'src/RTC/Codecs/VP9.cpp',
       'src/RTC/RtpDictionaries/Media.cpp',
       'src/RTC/RtpDictionaries/Parameters.cpp',
       'src/RTC/RtpDictionaries/RtcpFeedback.cpp',
@@ -104,28 +122,43 @@
       'include/DepOpenSSL.hpp',
       'include/LogLevel.hpp',
       'include/Logger.hpp',
+      'include/LoopMetrics.hpp',
       'include/MediaSoupError.hpp',
       'include/Settings.hpp',
+      'include/SharedMetrics.hpp',
       'include/Utils.hpp',
       'include/Worker.hpp',
       'include/common.hpp',
+      'include/Channel/BinaryCodec.hpp',
       'include/Channel/Notifier.hpp',
       'include/Channel/Request.hpp',
       'include/Channel/UnixStreamSocket.hpp',
+      'include/RTC/ActiveSpeakerDetector.hpp',
+      'include/RTC/AudioTopK.hpp',
       'include/RTC/Consumer.hpp',
       'include/RTC/ConsumerListener.hpp',
+      'include/RTC/CpuUsage.hpp',
       'include/RTC/DtlsTransport.hpp',
+      'include/RTC/FlexFec.hpp',
       'include/RTC/IceCandidate.hpp',
       'include/RTC/IceServer.hpp',
+      'include/RTC/KeyFrameCache.hpp',
+      'include/RTC/KeyFrameRequestManager.hpp',
+      'include/RTC/LastN.hpp',
+      'include/RTC/LatencyHistogram.hpp',
       'include/RTC/NackGenerator.hpp',
+      'include/RTC/PacketLatency.hpp',
       'include/RTC/Parameters.hpp',
       'include/RTC/PlainRtpTransport.hpp',
       'include/RTC/Producer.hpp',
       'include/RTC/ProducerListener.hpp',
+      'include/RTC/RedEncoder.hpp',
+      'include/RTC/RetransmissionBudget.hpp',
       'include/RTC/Router.hpp',
       'include/RTC/RtpDictionaries.hpp',
       'include/RTC/RtpListener.hpp',
       'include/RTC/RtpMonitor.hpp',
+      'include/RTC/RtpParametersCache.hpp',
       'include/RTC/RtpPacket.hpp',
       'include/RTC/RtpStream.hpp',
       'include/RTC/RtpStreamRecv.hpp',
@@ -133,6 +166,7 @@
       'include/RTC/RtpDataCounter.hpp',
       'include/RTC/SeqManager.hpp',
       'include/RTC/SrtpSession.hpp',
+      'include/RTC/StatsSnapshot.hpp',
       'include/RTC/StunMessage.hpp',
       'include/RTC/TcpConnection.hpp',
       'include/RTC/TcpServer.hpp',
@@ -142,8 +176,10 @@
       'include/RTC/WebRtcTransport.hpp',
       'include/RTC/Codecs/Codecs.hpp',
       'include/RTC/Codecs/PayloadDescriptorHandler.hpp',
+      'include/RTC/Codecs/AV1.hpp',
       'include/RTC/Codecs/H264.hpp',
       'include/RTC/Codecs/VP8.hpp',
+      'include/RTC/Codecs/VP9.hpp',
       'include/RTC/RTCP/Packet.hpp',
       'include/RTC/RTCP/CompoundPacket.hpp',
       'include/RTC/RTCP/SenderReport.hpp',
@@ -266,14 +302,37 @@
       [
         # C++ source files
         'test/tests.cpp',
+        'test/TestLogger.cpp',
+        'test/TestLoopMetrics.cpp',
+        'test/TestSharedMetrics.cpp',
+        'test/Channel/TestBinaryCodec.cpp',
+        'test/Channel/TestNotifier.cpp',
+        'test/Channel/TestRequest.cpp',
         'test/RTC/TestRtpStreamSend.cpp',
+        'test/RTC/TestActiveSpeakerDetector.cpp',
+        'test/RTC/TestAudioTopK.cpp',
+        'test/RTC/TestCpuUsage.cpp',
+        'test/RTC/TestFlexFec.cpp',
+        'test/RTC/TestKeyFrameCache.cpp',
+        'test/RTC/TestKeyFrameRequestManager.cpp',
+        'test/RTC/TestLastN.cpp',
+        'test/RTC/TestLatencyHistogram.cpp',
         'test/RTC/TestNackGenerator.cpp',
+        'test/RTC/TestPacketLatency.cpp',
+        'test/RTC/TestRedEncoder.cpp',
+        'test/RTC/TestRetransmissionBudget.cpp',
         'test/RTC/TestRtpPacket.cpp',
         'test/RTC/TestRtpDataCounter.cpp',
         'test/RTC/TestRtpMonitor.cpp',
+        'test/RTC/TestRtpParametersCache.cpp',
         'test/RTC/TestRtpStreamRecv.cpp',
         'test/RTC/TestSeqManager.cpp',
+        'test/RTC/TestStatsSnapshot.cpp',
+        'test/RTC/Codecs/TestAV1.cpp',
+        'test/RTC/Codecs/TestCodecs.cpp',
+        'test/RTC/Codecs/TestH264.cpp',
         'test/RTC/Codecs/TestVP8.cpp',
+        'test/RTC/Codecs/TestVP9.cpp',
         'test/RTC/RTCP/TestFeedbackPsAfb.cpp',
         'test/RTC/RTCP/TestFeedbackPsFir.cpp',
         'test/RTC/RTCP/TestFeedbackPsLei.cpp',
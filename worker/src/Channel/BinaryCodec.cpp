@@ -0,0 +1,320 @@
+#define MS_CLASS "Channel::BinaryCodec"
+// #define MS_LOG_DEV
+
+#include "Channel/BinaryCodec.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy()
+#include <limits>  // std::numeric_limits
+
+namespace Channel
+{
+	/* Static. */
+
+	// Nesting limit when decoding (Channel messages are shallow).
+	static constexpr uint8_t MaxDepth{ 32 };
+
+	/* Class methods. */
+
+	size_t BinaryCodec::Encode(const Json::Value& value, uint8_t* buffer, size_t bufferLen)
+	{
+		MS_TRACE_STD();
+
+		size_t pos{ 0 };
+
+		if (!EncodeValue(value, buffer, bufferLen, pos))
+			return 0;
+
+		return pos;
+	}
+
+	bool BinaryCodec::Decode(const uint8_t* data, size_t len, Json::Value& value)
+	{
+		MS_TRACE_STD();
+
+		size_t pos{ 0 };
+
+		if (!DecodeValue(data, len, pos, value, 0))
+			return false;
+
+		// Trailing bytes are not allowed.
+		return pos == len;
+	}
+
+	bool BinaryCodec::EncodeValue(
+	  const Json::Value& value, uint8_t* buffer, size_t bufferLen, size_t& pos)
+	{
+		// Type byte plus the largest fixed size content.
+		if (pos + 9 > bufferLen)
+			return false;
+
+		switch (value.type())
+		{
+			case Json::nullValue:
+			{
+				buffer[pos++] = static_cast<uint8_t>(Type::NULL_VALUE);
+
+				return true;
+			}
+
+			case Json::booleanValue:
+			{
+				buffer[pos++] = static_cast<uint8_t>(value.asBool() ? Type::TRUE : Type::FALSE);
+
+				return true;
+			}
+
+			case Json::intValue:
+			case Json::uintValue:
+			{
+				if (value.isInt())
+				{
+					buffer[pos++] = static_cast<uint8_t>(Type::INT32);
+					Utils::Byte::Set4Bytes(buffer, pos, static_cast<uint32_t>(value.asInt()));
+					pos += 4;
+
+					return true;
+				}
+				else if (value.isUInt())
+				{
+					buffer[pos++] = static_cast<uint8_t>(Type::UINT32);
+					Utils::Byte::Set4Bytes(buffer, pos, value.asUInt());
+					pos += 4;
+
+					return true;
+				}
+
+				// Larger integers are sent as double (as JSON numbers are read in JS).
+			}
+			// fallthrough
+
+			case Json::realValue:
+			{
+				double number = value.asDouble();
+				uint64_t bits;
+
+				std::memcpy(&bits, &number, sizeof(bits));
+
+				buffer[pos++] = static_cast<uint8_t>(Type::DOUBLE);
+				Utils::Byte::Set8Bytes(buffer, pos, bits);
+				pos += 8;
+
+				return true;
+			}
+
+			case Json::stringValue:
+			{
+				const char* str;
+				const char* end;
+
+				value.getString(&str, &end);
+
+				auto strLen = static_cast<size_t>(end - str);
+
+				if (pos + 5 + strLen > bufferLen)
+					return false;
+
+				buffer[pos++] = static_cast<uint8_t>(Type::STRING);
+				Utils::Byte::Set4Bytes(buffer, pos, static_cast<uint32_t>(strLen));
+				pos += 4;
+				std::memcpy(buffer + pos, str, strLen);
+				pos += strLen;
+
+				return true;
+			}
+
+			case Json::arrayValue:
+			{
+				buffer[pos++] = static_cast<uint8_t>(Type::ARRAY);
+				Utils::Byte::Set4Bytes(buffer, pos, static_cast<uint32_t>(value.size()));
+				pos += 4;
+
+				for (auto& item : value)
+				{
+					if (!EncodeValue(item, buffer, bufferLen, pos))
+						return false;
+				}
+
+				return true;
+			}
+
+			case Json::objectValue:
+			{
+				buffer[pos++] = static_cast<uint8_t>(Type::OBJECT);
+				Utils::Byte::Set4Bytes(buffer, pos, static_cast<uint32_t>(value.size()));
+				pos += 4;
+
+				for (auto it = value.begin(); it != value.end(); ++it)
+				{
+					const char* key;
+					const char* end;
+
+					key = it.memberName(&end);
+
+					auto keyLen = static_cast<size_t>(end - key);
+
+					if (keyLen > std::numeric_limits<uint16_t>::max() || pos + 2 + keyLen > bufferLen)
+						return false;
+
+					Utils::Byte::Set2Bytes(buffer, pos, static_cast<uint16_t>(keyLen));
+					pos += 2;
+					std::memcpy(buffer + pos, key, keyLen);
+					pos += keyLen;
+
+					if (!EncodeValue(*it, buffer, bufferLen, pos))
+						return false;
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool BinaryCodec::DecodeValue(
+	  const uint8_t* data, size_t len, size_t& pos, Json::Value& value, uint8_t depth)
+	{
+		if (pos + 1 > len || depth > MaxDepth)
+			return false;
+
+		auto type = static_cast<Type>(data[pos++]);
+
+		switch (type)
+		{
+			case Type::NULL_VALUE:
+			{
+				value = Json::nullValue;
+
+				return true;
+			}
+
+			case Type::FALSE:
+			case Type::TRUE:
+			{
+				value = (type == Type::TRUE);
+
+				return true;
+			}
+
+			case Type::INT32:
+			case Type::UINT32:
+			{
+				if (pos + 4 > len)
+					return false;
+
+				auto number = Utils::Byte::Get4Bytes(data, pos);
+
+				pos += 4;
+
+				if (type == Type::INT32)
+					value = Json::Int{ static_cast<int32_t>(number) };
+				else
+					value = Json::UInt{ number };
+
+				return true;
+			}
+
+			case Type::DOUBLE:
+			{
+				if (pos + 8 > len)
+					return false;
+
+				uint64_t bits = Utils::Byte::Get8Bytes(data, pos);
+				double number;
+
+				std::memcpy(&number, &bits, sizeof(number));
+				pos += 8;
+
+				value = number;
+
+				return true;
+			}
+
+			case Type::STRING:
+			{
+				if (pos + 4 > len)
+					return false;
+
+				size_t strLen = Utils::Byte::Get4Bytes(data, pos);
+
+				pos += 4;
+
+				if (pos + strLen > len)
+					return false;
+
+				auto* str = reinterpret_cast<const char*>(data + pos);
+
+				value = Json::Value(str, str + strLen);
+				pos += strLen;
+
+				return true;
+			}
+
+			case Type::ARRAY:
+			{
+				if (pos + 4 > len)
+					return false;
+
+				size_t count = Utils::Byte::Get4Bytes(data, pos);
+
+				pos += 4;
+
+				// Each item takes at least 1 byte.
+				if (pos + count > len)
+					return false;
+
+				value = Json::Value(Json::arrayValue);
+
+				for (size_t i{ 0 }; i < count; ++i)
+				{
+					if (!DecodeValue(data, len, pos, value.append(Json::nullValue), depth + 1))
+						return false;
+				}
+
+				return true;
+			}
+
+			case Type::OBJECT:
+			{
+				if (pos + 4 > len)
+					return false;
+
+				size_t count = Utils::Byte::Get4Bytes(data, pos);
+
+				pos += 4;
+
+				// Each member takes at least 3 bytes.
+				if (pos + 3 * count > len)
+					return false;
+
+				value = Json::Value(Json::objectValue);
+
+				for (size_t i{ 0 }; i < count; ++i)
+				{
+					if (pos + 2 > len)
+						return false;
+
+					size_t keyLen = Utils::Byte::Get2Bytes(data, pos);
+
+					pos += 2;
+
+					if (pos + keyLen > len)
+						return false;
+
+					auto* key = reinterpret_cast<const char*>(data + pos);
+
+					pos += keyLen;
+
+					if (!DecodeValue(data, len, pos, value[std::string(key, keyLen)], depth + 1))
+						return false;
+				}
+
+				return true;
+			}
+
+			default:
+				return false;
+		}
+	}
+} // namespace Channel
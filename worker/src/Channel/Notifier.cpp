@@ -3,6 +3,7 @@
 
 #include "Channel/Notifier.hpp"
 #include "Logger.hpp"
+#include <algorithm> // std::sort(), std::min()
 
 namespace Channel
 {
@@ -11,12 +12,26 @@ namespace Channel
 	Notifier::Notifier(Channel::UnixStreamSocket* channel) : channel(channel)
 	{
 		MS_TRACE();
+
+		this->timer = new Timer(this);
+	}
+
+	Notifier::~Notifier()
+	{
+		MS_TRACE();
+
+		Flush();
+
+		this->timer->Destroy();
 	}
 
 	void Notifier::Emit(uint32_t targetId, const std::string& event)
 	{
 		MS_TRACE();
 
+		// Keep the order of the events of this target.
+		FlushTarget(targetId);
+
 		static const Json::StaticString JsonStringTargetId{ "targetId" };
 		static const Json::StaticString JsonStringEvent{ "event" };
 
@@ -32,6 +47,9 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		// Keep the order of the events of this target.
+		FlushTarget(targetId);
+
 		static const Json::StaticString JsonStringTargetId{ "targetId" };
 		static const Json::StaticString JsonStringEvent{ "event" };
 		static const Json::StaticString JsonStringData{ "data" };
@@ -50,6 +68,9 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		// Keep the order of the events of this target.
+		FlushTarget(targetId);
+
 		static const Json::StaticString JsonStringTargetId{ "targetId" };
 		static const Json::StaticString JsonStringEvent{ "event" };
 		static const Json::StaticString JsonStringBinary{ "binary" };
@@ -73,6 +94,9 @@ namespace Channel
 	{
 		MS_TRACE();
 
+		// Keep the order of the events of this target.
+		FlushTarget(targetId);
+
 		static const Json::StaticString JsonStringTargetId{ "targetId" };
 		static const Json::StaticString JsonStringEvent{ "event" };
 		static const Json::StaticString JsonStringData{ "data" };
@@ -88,4 +112,172 @@ namespace Channel
 		this->channel->Send(json);
 		this->channel->SendBinary(binaryData, binaryLen);
 	}
+
+	/**
+	 * Emit an event whose latest value is all that matters. It is sent at the end
+	 * of the current window, replacing any previous one for the same target and
+	 * event still pending.
+	 */
+	void Notifier::EmitCoalesced(uint32_t targetId, const std::string& event)
+	{
+		MS_TRACE();
+
+		AddPending(targetId, event, nullptr);
+	}
+
+	void Notifier::EmitCoalesced(uint32_t targetId, const std::string& event, Json::Value& data)
+	{
+		MS_TRACE();
+
+		AddPending(targetId, event, &data);
+	}
+
+	/**
+	 * Send the pending coalesced events (up to maxEvents if not zero) in the order
+	 * they were last updated. Several events are sent as a single message.
+	 */
+	void Notifier::Flush(size_t maxEvents)
+	{
+		MS_TRACE();
+
+		if (this->pendingEvents.empty())
+			return;
+
+		std::vector<PendingEvents::iterator> its;
+
+		its.reserve(this->pendingEvents.size());
+
+		for (auto it = this->pendingEvents.begin(); it != this->pendingEvents.end(); ++it)
+		{
+			its.push_back(it);
+		}
+
+		SendPending(its, maxEvents);
+	}
+
+	/**
+	 * Send the pending coalesced events of the given target. Their number is
+	 * bounded by the number of distinct events, so the budget is not applied.
+	 */
+	void Notifier::FlushTarget(uint32_t targetId)
+	{
+		MS_TRACE();
+
+		std::vector<PendingEvents::iterator> its;
+
+		for (auto it = this->pendingEvents.lower_bound(std::make_pair(targetId, std::string()));
+		     it != this->pendingEvents.end() && it->first.first == targetId;
+		     ++it)
+		{
+			its.push_back(it);
+		}
+
+		if (its.empty())
+			return;
+
+		SendPending(its, 0);
+	}
+
+	void Notifier::SendPending(std::vector<PendingEvents::iterator>& its, size_t maxEvents)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringTargetId{ "targetId" };
+		static const Json::StaticString JsonStringEvent{ "event" };
+		static const Json::StaticString JsonStringData{ "data" };
+
+		using Iterator = PendingEvents::iterator;
+
+		std::sort(its.begin(), its.end(), [](const Iterator& a, const Iterator& b) {
+			return a->second.sequence < b->second.sequence;
+		});
+
+		size_t count = maxEvents == 0 ? its.size() : std::min(maxEvents, its.size());
+		Json::Value jsonEvents(Json::arrayValue);
+
+		for (size_t idx{ 0 }; idx < count; ++idx)
+		{
+			auto it = its[idx];
+			Json::Value jsonEvent(Json::objectValue);
+
+			jsonEvent[JsonStringTargetId] = Json::UInt{ it->first.first };
+			jsonEvent[JsonStringEvent]    = it->first.second;
+
+			if (it->second.hasData)
+				jsonEvent[JsonStringData].swap(it->second.data);
+
+			jsonEvents.append(jsonEvent);
+
+			this->pendingEvents.erase(it);
+		}
+
+		for (Json::ArrayIndex idx{ 0 }; idx < jsonEvents.size(); idx += MaxEventsPerMessage)
+		{
+			SendEvents(
+			  jsonEvents,
+			  idx,
+			  std::min(idx + static_cast<Json::ArrayIndex>(MaxEventsPerMessage), jsonEvents.size()));
+		}
+	}
+
+	void Notifier::SendEvents(Json::Value& jsonEvents, Json::ArrayIndex begin, Json::ArrayIndex end)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringEvents{ "events" };
+
+		// A single event is sent as a regular notification.
+		if (end - begin == 1)
+		{
+			this->channel->Send(jsonEvents[begin]);
+
+			return;
+		}
+
+		Json::Value json(Json::objectValue);
+		Json::Value& jsonBatch = json[JsonStringEvents] = Json::Value(Json::arrayValue);
+
+		for (Json::ArrayIndex idx{ begin }; idx < end; ++idx)
+		{
+			jsonBatch.append(jsonEvents[idx]);
+		}
+
+		// Too big, split it.
+		if (!this->channel->Send(json))
+		{
+			Json::ArrayIndex middle = begin + ((end - begin) / 2);
+
+			SendEvents(jsonEvents, begin, middle);
+			SendEvents(jsonEvents, middle, end);
+		}
+	}
+
+	void Notifier::AddPending(uint32_t targetId, const std::string& event, Json::Value* data)
+	{
+		MS_TRACE();
+
+		auto& pendingEvent = this->pendingEvents[std::make_pair(targetId, event)];
+
+		pendingEvent.sequence = ++this->sequence;
+		pendingEvent.hasData  = data != nullptr;
+
+		if (data != nullptr)
+			pendingEvent.data = *data;
+		else
+			pendingEvent.data = Json::Value();
+
+		if (!this->timer->IsActive())
+			this->timer->Start(CoalesceWindow);
+	}
+
+	inline void Notifier::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		Flush(MaxEventsPerWindow);
+
+		// Events over the budget wait for the next window.
+		if (!this->pendingEvents.empty())
+			this->timer->Start(CoalesceWindow);
+	}
 } // namespace Channel
@@ -4,9 +4,17 @@
 #include "Channel/Request.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
+#include "Channel/UnixStreamSocket.hpp"
 
 namespace Channel
 {
+	/* Static. */
+
+	// Room kept in a batch response for the rejection of each pending request.
+	static constexpr size_t BatchRejectionSize{ 64 };
+	// Room kept in a batch response for the fields wrapping the responses.
+	static constexpr size_t BatchOverheadSize{ 128 };
+
 	/* Class variables. */
 
 	// clang-format off
@@ -15,13 +23,18 @@ namespace Channel
 		{ "worker.dump",                       Request::MethodId::WORKER_DUMP                          },
 		{ "worker.updateSettings",             Request::MethodId::WORKER_UPDATE_SETTINGS               },
 		{ "worker.createRouter",               Request::MethodId::WORKER_CREATE_ROUTER                 },
+		{ "worker.batch",                      Request::MethodId::WORKER_BATCH                         },
 		{ "router.close",                      Request::MethodId::ROUTER_CLOSE                         },
 		{ "router.dump",                       Request::MethodId::ROUTER_DUMP                          },
+		{ "router.getStats",                   Request::MethodId::ROUTER_GET_STATS                     },
 		{ "router.createWebRtcTransport",      Request::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT       },
 		{ "router.createPlainRtpTransport",    Request::MethodId::ROUTER_CREATE_PLAIN_RTP_TRANSPORT    },
 		{ "router.createProducer",             Request::MethodId::ROUTER_CREATE_PRODUCER               },
 		{ "router.createConsumer",             Request::MethodId::ROUTER_CREATE_CONSUMER               },
+		{ "router.createConsumers",            Request::MethodId::ROUTER_CREATE_CONSUMERS              },
 		{ "router.setAudioLevelsEvent",        Request::MethodId::ROUTER_SET_AUDIO_LEVELS_EVENT        },
+		{ "router.setActiveSpeakerEvent",      Request::MethodId::ROUTER_SET_ACTIVE_SPEAKER_EVENT      },
+		{ "router.setAudioTopK",               Request::MethodId::ROUTER_SET_AUDIO_TOP_K               },
 		{ "transport.close",                   Request::MethodId::TRANSPORT_CLOSE                      },
 		{ "transport.dump",                    Request::MethodId::TRANSPORT_DUMP                       },
 		{ "transport.getStats",                Request::MethodId::TRANSPORT_GET_STATS                  },
@@ -31,6 +44,7 @@ namespace Channel
 		{ "transport.changeUfragPwd",          Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD           },
 		{ "transport.startMirroring",          Request::MethodId::TRANSPORT_START_MIRRORING            },
 		{ "transport.stopMirroring",           Request::MethodId::TRANSPORT_STOP_MIRRORING             },
+		{ "transport.setLastN",                Request::MethodId::TRANSPORT_SET_LAST_N                 },
 		{ "producer.close",                    Request::MethodId::PRODUCER_CLOSE                       },
 		{ "producer.dump",                     Request::MethodId::PRODUCER_DUMP                        },
 		{ "producer.getStats",                 Request::MethodId::PRODUCER_GET_STATS                   },
@@ -45,7 +59,8 @@ namespace Channel
 		{ "consumer.resume",                   Request::MethodId::CONSUMER_RESUME                      },
 		{ "consumer.setPreferredProfile",      Request::MethodId::CONSUMER_SET_PREFERRED_PROFILE       },
 		{ "consumer.setEncodingPreferences",   Request::MethodId::CONSUMER_SET_ENCODING_PREFERENCES    },
-		{ "consumer.requestKeyFrame",          Request::MethodId::CONSUMER_REQUEST_KEY_FRAME           }
+		{ "consumer.requestKeyFrame",          Request::MethodId::CONSUMER_REQUEST_KEY_FRAME           },
+		{ "consumer.suppressComfortNoise",     Request::MethodId::CONSUMER_SUPPRESS_COMFORT_NOISE      }
 	};
 	// clang-format on
 
@@ -56,15 +71,36 @@ namespace Channel
 		MS_TRACE();
 
 		static const Json::StaticString JsonStringId{ "id" };
-		static const Json::StaticString JsonStringMethod{ "method" };
-		static const Json::StaticString JsonStringInternal{ "internal" };
-		static const Json::StaticString JsonStringData{ "data" };
 
 		if (json[JsonStringId].isUInt())
 			this->id = json[JsonStringId].asUInt();
 		else
 			MS_THROW_ERROR("json has no numeric id field");
 
+		Parse(json);
+	}
+
+	Request::Request(Channel::Request* batch, Json::Value& json)
+	  : channel(batch->channel), id(batch->id), batched(true)
+	{
+		MS_TRACE();
+
+		Parse(json);
+	}
+
+	Request::~Request()
+	{
+		MS_TRACE();
+	}
+
+	void Request::Parse(Json::Value& json)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringMethod{ "method" };
+		static const Json::StaticString JsonStringInternal{ "internal" };
+		static const Json::StaticString JsonStringData{ "data" };
+
 		if (json[JsonStringMethod].isString())
 			this->method = json[JsonStringMethod].asString();
 		else
@@ -94,11 +130,6 @@ namespace Channel
 			this->data = Json::Value(Json::objectValue);
 	}
 
-	Request::~Request()
-	{
-		MS_TRACE();
-	}
-
 	void Request::Accept()
 	{
 		MS_TRACE();
@@ -131,7 +162,52 @@ namespace Channel
 		else
 			json[JsonStringData] = emptyData;
 
-		this->channel->Send(json);
+		Reply(json);
+	}
+
+	/**
+	 * Accept the Request with binary data sent right after the response.
+	 */
+	void Request::Accept(Json::Value& data, const uint8_t* binaryData, size_t binaryLen)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringId{ "id" };
+		static const Json::StaticString JsonStringAccepted{ "accepted" };
+		static const Json::StaticString JsonStringBinary{ "binary" };
+		static const Json::StaticString JsonStringData{ "data" };
+
+		// Binary data cannot be carried within a batch response.
+		if (this->batched)
+		{
+			Reject("binary response not allowed in a batch");
+
+			return;
+		}
+
+		if (binaryLen > Channel::UnixStreamSocket::BinaryMaxSize)
+		{
+			Reject("binary data too big");
+
+			return;
+		}
+
+		MS_ASSERT(!this->replied, "Request already replied");
+
+		this->replied = true;
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringId]       = Json::UInt{ this->id };
+		json[JsonStringAccepted] = true;
+		json[JsonStringBinary]   = true;
+		json[JsonStringData]     = data;
+
+		// The binary data would be taken as the next message if sent alone.
+		if (!Send(json))
+			return;
+
+		this->channel->SendBinary(binaryData, binaryLen);
 	}
 
 	void Request::Reject(std::string& reason)
@@ -165,6 +241,100 @@ namespace Channel
 		if (reason != nullptr)
 			json[JsonStringReason] = reason;
 
-		this->channel->Send(json);
+		Reply(json);
+	}
+
+	/**
+	 * Add the response of a request within this batch. If it does not fit in
+	 * the batch response, leaving room for the rejection of the pending requests,
+	 * it is replaced with a short rejection and the batch becomes full. Requests
+	 * added once the batch is full are rejected as not run.
+	 * @param pending  Number of requests in the batch after this one.
+	 */
+	void Request::AddBatchResponse(Json::Value& jsonResponse, size_t pending)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringRejected{ "rejected" };
+		static const Json::StaticString JsonStringReason{ "reason" };
+
+		const char* reason = "batch response too large";
+
+		if (!this->batchFull)
+		{
+			size_t size = this->channel->GetEncodedSize(jsonResponse);
+
+			if (
+			  size == 0 || this->batchResponsesSize + size + (pending * BatchRejectionSize) +
+			                   BatchOverheadSize >
+			                 Channel::UnixStreamSocket::MessageMaxSize)
+			{
+				MS_WARN_DEV("batch response full [pending:%zu]", pending);
+
+				this->batchFull = true;
+				reason          = "response too large";
+			}
+			else
+			{
+				this->batchResponsesSize += size;
+				this->batchResponses.append(jsonResponse);
+
+				return;
+			}
+		}
+
+		Json::Value jsonReject(Json::objectValue);
+
+		jsonReject[JsonStringRejected] = true;
+		jsonReject[JsonStringReason]   = reason;
+
+		this->batchResponsesSize += BatchRejectionSize;
+		this->batchResponses.append(jsonReject);
+	}
+
+	void Request::Reply(Json::Value& json)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringId{ "id" };
+
+		// The reply of a batched Request is sent within the batch response.
+		if (this->batched)
+		{
+			json.removeMember(JsonStringId);
+			this->reply = json;
+
+			return;
+		}
+
+		Send(json);
+	}
+
+	/**
+	 * Send the response. If it is too big for the Channel, a short rejection is
+	 * sent instead so the Request does not remain unanswered.
+	 */
+	bool Request::Send(Json::Value& json)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringId{ "id" };
+		static const Json::StaticString JsonStringRejected{ "rejected" };
+		static const Json::StaticString JsonStringReason{ "reason" };
+
+		if (this->channel->Send(json))
+			return true;
+
+		MS_ERROR("response too large [method:%s]", this->method.c_str());
+
+		Json::Value jsonReject(Json::objectValue);
+
+		jsonReject[JsonStringId]       = Json::UInt{ this->id };
+		jsonReject[JsonStringRejected] = true;
+		jsonReject[JsonStringReason]   = "response too large";
+
+		this->channel->Send(jsonReject);
+
+		return false;
 	}
 } // namespace Channel
@@ -4,6 +4,8 @@
 #include "Channel/UnixStreamSocket.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
+#include "Utils.hpp"
+#include "Channel/BinaryCodec.hpp"
 #include <cmath>   // std::ceil()
 #include <cstdio>  // sprintf()
 #include <cstring> // std::memmove()
@@ -18,12 +20,14 @@ namespace Channel
 
 	// netstring length for a 65536 bytes payload.
 	static constexpr size_t MaxSize{ 65543 };
-	static constexpr size_t MessageMaxSize{ 65536 };
+	// Length prefix of binary messages.
+	static constexpr size_t FrameHeaderSize{ 4 };
 	static uint8_t WriteBuffer[MaxSize];
 
 	/* Instance methods. */
 
-	UnixStreamSocket::UnixStreamSocket(int fd) : ::UnixStreamSocket::UnixStreamSocket(fd, MaxSize)
+	UnixStreamSocket::UnixStreamSocket(int fd, Format format)
+	  : ::UnixStreamSocket::UnixStreamSocket(fd, MaxSize), format(format)
 	{
 		MS_TRACE_STD();
 
@@ -71,13 +75,36 @@ namespace Channel
 		this->listener = listener;
 	}
 
-	void UnixStreamSocket::Send(Json::Value& msg)
+	/**
+	 * Returns false if the message is too big to be sent.
+	 */
+	bool UnixStreamSocket::Send(Json::Value& msg)
 	{
 		if (this->closed)
-			return;
+			return true;
 
 		// MS_TRACE_STD();
 
+		// Encode the message straight into the write buffer.
+		if (this->format == Format::BINARY)
+		{
+			size_t payloadLen =
+			  BinaryCodec::Encode(msg, WriteBuffer + FrameHeaderSize, MessageMaxSize);
+
+			if (payloadLen == 0)
+			{
+				MS_ERROR_STD("mesage too big");
+
+				return false;
+			}
+
+			Utils::Byte::Set4Bytes(WriteBuffer, 0, static_cast<uint32_t>(payloadLen));
+
+			Write(WriteBuffer, FrameHeaderSize + payloadLen);
+
+			return true;
+		}
+
 		std::ostringstream stream;
 		std::string nsPayload;
 		size_t nsPayloadLen;
@@ -92,7 +119,7 @@ namespace Channel
 		{
 			MS_ERROR_STD("mesage too big");
 
-			return;
+			return false;
 		}
 
 		if (nsPayloadLen == 0)
@@ -113,6 +140,27 @@ namespace Channel
 		nsLen = nsNumLen + nsPayloadLen + 2;
 
 		Write(WriteBuffer, nsLen);
+
+		return true;
+	}
+
+	/**
+	 * Size of the message payload once encoded, or 0 if it is too big to be sent.
+	 */
+	size_t UnixStreamSocket::GetEncodedSize(Json::Value& msg)
+	{
+		MS_TRACE_STD();
+
+		if (this->format == Format::BINARY)
+			return BinaryCodec::Encode(msg, WriteBuffer + FrameHeaderSize, MessageMaxSize);
+
+		std::ostringstream stream;
+
+		this->jsonWriter->write(msg, &stream);
+
+		auto len = static_cast<size_t>(stream.tellp());
+
+		return len <= MessageMaxSize ? len : 0;
 	}
 
 	void UnixStreamSocket::SendLog(char* nsPayload, size_t nsPayloadLen)
@@ -132,6 +180,13 @@ namespace Channel
 			return;
 		}
 
+		if (this->format == Format::BINARY)
+		{
+			WriteFrame(reinterpret_cast<uint8_t*>(nsPayload), nsPayloadLen);
+
+			return;
+		}
+
 		if (nsPayloadLen == 0)
 		{
 			nsNumLen       = 1;
@@ -160,13 +215,27 @@ namespace Channel
 		size_t nsNumLen;
 		size_t nsLen;
 
-		if (nsPayloadLen > MessageMaxSize)
+		if (nsPayloadLen > BinaryMaxSize)
 		{
 			MS_ERROR_STD("mesage too big");
 
 			return;
 		}
 
+		if (nsPayloadLen > MessageMaxSize)
+		{
+			WriteLarge(nsPayload, nsPayloadLen);
+
+			return;
+		}
+
+		if (this->format == Format::BINARY)
+		{
+			WriteFrame(nsPayload, nsPayloadLen);
+
+			return;
+		}
+
 		if (nsPayloadLen == 0)
 		{
 			nsNumLen       = 1;
@@ -187,10 +256,128 @@ namespace Channel
 		Write(WriteBuffer, nsLen);
 	}
 
+	void UnixStreamSocket::WriteFrame(const uint8_t* payload, size_t payloadLen)
+	{
+		Utils::Byte::Set4Bytes(WriteBuffer, 0, static_cast<uint32_t>(payloadLen));
+		std::memcpy(WriteBuffer + FrameHeaderSize, payload, payloadLen);
+
+		Write(WriteBuffer, FrameHeaderSize + payloadLen);
+	}
+
+	void UnixStreamSocket::WriteLarge(const uint8_t* payload, size_t payloadLen)
+	{
+		// NOTE: Writes are kept in order by the underlying socket.
+		if (this->format == Format::BINARY)
+		{
+			Utils::Byte::Set4Bytes(WriteBuffer, 0, static_cast<uint32_t>(payloadLen));
+			Write(WriteBuffer, FrameHeaderSize);
+			Write(payload, payloadLen);
+		}
+		else
+		{
+			int nsNumLen = std::sprintf(reinterpret_cast<char*>(WriteBuffer), "%zu:", payloadLen);
+
+			Write(WriteBuffer, static_cast<size_t>(nsNumLen));
+			Write(payload, payloadLen);
+			Write(reinterpret_cast<const uint8_t*>(","), 1);
+		}
+	}
+
+	void UnixStreamSocket::ReadFrames()
+	{
+		MS_TRACE_STD();
+
+		// Be ready to parse more than a single message in a single TCP chunk.
+		while (this->bufferDataLen - this->msgStart >= FrameHeaderSize)
+		{
+			if (IsClosing())
+				return;
+
+			size_t readLen    = this->bufferDataLen - this->msgStart;
+			size_t payloadLen = Utils::Byte::Get4Bytes(this->buffer, this->msgStart);
+
+			if (payloadLen > MessageMaxSize)
+			{
+				MS_ERROR_STD("binary message too big, discarding all data in the buffer");
+
+				this->msgStart      = 0;
+				this->bufferDataLen = 0;
+
+				return;
+			}
+
+			// Incomplete message.
+			if (readLen < FrameHeaderSize + payloadLen)
+				break;
+
+			Json::Value json;
+
+			// Decode the message in place.
+			if (BinaryCodec::Decode(
+			      this->buffer + this->msgStart + FrameHeaderSize, payloadLen, json))
+			{
+				HandleMessage(json);
+			}
+			else
+			{
+				MS_ERROR_STD("binary message decoding error");
+			}
+
+			this->msgStart += FrameHeaderSize + payloadLen;
+		}
+
+		// Everything was read, so empty the buffer.
+		if (this->msgStart == this->bufferDataLen)
+		{
+			this->msgStart      = 0;
+			this->bufferDataLen = 0;
+		}
+		// Move the incomplete message to the beginning of a full buffer.
+		else if (this->bufferDataLen == this->bufferSize && this->msgStart != 0)
+		{
+			std::memmove(
+			  this->buffer, this->buffer + this->msgStart, this->bufferDataLen - this->msgStart);
+			this->bufferDataLen -= this->msgStart;
+			this->msgStart = 0;
+		}
+	}
+
+	void UnixStreamSocket::HandleMessage(Json::Value& json)
+	{
+		MS_TRACE_STD();
+
+		Channel::Request* request = nullptr;
+
+		try
+		{
+			request = new Channel::Request(this, json);
+		}
+		catch (const MediaSoupError& error)
+		{
+			MS_ERROR_STD("discarding wrong Channel request");
+		}
+
+		if (request != nullptr)
+		{
+			// Notify the listener.
+			this->listener->OnChannelRequest(this, request);
+
+			// Delete the Request.
+			delete request;
+		}
+	}
+
 	void UnixStreamSocket::UserOnUnixStreamRead()
 	{
 		MS_TRACE_STD();
 
+		if (this->format == Format::BINARY)
+		{
+			ReadFrames();
+
+			return;
+		}
+
 		// Be ready to parse more than a single message in a single TCP chunk.
 		while (true)
 		{
@@ -275,25 +462,7 @@ namespace Channel
 			if (this->jsonReader->parse(
 			      (const char*)jsonStart, (const char*)jsonStart + jsonLen, &json, &jsonParseError))
 			{
-				Channel::Request* request = nullptr;
-
-				try
-				{
-					request = new Channel::Request(this, json);
-				}
-				catch (const MediaSoupError& error)
-				{
-					MS_ERROR_STD("discarding wrong Channel request");
-				}
-
-				if (request != nullptr)
-				{
-					// Notify the listener.
-					this->listener->OnChannelRequest(this, request);
-
-					// Delete the Request.
-					delete request;
-				}
+				HandleMessage(json);
 			}
 			else
 			{
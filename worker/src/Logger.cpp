@@ -2,12 +2,28 @@
 // #define MS_LOG_DEV
 
 #include "Logger.hpp"
+#include "DepLibUV.hpp"
+#include <algorithm> // std::min()
+
+/* Static methods for UV callbacks. */
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	Logger::Flush();
+}
 
 /* Class variables. */
 
 std::string Logger::id{ "unset" };
 Channel::UnixStreamSocket* Logger::channel{ nullptr };
 char Logger::buffer[Logger::bufferSize];
+uint64_t Logger::droppedRecords{ 0 };
+uint8_t Logger::ring[Logger::RingSize];
+size_t Logger::ringLen{ 0 };
+uint64_t Logger::reportedDroppedRecords{ 0 };
+bool Logger::flushing{ false };
+
+static uv_check_t checkHandle;
 
 /* Class methods. */
 
@@ -16,6 +32,12 @@ void Logger::Init(const std::string& id, Channel::UnixStreamSocket* channel)
 	Logger::id      = id;
 	Logger::channel = channel;
 
+	// Drain the log ring once the I/O of every loop iteration is processed. It
+	// must not keep the loop alive.
+	uv_check_init(DepLibUV::GetLoop(), &checkHandle);
+	uv_check_start(&checkHandle, static_cast<uv_check_cb>(onCheck));
+	uv_unref(reinterpret_cast<uv_handle_t*>(&checkHandle));
+
 	MS_TRACE();
 }
 
@@ -25,3 +47,100 @@ void Logger::Init(const std::string& id)
 
 	MS_TRACE();
 }
+
+/**
+ * Send the pending records and close the check handle. Must be called while
+ * the loop is still running so the handle gets closed.
+ */
+void Logger::ClassDestroy()
+{
+	MS_TRACE();
+
+	if (Logger::channel == nullptr)
+		return;
+
+	Logger::Flush();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(&checkHandle), nullptr);
+}
+
+/**
+ * Whether the given call site can log now.
+ */
+bool Logger::Admit(CallSite& callSite)
+{
+	uint64_t now = DepLibUV::GetTime();
+
+	if (now - callSite.windowStart >= 1000)
+	{
+		callSite.windowStart = now;
+		callSite.count       = 0;
+	}
+
+	if (callSite.count >= MaxRecordsPerSecond)
+	{
+		Logger::droppedRecords++;
+
+		return false;
+	}
+
+	callSite.count++;
+
+	return true;
+}
+
+/**
+ * Format and send every record in the log ring.
+ */
+void Logger::Flush()
+{
+	// Errors logged while sending the records must not flush them again.
+	if (Logger::channel == nullptr || Logger::flushing)
+		return;
+
+	Logger::flushing = true;
+
+	size_t offset{ 0 };
+
+	while (offset < Logger::ringLen)
+	{
+		const uint8_t* data = Logger::ring + offset;
+		const uint8_t* args = data + sizeof(size_t) + sizeof(Formatter) + sizeof(const char*);
+		size_t size;
+		Formatter formatter;
+		const char* format;
+
+		std::memcpy(&size, data, sizeof(size_t));
+		std::memcpy(&formatter, data + sizeof(size_t), sizeof(Formatter));
+		std::memcpy(&format, data + sizeof(size_t) + sizeof(Formatter), sizeof(const char*));
+
+		int loggerWritten = formatter(args, format);
+
+		if (loggerWritten > 0)
+		{
+			Logger::channel->SendLog(
+			  Logger::buffer,
+			  std::min(static_cast<size_t>(loggerWritten), Logger::bufferSize - 1));
+		}
+
+		offset += size;
+	}
+
+	Logger::ringLen = 0;
+
+	if (Logger::droppedRecords != Logger::reportedDroppedRecords)
+	{
+		int loggerWritten = std::snprintf(
+		  Logger::buffer,
+		  Logger::bufferSize,
+		  "W" _MS_LOG_STR_DESC "%" PRIu64 " log records dropped",
+		  _MS_LOG_ARG,
+		  Logger::droppedRecords - Logger::reportedDroppedRecords);
+
+		Logger::channel->SendLog(Logger::buffer, loggerWritten);
+
+		Logger::reportedDroppedRecords = Logger::droppedRecords;
+	}
+
+	Logger::flushing = false;
+}
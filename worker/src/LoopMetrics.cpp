@@ -0,0 +1,199 @@
+#define MS_CLASS "LoopMetrics"
+// #define MS_LOG_DEV
+
+#include "LoopMetrics.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+
+/* Static methods for UV callbacks. */
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	LoopMetrics::OnUvPrepare();
+}
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	LoopMetrics::OnUvCheck();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Class variables. */
+
+uv_prepare_t* LoopMetrics::prepareHandle{ nullptr };
+uv_check_t* LoopMetrics::checkHandle{ nullptr };
+uint64_t LoopMetrics::iterationStartTime{ 0 };
+uint64_t LoopMetrics::iterationIdleTime{ 0 };
+uint64_t LoopMetrics::handlerTime[LoopMetrics::NumCategories]{ 0 };
+LoopMetrics::Counters LoopMetrics::total;
+LoopMetrics::Counters LoopMetrics::window;
+
+/* Class methods. */
+
+void LoopMetrics::ClassInit()
+{
+	MS_TRACE();
+
+	int err;
+
+	LoopMetrics::prepareHandle = new uv_prepare_t;
+	LoopMetrics::checkHandle   = new uv_check_t;
+
+	err = uv_prepare_init(DepLibUV::GetLoop(), LoopMetrics::prepareHandle);
+	if (err != 0)
+		MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+
+	err = uv_check_init(DepLibUV::GetLoop(), LoopMetrics::checkHandle);
+	if (err != 0)
+		MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+
+	uv_prepare_start(LoopMetrics::prepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+	uv_check_start(LoopMetrics::checkHandle, static_cast<uv_check_cb>(onCheck));
+
+	// They must not keep the loop alive.
+	uv_unref(reinterpret_cast<uv_handle_t*>(LoopMetrics::prepareHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(LoopMetrics::checkHandle));
+}
+
+/**
+ * Must be called while the loop is still running so the handles get closed.
+ */
+void LoopMetrics::ClassDestroy()
+{
+	MS_TRACE();
+
+	if (LoopMetrics::prepareHandle != nullptr)
+	{
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(LoopMetrics::prepareHandle),
+		  static_cast<uv_close_cb>(onClose));
+	}
+
+	if (LoopMetrics::checkHandle != nullptr)
+	{
+		uv_close(
+		  reinterpret_cast<uv_handle_t*>(LoopMetrics::checkHandle), static_cast<uv_close_cb>(onClose));
+	}
+
+	LoopMetrics::prepareHandle = nullptr;
+	LoopMetrics::checkHandle   = nullptr;
+}
+
+Json::Value LoopMetrics::ToJson()
+{
+	MS_TRACE();
+
+	return ToJson(LoopMetrics::total);
+}
+
+/**
+ * Metrics since the previous call.
+ */
+Json::Value LoopMetrics::TakeWindow()
+{
+	MS_TRACE();
+
+	Json::Value json = ToJson(LoopMetrics::window);
+
+	LoopMetrics::window = Counters();
+
+	return json;
+}
+
+Json::Value LoopMetrics::ToJson(const Counters& counters)
+{
+	MS_TRACE();
+
+	static const Json::StaticString JsonStringIterations{ "iterations" };
+	static const Json::StaticString JsonStringUtilization{ "utilization" };
+	static const Json::StaticString JsonStringBusyTime{ "busyTime" };
+	static const Json::StaticString JsonStringIdleTime{ "idleTime" };
+	static const Json::StaticString JsonStringHandlerTime{ "handlerTime" };
+	static const Json::StaticString JsonStringUdp{ "udp" };
+	static const Json::StaticString JsonStringTcp{ "tcp" };
+	static const Json::StaticString JsonStringChannel{ "channel" };
+	static const Json::StaticString JsonStringTimer{ "timer" };
+	static const Json::StaticString JsonStringLag{ "lag" };
+
+	Json::Value json(Json::objectValue);
+	Json::Value jsonHandlerTime(Json::objectValue);
+	uint64_t time = counters.busyTime + counters.idleTime;
+
+	// Times in microseconds.
+	json[JsonStringIterations] = Json::UInt64{ counters.iterations };
+	json[JsonStringUtilization] =
+	  time != 0 ? static_cast<double>(counters.busyTime) / static_cast<double>(time) : 0.0;
+	json[JsonStringBusyTime] = Json::UInt64{ counters.busyTime / 1000 };
+	json[JsonStringIdleTime] = Json::UInt64{ counters.idleTime / 1000 };
+
+	jsonHandlerTime[JsonStringUdp] =
+	  Json::UInt64{ counters.handlerTime[static_cast<size_t>(Category::UDP)] / 1000 };
+	jsonHandlerTime[JsonStringTcp] =
+	  Json::UInt64{ counters.handlerTime[static_cast<size_t>(Category::TCP)] / 1000 };
+	jsonHandlerTime[JsonStringChannel] =
+	  Json::UInt64{ counters.handlerTime[static_cast<size_t>(Category::CHANNEL)] / 1000 };
+	jsonHandlerTime[JsonStringTimer] =
+	  Json::UInt64{ counters.handlerTime[static_cast<size_t>(Category::TIMER)] / 1000 };
+
+	json[JsonStringHandlerTime] = jsonHandlerTime;
+	json[JsonStringLag]         = counters.lag.ToJson();
+
+	return json;
+}
+
+/**
+ * Called right before the loop blocks waiting for I/O. An iteration ends here.
+ */
+void LoopMetrics::OnUvPrepare()
+{
+	uint64_t now = uv_hrtime();
+
+	if (LoopMetrics::iterationStartTime != 0)
+	{
+		uint64_t iterationTime = now - LoopMetrics::iterationStartTime;
+		uint64_t busyTime      = iterationTime - LoopMetrics::iterationIdleTime;
+
+		for (auto* counters : { &LoopMetrics::total, &LoopMetrics::window })
+		{
+			counters->iterations++;
+			counters->busyTime += busyTime;
+			counters->idleTime += LoopMetrics::iterationIdleTime;
+			counters->lag.Add(busyTime / 1000);
+
+			for (size_t idx{ 0 }; idx < NumCategories; ++idx)
+			{
+				counters->handlerTime[idx] += LoopMetrics::handlerTime[idx];
+			}
+		}
+	}
+
+	for (size_t idx{ 0 }; idx < NumCategories; ++idx)
+	{
+		LoopMetrics::handlerTime[idx] = 0;
+	}
+
+	LoopMetrics::iterationStartTime = now;
+	LoopMetrics::iterationIdleTime  = 0;
+}
+
+/**
+ * Called once the poll phase has run the I/O callbacks. What is not spent in
+ * them since the prepare phase is idle time.
+ */
+void LoopMetrics::OnUvCheck()
+{
+	uint64_t pollTime = uv_hrtime() - LoopMetrics::iterationStartTime;
+	uint64_t pollHandlerTime{ 0 };
+
+	for (size_t idx{ 0 }; idx < NumCategories; ++idx)
+	{
+		pollHandlerTime += LoopMetrics::handlerTime[idx];
+	}
+
+	LoopMetrics::iterationIdleTime = pollTime > pollHandlerTime ? pollTime - pollHandlerTime : 0;
+}
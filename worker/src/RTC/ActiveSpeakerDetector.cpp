@@ -0,0 +1,119 @@
+#define MS_CLASS "RTC::ActiveSpeakerDetector"
+// #define MS_LOG_DEV
+
+#include "RTC/ActiveSpeakerDetector.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	ActiveSpeakerDetector::ActiveSpeakerDetector(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+	}
+
+	/**
+	 * Account an audio level (0 means 0 dBov, 127 means -127 dBov) received
+	 * from the given Producer.
+	 */
+	void ActiveSpeakerDetector::ReceiveAudioLevel(uint32_t producerId, uint8_t volume)
+	{
+		MS_TRACE();
+
+		auto& speaker = this->speakers[producerId];
+
+		if (volume > 127)
+			volume = 127;
+
+		speaker.intervalEnergySum += 127 - volume;
+		speaker.intervalCount++;
+	}
+
+	void ActiveSpeakerDetector::RemoveProducer(uint32_t producerId)
+	{
+		MS_TRACE();
+
+		this->speakers.erase(producerId);
+
+		if (this->hasActiveSpeaker && this->activeSpeaker == producerId)
+		{
+			this->hasActiveSpeaker = false;
+			this->activeSpeaker    = 0;
+
+			this->listener->OnActiveSpeakerLost(this);
+		}
+	}
+
+	/**
+	 * Must be called once per interval. Closes the current interval of every
+	 * Producer and updates the dominant speaker.
+	 */
+	void ActiveSpeakerDetector::Process()
+	{
+		MS_TRACE();
+
+		bool hasCandidate{ false };
+		uint32_t candidate{ 0 };
+		uint8_t candidateEnergy{ 0 };
+		uint8_t activeEnergy{ 0 };
+
+		for (auto& kv : this->speakers)
+		{
+			auto producerId = kv.first;
+			auto& speaker   = kv.second;
+			uint8_t energy{ 0 };
+
+			// No levels in this interval means silence.
+			if (speaker.intervalCount != 0)
+				energy = static_cast<uint8_t>(speaker.intervalEnergySum / speaker.intervalCount);
+
+			speaker.energiesSum -= speaker.energies[speaker.energiesIdx];
+			speaker.energiesSum += energy;
+			speaker.energies[speaker.energiesIdx] = energy;
+			speaker.energiesIdx                   = (speaker.energiesIdx + 1) % RingSize;
+			speaker.intervalEnergySum             = 0;
+			speaker.intervalCount                 = 0;
+
+			auto windowEnergy = GetEnergy(speaker);
+
+			if (this->hasActiveSpeaker && producerId == this->activeSpeaker)
+				activeEnergy = windowEnergy;
+
+			if (windowEnergy < MinEnergy)
+				continue;
+
+			if (!hasCandidate || windowEnergy > candidateEnergy)
+			{
+				hasCandidate    = true;
+				candidate       = producerId;
+				candidateEnergy = windowEnergy;
+			}
+		}
+
+		// Nobody is speaking, keep the current active speaker.
+		if (!hasCandidate)
+			return;
+
+		if (this->hasActiveSpeaker)
+		{
+			if (candidate == this->activeSpeaker)
+				return;
+
+			// The current active speaker is still speaking and the candidate is not
+			// loud enough to replace it.
+			if (activeEnergy >= MinEnergy && candidateEnergy < activeEnergy + this->hysteresis)
+				return;
+		}
+
+		MS_DEBUG_DEV(
+		  "active speaker changed [producerId:%" PRIu32 ", energy:%" PRIu8 "]",
+		  candidate,
+		  candidateEnergy);
+
+		this->hasActiveSpeaker = true;
+		this->activeSpeaker    = candidate;
+
+		this->listener->OnActiveSpeakerChanged(this, candidate);
+	}
+} // namespace RTC
@@ -0,0 +1,104 @@
+#define MS_CLASS "RTC::AudioTopK"
+// #define MS_LOG_DEV
+
+#include "RTC/AudioTopK.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::find()
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	void AudioTopK::SetK(uint32_t k)
+	{
+		MS_TRACE();
+
+		this->k = k;
+		this->activities.clear();
+		this->forwardedProducers.clear();
+	}
+
+	bool AudioTopK::Update(uint32_t producerId, uint8_t energy, uint64_t now, bool& added)
+	{
+		MS_TRACE();
+
+		added = false;
+
+		auto& activity = this->activities[producerId];
+
+		activity.energy         = activity.energy - (activity.energy / Smoothing) + energy;
+		activity.lastPacketTime = now;
+
+		if (activity.forwarded)
+			return true;
+
+		if (this->forwardedProducers.size() < this->k)
+		{
+			this->forwardedProducers.push_back(producerId);
+		}
+		else
+		{
+			// Replace an inactive forwarded Producer or, otherwise, the quietest one
+			// if loud enough.
+			Activity* replacedActivity{ nullptr };
+			size_t replacedIdx{ 0 };
+
+			for (size_t idx{ 0 }; idx < this->forwardedProducers.size(); ++idx)
+			{
+				auto& forwardedActivity = this->activities[this->forwardedProducers[idx]];
+
+				if (now - forwardedActivity.lastPacketTime >= InactivityTimeout)
+				{
+					replacedActivity = &forwardedActivity;
+					replacedIdx      = idx;
+
+					break;
+				}
+
+				if (replacedActivity == nullptr || forwardedActivity.energy < replacedActivity->energy)
+				{
+					replacedActivity = &forwardedActivity;
+					replacedIdx      = idx;
+				}
+			}
+
+			if (replacedActivity == nullptr)
+				return false;
+
+			bool inactive = now - replacedActivity->lastPacketTime >= InactivityTimeout;
+
+			if (!inactive && activity.energy <= replacedActivity->energy + Hysteresis * Smoothing)
+				return false;
+
+			replacedActivity->forwarded            = false;
+			this->forwardedProducers[replacedIdx] = producerId;
+		}
+
+		activity.forwarded = true;
+		added              = true;
+
+		return true;
+	}
+
+	bool AudioTopK::IsForwarded(uint32_t producerId) const
+	{
+		MS_TRACE();
+
+		auto it = this->activities.find(producerId);
+
+		return it != this->activities.end() && it->second.forwarded;
+	}
+
+	void AudioTopK::Remove(uint32_t producerId)
+	{
+		MS_TRACE();
+
+		this->activities.erase(producerId);
+
+		auto it =
+		  std::find(this->forwardedProducers.begin(), this->forwardedProducers.end(), producerId);
+
+		if (it != this->forwardedProducers.end())
+			this->forwardedProducers.erase(it);
+	}
+} // namespace RTC
@@ -0,0 +1,432 @@
+#define MS_CLASS "RTC::Codecs::AV1"
+// #define MS_LOG_DEV
+
+#include "RTC/Codecs/AV1.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Static. */
+
+		// Maximum number of frame dependency templates (the template id has 6 bits).
+		static constexpr size_t MaxTemplates{ 64 };
+
+		// Read 'count' bits (up to 32) starting at 'bitOffset'.
+		static bool ReadBits(
+		  const uint8_t* data, size_t len, size_t& bitOffset, uint8_t count, uint32_t& value)
+		{
+			if (bitOffset + count > len * 8)
+				return false;
+
+			value = 0;
+
+			for (uint8_t i = 0; i < count; ++i, ++bitOffset)
+			{
+				value = (value << 1) | ((data[bitOffset / 8] >> (7 - (bitOffset % 8))) & 0x01);
+			}
+
+			return true;
+		}
+
+		// Read a non-symmetric unsigned value in the range [0, n).
+		static bool ReadNonSymmetric(
+		  const uint8_t* data, size_t len, size_t& bitOffset, uint32_t n, uint32_t& value)
+		{
+			uint8_t width{ 0 };
+
+			for (uint32_t x = n; x != 0; x >>= 1)
+			{
+				width++;
+			}
+
+			uint32_t m = (1u << width) - n;
+
+			if (width == 0 || !ReadBits(data, len, bitOffset, width - 1, value))
+				return false;
+
+			if (value < m)
+				return true;
+
+			uint32_t extraBit;
+
+			if (!ReadBits(data, len, bitOffset, 1, extraBit))
+				return false;
+
+			value = (value << 1) - m + extraBit;
+
+			return true;
+		}
+
+		static bool SkipBits(size_t len, size_t& bitOffset, size_t count)
+		{
+			if (bitOffset + count > len * 8)
+				return false;
+
+			bitOffset += count;
+
+			return true;
+		}
+
+		/* Class methods. */
+
+		AV1::PayloadDescriptor* AV1::Parse(
+		  uint8_t* data,
+		  size_t len,
+		  const uint8_t* dependencyDescriptor,
+		  size_t dependencyDescriptorLen,
+		  DecodingContext* context)
+		{
+			MS_TRACE();
+
+			if (len < 1)
+				return nullptr;
+
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			// Mandatory fields are unknown without dependency descriptor.
+			payloadDescriptor->startOfFrame = 0;
+			payloadDescriptor->endOfFrame   = 0;
+			payloadDescriptor->templateId   = 0;
+			payloadDescriptor->frameNumber  = 0;
+
+			// N bit: first packet of a coded video sequence.
+			if ((data[0] >> 3) & 0x01)
+				payloadDescriptor->isKeyFrame = true;
+
+			if (!dependencyDescriptor || dependencyDescriptorLen < 3)
+				return payloadDescriptor.release();
+
+			const uint8_t* dd = dependencyDescriptor;
+			size_t ddLen      = dependencyDescriptorLen;
+
+			payloadDescriptor->startOfFrame = (dd[0] >> 7) & 0x01;
+			payloadDescriptor->endOfFrame   = (dd[0] >> 6) & 0x01;
+			payloadDescriptor->templateId   = dd[0] & 0x3F;
+			payloadDescriptor->frameNumber  = Utils::Byte::Get2Bytes(dd, 1);
+
+			// Without a per stream context just the structure in this packet is usable.
+			DecodingContext localContext;
+
+			if (!context)
+				context = &localContext;
+
+			bool hasCustomFdiffs{ false };
+			uint8_t fdiffCount{ 0 };
+
+			// Extended descriptor fields.
+			if (ddLen > 3)
+			{
+				size_t bitOffset = 24;
+				uint32_t flags;
+
+				if (!ReadBits(dd, ddLen, bitOffset, 5, flags))
+					return payloadDescriptor.release();
+
+				bool hasStructureFlag     = (flags >> 4) & 0x01;
+				bool hasActiveDecodeTargs = (flags >> 3) & 0x01;
+				bool hasCustomDtis        = (flags >> 2) & 0x01;
+
+				hasCustomFdiffs = (flags >> 1) & 0x01;
+
+				if (hasStructureFlag)
+				{
+					if (!ParseStructure(dd, ddLen, bitOffset, context))
+					{
+						MS_WARN_DEV("invalid template dependency structure");
+
+						context->hasStructure = false;
+
+						return payloadDescriptor.release();
+					}
+
+					payloadDescriptor->hasStructure = true;
+				}
+
+				if (!context->hasStructure)
+					return payloadDescriptor.release();
+
+				// active_decode_targets_bitmask and frame_dtis are not needed.
+				if (hasActiveDecodeTargs && !SkipBits(ddLen, bitOffset, context->decodeTargetCount))
+					return payloadDescriptor.release();
+
+				if (hasCustomDtis && !SkipBits(ddLen, bitOffset, 2 * context->decodeTargetCount))
+					return payloadDescriptor.release();
+
+				if (hasCustomFdiffs)
+				{
+					uint32_t fdiffSize;
+
+					if (!ReadBits(dd, ddLen, bitOffset, 2, fdiffSize))
+						return payloadDescriptor.release();
+
+					while (fdiffSize != 0)
+					{
+						fdiffCount++;
+
+						if (
+						  !SkipBits(ddLen, bitOffset, 4 * fdiffSize) ||
+						  !ReadBits(dd, ddLen, bitOffset, 2, fdiffSize))
+						{
+							return payloadDescriptor.release();
+						}
+					}
+				}
+			}
+
+			if (!context->hasStructure)
+				return payloadDescriptor.release();
+
+			size_t templateIndex =
+			  (payloadDescriptor->templateId + MaxTemplates - context->templateIdOffset) % MaxTemplates;
+
+			if (templateIndex >= context->templates.size())
+			{
+				MS_WARN_DEV(
+				  "unknown frame dependency template [id:%" PRIu8 "]", payloadDescriptor->templateId);
+
+				return payloadDescriptor.release();
+			}
+
+			auto& frameTemplate = context->templates[templateIndex];
+
+			payloadDescriptor->spatialLayer  = frameTemplate.spatialLayer;
+			payloadDescriptor->temporalLayer = frameTemplate.temporalLayer;
+			payloadDescriptor->hasLayers     = true;
+
+			if (!hasCustomFdiffs)
+				fdiffCount = frameTemplate.fdiffCount;
+
+			// A base spatial layer frame carrying the structure and referencing no
+			// other frame is a key frame.
+			if (
+			  payloadDescriptor->hasStructure && payloadDescriptor->startOfFrame &&
+			  payloadDescriptor->spatialLayer == 0 && fdiffCount == 0)
+			{
+				payloadDescriptor->isKeyFrame = true;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		bool AV1::ParseStructure(
+		  const uint8_t* data, size_t len, size_t& bitOffset, DecodingContext* context)
+		{
+			MS_TRACE();
+
+			uint32_t templateIdOffset;
+			uint32_t decodeTargetCountMinusOne;
+
+			if (
+			  !ReadBits(data, len, bitOffset, 6, templateIdOffset) ||
+			  !ReadBits(data, len, bitOffset, 5, decodeTargetCountMinusOne))
+			{
+				return false;
+			}
+
+			std::vector<FrameDependencyTemplate> templates;
+			uint8_t spatialLayer{ 0 };
+			uint8_t temporalLayer{ 0 };
+			uint32_t nextLayerIdc;
+
+			// template_layers().
+			do
+			{
+				if (templates.size() == MaxTemplates)
+					return false;
+
+				FrameDependencyTemplate frameTemplate;
+
+				frameTemplate.spatialLayer  = spatialLayer;
+				frameTemplate.temporalLayer = temporalLayer;
+
+				templates.push_back(frameTemplate);
+
+				if (!ReadBits(data, len, bitOffset, 2, nextLayerIdc))
+					return false;
+
+				if (nextLayerIdc == 1)
+				{
+					temporalLayer++;
+				}
+				else if (nextLayerIdc == 2)
+				{
+					temporalLayer = 0;
+					spatialLayer++;
+				}
+			} while (nextLayerIdc != 3);
+
+			uint8_t decodeTargetCount = decodeTargetCountMinusOne + 1;
+
+			// template_dtis() are not needed.
+			if (!SkipBits(len, bitOffset, 2 * decodeTargetCount * templates.size()))
+				return false;
+
+			// template_fdiffs().
+			for (auto& frameTemplate : templates)
+			{
+				uint32_t fdiffFollows;
+
+				if (!ReadBits(data, len, bitOffset, 1, fdiffFollows))
+					return false;
+
+				while (fdiffFollows != 0u)
+				{
+					frameTemplate.fdiffCount++;
+
+					if (
+					  !SkipBits(len, bitOffset, 4) || !ReadBits(data, len, bitOffset, 1, fdiffFollows))
+					{
+						return false;
+					}
+				}
+			}
+
+			// template_chains() are not needed but must be skipped.
+			uint32_t chainCount;
+
+			if (!ReadNonSymmetric(data, len, bitOffset, decodeTargetCount + 1, chainCount))
+				return false;
+
+			if (chainCount != 0)
+			{
+				uint32_t protectedBy;
+
+				for (uint8_t i = 0; i < decodeTargetCount; ++i)
+				{
+					if (!ReadNonSymmetric(data, len, bitOffset, chainCount, protectedBy))
+						return false;
+				}
+
+				if (!SkipBits(len, bitOffset, 4 * chainCount * templates.size()))
+					return false;
+			}
+
+			// decode_target_layers() are derived from the templates, with no bits.
+
+			// render_resolutions(), one per spatial layer, are not needed either.
+			uint32_t hasResolutions;
+
+			if (!ReadBits(data, len, bitOffset, 1, hasResolutions))
+				return false;
+
+			if (
+			  hasResolutions != 0u &&
+			  !SkipBits(len, bitOffset, 32 * (size_t{ templates.back().spatialLayer } + 1)))
+			{
+				return false;
+			}
+
+			context->hasStructure      = true;
+			context->templateIdOffset  = templateIdOffset;
+			context->decodeTargetCount = decodeTargetCount;
+			context->templates         = std::move(templates);
+
+			return true;
+		}
+
+		void AV1::PayloadDescriptor::Dump() const
+		{
+			MS_TRACE();
+
+			MS_DUMP("<PayloadDescriptor>");
+			MS_DUMP(
+			  "  s|e|template    : %" PRIu8 "|%" PRIu8 "|%" PRIu8,
+			  this->startOfFrame,
+			  this->endOfFrame,
+			  this->templateId);
+			MS_DUMP("  frameNumber     : %" PRIu16, this->frameNumber);
+
+			if (this->hasLayers)
+			{
+				MS_DUMP("  spatialLayer    : %" PRIu8, this->spatialLayer);
+				MS_DUMP("  temporalLayer   : %" PRIu8, this->temporalLayer);
+			}
+
+			MS_DUMP("  isKeyFrame      : %s", this->isKeyFrame ? "true" : "false");
+			MS_DUMP("  hasStructure    : %s", this->hasStructure ? "true" : "false");
+			MS_DUMP("</PayloadDescriptor>");
+		}
+
+		AV1::PayloadDescriptorHandler::PayloadDescriptorHandler(AV1::PayloadDescriptor* payloadDescriptor)
+		{
+			this->payloadDescriptor.reset(payloadDescriptor);
+		}
+
+		bool AV1::PayloadDescriptorHandler::Encode(
+		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* /*data*/, bool& marker)
+		{
+			// Without dependency descriptor there is no layer information.
+			if (!this->payloadDescriptor->hasLayers)
+				return true;
+
+			EncodingContext* context = dynamic_cast<EncodingContext*>(encodingContext);
+			auto spatialLayer        = this->payloadDescriptor->spatialLayer;
+			auto temporalLayer       = this->payloadDescriptor->temporalLayer;
+			auto isKeyFrame          = this->payloadDescriptor->isKeyFrame;
+
+			// Switch layers at the beginning of a temporal unit. Going up in spatial
+			// layers requires a key frame since higher layers depend on the lower ones.
+			// Going up in temporal layers is possible in a base temporal layer frame.
+			if (this->payloadDescriptor->startOfFrame && spatialLayer == 0)
+			{
+				auto targetSpatialLayer  = context->preferences.spatialLayer;
+				auto targetTemporalLayer = context->GetTargetTemporalLayer();
+
+				if (
+				  targetSpatialLayer < context->currentSpatialLayer ||
+				  (targetSpatialLayer > context->currentSpatialLayer && isKeyFrame))
+				{
+					context->currentSpatialLayer = targetSpatialLayer;
+				}
+
+				if (
+				  targetTemporalLayer < context->currentTemporalLayer ||
+				  (targetTemporalLayer > context->currentTemporalLayer &&
+				   (isKeyFrame || temporalLayer == 0)))
+				{
+					context->currentTemporalLayer = targetTemporalLayer;
+				}
+			}
+
+			// Drop frames of higher layers. The Consumer drops the seq and timestamp.
+			if (
+			  spatialLayer > context->currentSpatialLayer ||
+			  temporalLayer > context->currentTemporalLayer)
+			{
+				return false;
+			}
+
+			// The last packet of the highest forwarded spatial layer ends the frame.
+			if (this->payloadDescriptor->endOfFrame && spatialLayer == context->currentSpatialLayer)
+				marker = true;
+
+			return true;
+		}
+
+		void AV1::ProcessRtpPacket(RTC::RtpPacket* packet, DecodingContext* context)
+		{
+			MS_TRACE();
+
+			auto data = packet->GetPayload();
+			auto len  = packet->GetPayloadLength();
+			const uint8_t* dependencyDescriptor{ nullptr };
+			size_t dependencyDescriptorLen{ 0 };
+
+			packet->ReadDependencyDescriptor(&dependencyDescriptor, &dependencyDescriptorLen);
+
+			PayloadDescriptor* payloadDescriptor =
+			  Parse(data, len, dependencyDescriptor, dependencyDescriptorLen, context);
+
+			if (!payloadDescriptor)
+				return;
+
+			PayloadDescriptorHandler* payloadDescriptorHandler =
+			  new PayloadDescriptorHandler(payloadDescriptor);
+
+			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+		}
+	} // namespace Codecs
+} // namespace RTC
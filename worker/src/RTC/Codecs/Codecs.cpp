@@ -4,12 +4,16 @@
 #include "RTC/Codecs/Codecs.hpp"
 #include "Logger.hpp"
 #include "RTC/Codecs/VP8.hpp"
+#include "RTC/Codecs/VP9.hpp"
 
 namespace RTC
 {
 	namespace Codecs
 	{
-		void ProcessRtpPacket(RTC::RtpPacket* packet, const RTC::RtpCodecMimeType& mimeType)
+		void ProcessRtpPacket(
+		  RTC::RtpPacket* packet,
+		  const RTC::RtpCodecMimeType& mimeType,
+		  DecodingContext* decodingContext)
 		{
 			MS_TRACE();
 
@@ -22,6 +26,13 @@ namespace RTC
 					break;
 				}
 
+				case RTC::RtpCodecMimeType::Subtype::VP9:
+				{
+					VP9::ProcessRtpPacket(packet);
+
+					break;
+				}
+
 				case RTC::RtpCodecMimeType::Subtype::H264:
 				{
 					H264::ProcessRtpPacket(packet);
@@ -29,6 +40,13 @@ namespace RTC
 					break;
 				}
 
+				case RTC::RtpCodecMimeType::Subtype::AV1:
+				{
+					AV1::ProcessRtpPacket(packet, dynamic_cast<AV1::DecodingContext*>(decodingContext));
+
+					break;
+				}
+
 				default:;
 			}
 		}
@@ -9,16 +9,32 @@ namespace RTC
 {
 	namespace Codecs
 	{
-		H264::PayloadDescriptor* H264::Parse(uint8_t* data, size_t len)
+		H264::PayloadDescriptor* H264::Parse(
+		  uint8_t* data, size_t len, const uint8_t* frameMarking, size_t frameMarkingLen)
 		{
 			MS_TRACE();
 
-			(void)data;
 			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
 
 			if (len < 2)
 				return nullptr;
 
+			// Read the frame-marking extension if present. Only its first byte is
+			// needed (LID and TL0PICIDX are not used).
+			if (frameMarking && frameMarkingLen != 0)
+			{
+				uint8_t byte = frameMarking[0];
+
+				payloadDescriptor->start         = (byte >> 7) & 0x01;
+				payloadDescriptor->end           = (byte >> 6) & 0x01;
+				payloadDescriptor->independent   = (byte >> 5) & 0x01;
+				payloadDescriptor->discardable   = (byte >> 4) & 0x01;
+				payloadDescriptor->baseLayerSync = (byte >> 3) & 0x01;
+				payloadDescriptor->tlIndex       = byte & 0x07;
+
+				payloadDescriptor->hasTlIndex = true;
+			}
+
 			uint8_t nal = *data & 0x1F;
 
 			switch (nal)
@@ -86,6 +102,19 @@ namespace RTC
 			MS_TRACE();
 
 			MS_DUMP("<PayloadDescriptor>");
+
+			if (this->hasTlIndex)
+			{
+				MS_DUMP(
+				  "  s|e|i|d|b       : %" PRIu8 "|%" PRIu8 "|%" PRIu8 "|%" PRIu8 "|%" PRIu8,
+				  this->start,
+				  this->end,
+				  this->independent,
+				  this->discardable,
+				  this->baseLayerSync);
+				MS_DUMP("  tlIndex         : %" PRIu8, this->tlIndex);
+			}
+
 			MS_DUMP("  isKeyFrame      : %s", this->isKeyFrame ? "true" : "false");
 			MS_DUMP("</PayloadDescriptor>");
 		}
@@ -95,14 +124,58 @@ namespace RTC
 			this->payloadDescriptor.reset(payloadDescriptor);
 		}
 
+		bool H264::PayloadDescriptorHandler::Encode(
+		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* /*data*/, bool& /*marker*/)
+		{
+			// Without frame-marking there is no temporal layer information.
+			if (!this->payloadDescriptor->hasTlIndex)
+				return true;
+
+			EncodingContext* context = dynamic_cast<EncodingContext*>(encodingContext);
+			auto temporalLayer       = context->GetTargetTemporalLayer();
+			auto tlIndex             = this->payloadDescriptor->tlIndex;
+
+			// Switch temporal layer at the beginning of a frame. Going up is possible in an
+			// independent frame or, one layer at a time, in a base layer sync frame.
+			if (this->payloadDescriptor->start)
+			{
+				if (temporalLayer < context->currentTemporalLayer)
+				{
+					context->currentTemporalLayer = temporalLayer;
+				}
+				else if (temporalLayer > context->currentTemporalLayer)
+				{
+					if (this->payloadDescriptor->independent)
+					{
+						context->currentTemporalLayer = temporalLayer;
+					}
+					else if (
+					  this->payloadDescriptor->baseLayerSync && tlIndex == context->currentTemporalLayer + 1)
+					{
+						context->currentTemporalLayer = tlIndex;
+					}
+				}
+			}
+
+			// Drop frames of higher temporal layers. The Consumer drops the seq and timestamp.
+			if (tlIndex > context->currentTemporalLayer)
+				return false;
+
+			return true;
+		}
+
 		void H264::ProcessRtpPacket(RTC::RtpPacket* packet)
 		{
 			MS_TRACE();
 
 			auto data = packet->GetPayload();
 			auto len  = packet->GetPayloadLength();
+			const uint8_t* frameMarking{ nullptr };
+			size_t frameMarkingLen{ 0 };
+
+			packet->ReadFrameMarking(&frameMarking, &frameMarkingLen);
 
-			PayloadDescriptor* payloadDescriptor = Parse(data, len);
+			PayloadDescriptor* payloadDescriptor = Parse(data, len, frameMarking, frameMarkingLen);
 
 			if (!payloadDescriptor)
 				return;
@@ -177,7 +177,7 @@ namespace RTC
 		}
 
 		bool VP8::PayloadDescriptorHandler::Encode(
-		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* data)
+		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& /*marker*/)
 		{
 			EncodingContext* context = dynamic_cast<EncodingContext*>(encodingContext);
 
@@ -198,7 +198,24 @@ namespace RTC
 				if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(
 				      this->payloadDescriptor->pictureId, context->pictureIdManager.GetMaxInput()))
 				{
-					if (this->payloadDescriptor->tlIndex > context->preferences.temporalLayer)
+					auto temporalLayer = context->GetTargetTemporalLayer();
+					auto tlIndex       = this->payloadDescriptor->tlIndex;
+
+					// Going down is immediate. Going up is possible in a key frame or, one
+					// layer at a time, in a layer sync frame (Y bit).
+					if (temporalLayer < context->currentTemporalLayer)
+					{
+						context->currentTemporalLayer = temporalLayer;
+					}
+					else if (temporalLayer > context->currentTemporalLayer)
+					{
+						if (this->payloadDescriptor->isKeyFrame)
+							context->currentTemporalLayer = temporalLayer;
+						else if (this->payloadDescriptor->y && tlIndex == context->currentTemporalLayer + 1)
+							context->currentTemporalLayer = tlIndex;
+					}
+
+					if (tlIndex > context->currentTemporalLayer)
 					{
 						context->pictureIdManager.Drop(this->payloadDescriptor->pictureId);
 						context->tl0PictureIndexManager.Drop(this->payloadDescriptor->tl0PictureIndex);
@@ -0,0 +1,325 @@
+#define MS_CLASS "RTC::Codecs::VP9"
+// #define MS_LOG_DEV
+
+#include "RTC/Codecs/VP9.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		VP9::PayloadDescriptor* VP9::Parse(uint8_t* data, size_t len)
+		{
+			MS_TRACE();
+
+			std::unique_ptr<PayloadDescriptor> payloadDescriptor(new PayloadDescriptor());
+
+			if (len < 1)
+				return nullptr;
+
+			size_t offset = 0;
+			uint8_t byte  = data[offset];
+
+			payloadDescriptor->i = (byte >> 7) & 0x01;
+			payloadDescriptor->p = (byte >> 6) & 0x01;
+			payloadDescriptor->l = (byte >> 5) & 0x01;
+			payloadDescriptor->f = (byte >> 4) & 0x01;
+			payloadDescriptor->b = (byte >> 3) & 0x01;
+			payloadDescriptor->e = (byte >> 2) & 0x01;
+			payloadDescriptor->v = (byte >> 1) & 0x01;
+
+			if (payloadDescriptor->i)
+			{
+				if (len < ++offset + 1)
+					return nullptr;
+
+				byte = data[offset];
+
+				if ((byte >> 7) & 0x01)
+				{
+					if (len < ++offset + 1)
+						return nullptr;
+
+					payloadDescriptor->hasTwoBytesPictureId = true;
+
+					payloadDescriptor->pictureId = (byte & 0x7F) << 8;
+					payloadDescriptor->pictureId += data[offset];
+				}
+				else
+				{
+					payloadDescriptor->hasOneBytePictureId = true;
+
+					payloadDescriptor->pictureId = byte & 0x7F;
+				}
+
+				payloadDescriptor->hasPictureId = true;
+			}
+
+			if (payloadDescriptor->l)
+			{
+				if (len < ++offset + 1)
+					return nullptr;
+
+				byte = data[offset];
+
+				payloadDescriptor->hasTlIndex = true;
+				payloadDescriptor->hasSlIndex = true;
+
+				payloadDescriptor->tlIndex              = (byte >> 5) & 0x07;
+				payloadDescriptor->switchingUpPoint     = (byte >> 4) & 0x01;
+				payloadDescriptor->slIndex              = (byte >> 1) & 0x07;
+				payloadDescriptor->interLayerDependency = byte & 0x01;
+
+				// TL0PICIDX is only present in non-flexible mode.
+				if (!payloadDescriptor->f)
+				{
+					if (len < ++offset + 1)
+						return nullptr;
+
+					payloadDescriptor->hasTl0PictureIndex = true;
+
+					payloadDescriptor->tl0PictureIndex = data[offset];
+				}
+			}
+
+			// Reference indices (P_DIFF) are present in flexible mode for inter-picture
+			// predicted frames. Just validate them.
+			if (payloadDescriptor->f && payloadDescriptor->p)
+			{
+				for (size_t n = 0; n < 3; ++n)
+				{
+					if (len < ++offset + 1)
+						return nullptr;
+
+					// N bit not set, no more reference indices.
+					if (!(data[offset] & 0x01))
+						break;
+				}
+			}
+
+			// A key frame is the first packet of the lowest spatial layer of a picture
+			// which is not inter-picture predicted.
+			if (
+			  !payloadDescriptor->p && payloadDescriptor->b &&
+			  (!payloadDescriptor->hasSlIndex || payloadDescriptor->slIndex == 0))
+			{
+				payloadDescriptor->isKeyFrame = true;
+			}
+
+			return payloadDescriptor.release();
+		}
+
+		void VP9::PayloadDescriptor::Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PictureIndex) const
+		{
+			MS_TRACE();
+
+			data += 1;
+
+			if (this->i)
+			{
+				if (this->hasTwoBytesPictureId)
+				{
+					uint16_t netPictureId = htons(pictureId);
+
+					std::memcpy(data, &netPictureId, 2);
+					data[0] |= 0x80;
+					data += 2;
+				}
+				else if (this->hasOneBytePictureId)
+				{
+					*data = pictureId;
+					data++;
+
+					if (pictureId > 127)
+						MS_WARN_TAG(rtp, "casting pictureId value to one byte");
+				}
+			}
+
+			if (this->l)
+			{
+				data++;
+
+				if (!this->f)
+					*data = tl0PictureIndex;
+			}
+		}
+
+		void VP9::PayloadDescriptor::Restore(uint8_t* data) const
+		{
+			this->Encode(data, this->pictureId, this->tl0PictureIndex);
+		}
+
+		void VP9::PayloadDescriptor::Dump() const
+		{
+			MS_TRACE();
+
+			MS_DUMP("<PayloadDescriptor>");
+			MS_DUMP(
+			  "  i|p|l|f|b|e|v   : %" PRIu8 "|%" PRIu8 "|%" PRIu8 "|%" PRIu8 "|%" PRIu8 "|%" PRIu8
+			  "|%" PRIu8,
+			  this->i,
+			  this->p,
+			  this->l,
+			  this->f,
+			  this->b,
+			  this->e,
+			  this->v);
+			MS_DUMP("  pictureId       : %" PRIu16, this->pictureId);
+			MS_DUMP("  tlIndex         : %" PRIu8, this->tlIndex);
+			MS_DUMP("  switchingUpPoint     : %" PRIu8, this->switchingUpPoint);
+			MS_DUMP("  slIndex         : %" PRIu8, this->slIndex);
+			MS_DUMP("  interLayerDependency : %" PRIu8, this->interLayerDependency);
+			MS_DUMP("  tl0PictureIndex : %" PRIu8, this->tl0PictureIndex);
+			MS_DUMP("  isKeyFrame      : %s", this->isKeyFrame ? "true" : "false");
+			MS_DUMP("  hasPictureId    : %s", this->hasPictureId ? "true" : "false");
+			MS_DUMP("  hasOneBytePictureId  : %s", this->hasOneBytePictureId ? "true" : "false");
+			MS_DUMP("  hasTwoBytesPictureId : %s", this->hasTwoBytesPictureId ? "true" : "false");
+			MS_DUMP("  hasTl0PictureIndex   : %s", this->hasTl0PictureIndex ? "true" : "false");
+			MS_DUMP("  hasSlIndex           : %s", this->hasSlIndex ? "true" : "false");
+			MS_DUMP("  hasTlIndex           : %s", this->hasTlIndex ? "true" : "false");
+			MS_DUMP("</PayloadDescriptor>");
+		}
+
+		VP9::PayloadDescriptorHandler::PayloadDescriptorHandler(VP9::PayloadDescriptor* payloadDescriptor)
+		{
+			this->payloadDescriptor.reset(payloadDescriptor);
+		}
+
+		bool VP9::PayloadDescriptorHandler::Encode(
+		  RTC::Codecs::EncodingContext* encodingContext, uint8_t* data, bool& marker)
+		{
+			EncodingContext* context = dynamic_cast<EncodingContext*>(encodingContext);
+
+			// Check whether pictureId and tl0PictureIndex sync is required.
+			if (context->syncRequired)
+			{
+				context->pictureIdManager.Sync(this->payloadDescriptor->pictureId);
+				context->tl0PictureIndexManager.Sync(this->payloadDescriptor->tl0PictureIndex);
+
+				context->syncRequired = false;
+			}
+
+			if (this->payloadDescriptor->hasSlIndex)
+			{
+				// Switch spatial layer at the beginning of a picture. Going up requires a
+				// key frame since higher layers depend on the lower ones.
+				if (this->payloadDescriptor->slIndex == 0 && this->payloadDescriptor->b)
+				{
+					auto spatialLayer = context->preferences.spatialLayer;
+
+					if (
+					  spatialLayer < context->currentSpatialLayer ||
+					  (spatialLayer > context->currentSpatialLayer && this->payloadDescriptor->isKeyFrame))
+					{
+						context->currentSpatialLayer = spatialLayer;
+					}
+				}
+
+				// Higher spatial layers share the pictureId of the lower ones, so there is
+				// no pictureId to drop.
+				if (this->payloadDescriptor->slIndex > context->currentSpatialLayer)
+					return false;
+			}
+
+			// Incremental pictureId. Check the temporal layer.
+			if (this->payloadDescriptor->hasPictureId && this->payloadDescriptor->hasTlIndex)
+			{
+				if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(
+				      this->payloadDescriptor->pictureId, context->pictureIdManager.GetMaxInput()))
+				{
+					auto temporalLayer = context->GetTargetTemporalLayer();
+					auto tlIndex       = this->payloadDescriptor->tlIndex;
+
+					// Going down is immediate. Going up is possible in a key frame or in a
+					// switching up point (U bit) of a layer not higher than the target.
+					if (temporalLayer < context->currentTemporalLayer)
+					{
+						context->currentTemporalLayer = temporalLayer;
+					}
+					else if (temporalLayer > context->currentTemporalLayer)
+					{
+						if (this->payloadDescriptor->isKeyFrame)
+						{
+							context->currentTemporalLayer = temporalLayer;
+						}
+						else if (
+						  this->payloadDescriptor->switchingUpPoint &&
+						  tlIndex > context->currentTemporalLayer && tlIndex <= temporalLayer)
+						{
+							context->currentTemporalLayer = tlIndex;
+						}
+					}
+
+					if (tlIndex > context->currentTemporalLayer)
+					{
+						context->pictureIdManager.Drop(this->payloadDescriptor->pictureId);
+						context->tl0PictureIndexManager.Drop(this->payloadDescriptor->tl0PictureIndex);
+
+						return false;
+					}
+				}
+			}
+
+			// Update pictureId and tl0PictureIndex values.
+			uint16_t pictureId;
+			uint8_t tl0PictureIndex;
+
+			// Do not send a dropped pictureId.
+			if (!context->pictureIdManager.Input(this->payloadDescriptor->pictureId, pictureId))
+				return false;
+
+			// Do not send a dropped tl0PicutreIndex.
+			if (!context->tl0PictureIndexManager.Input(
+			      this->payloadDescriptor->tl0PictureIndex, tl0PictureIndex))
+				return false;
+
+			this->payloadDescriptor->Encode(data, pictureId, tl0PictureIndex);
+
+			// The last packet of the highest forwarded spatial layer ends the frame.
+			if (
+			  this->payloadDescriptor->hasSlIndex && this->payloadDescriptor->e &&
+			  this->payloadDescriptor->slIndex == context->currentSpatialLayer)
+			{
+				marker = true;
+			}
+
+			return true;
+		};
+
+		void VP9::PayloadDescriptorHandler::Restore(uint8_t* data)
+		{
+			this->payloadDescriptor->Restore(data);
+		}
+
+		void VP9::ProcessRtpPacket(RTC::RtpPacket* packet)
+		{
+			MS_TRACE();
+
+			auto data = packet->GetPayload();
+			auto len  = packet->GetPayloadLength();
+
+			PayloadDescriptor* payloadDescriptor = Parse(data, len);
+
+			if (!payloadDescriptor)
+				return;
+
+			PayloadDescriptorHandler* payloadDescriptorHandler =
+			  new PayloadDescriptorHandler(payloadDescriptor);
+
+			packet->SetPayloadDescriptorHandler(payloadDescriptorHandler);
+
+			// Modify the RtpPacket payload in order to always have two byte pictureId.
+			if (payloadDescriptor->hasOneBytePictureId)
+			{
+				// Shift the RTP payload one byte from the begining of the pictureId field.
+				packet->ShiftPayload(1, 1, true /*expand*/);
+				// Set the two byte pictureId marker bit.
+				data[1] = 0x80;
+				// Update the payloadDescriptor.
+				payloadDescriptor->hasOneBytePictureId  = false;
+				payloadDescriptor->hasTwoBytesPictureId = true;
+			}
+		}
+	} // namespace Codecs
+} // namespace RTC
@@ -6,8 +6,11 @@
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
 #include "RTC/Codecs/Codecs.hpp"
+#include "RTC/PacketLatency.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
 #include "RTC/RTCP/SenderReport.hpp"
+#include <algorithm> // std::min()
+#include <limits>    // std::numeric_limits
 #include <vector>
 
 namespace RTC
@@ -18,6 +21,8 @@ namespace RTC
 
 	static std::vector<RTC::RtpPacket*> RtpRetransmissionContainer(18);
 
+	static std::vector<uint16_t> MissingSourceSeqs;
+
 	/* Instance methods. */
 
 	Consumer::Consumer(
@@ -39,6 +44,8 @@ namespace RTC
 
 		delete this->rtpStream;
 		delete this->rtpMonitor;
+		delete this->fecEncoder;
+		delete this->redEncoder;
 	}
 
 	void Consumer::Destroy()
@@ -80,7 +87,15 @@ namespace RTC
 		json[JsonStringSourceProducerId] = Json::UInt{ this->sourceProducerId };
 
 		if (this->transport != nullptr)
-			json[JsonStringRtpParameters] = this->rtpParameters.ToJson();
+		{
+			static const Json::StaticString JsonStringEncodings{ "encodings" };
+
+			json[JsonStringRtpParameters] = this->rtpParameters->GetRtpParameters().ToJson();
+
+			// The shared parameters have no SSRCs, so use our encoding.
+			json[JsonStringRtpParameters][JsonStringEncodings] = Json::arrayValue;
+			json[JsonStringRtpParameters][JsonStringEncodings].append(this->encoding.ToJson());
+		}
 
 		if (this->rtpStream != nullptr)
 		{
@@ -107,6 +122,24 @@ namespace RTC
 
 		static const Json::StaticString JsonStringTransportId{ "transportId" };
 		static const Json::StaticString JsonStringInboundRtpId{ "inboundRtpId" };
+		static const Json::StaticString JsonStringRetransmissionBudget{ "retransmissionBudget" };
+		static const Json::StaticString JsonStringRetransmissionsDropped{ "retransmissionsDropped" };
+		static const Json::StaticString JsonStringRetransmissionBytesDropped{
+			"retransmissionBytesDropped"
+		};
+		static const Json::StaticString JsonStringFecSsrc{ "fecSsrc" };
+		static const Json::StaticString JsonStringFecGroupSize{ "fecGroupSize" };
+		static const Json::StaticString JsonStringFecPacketCount{ "fecPacketCount" };
+		static const Json::StaticString JsonStringFecByteCount{ "fecByteCount" };
+		static const Json::StaticString JsonStringRedPayloadType{ "redPayloadType" };
+		static const Json::StaticString JsonStringRedDistance{ "redDistance" };
+		static const Json::StaticString JsonStringRedPacketCount{ "redPacketCount" };
+		static const Json::StaticString JsonStringRedByteCount{ "redByteCount" };
+		static const Json::StaticString JsonStringRedBitrate{ "redBitrate" };
+		static const Json::StaticString JsonStringUpSwitchLatency{ "upSwitchLatency" };
+		static const Json::StaticString JsonStringDownSwitchLatency{ "downSwitchLatency" };
+		static const Json::StaticString JsonStringKeyFrameRequestCount{ "keyFrameRequestCount" };
+		static const Json::StaticString JsonStringComfortNoiseDropped{ "comfortNoiseDropped" };
 
 		Json::Value json(Json::arrayValue);
 
@@ -115,11 +148,52 @@ namespace RTC
 
 		auto jsonRtpStream = this->rtpStream->GetStats();
 
+		jsonRtpStream[JsonStringRetransmissionBudget] =
+		  Json::UInt{ this->retransmissionBudget.GetBitrate() };
+		jsonRtpStream[JsonStringRetransmissionsDropped] =
+		  static_cast<Json::UInt>(this->retransmissionBudget.GetPacketsDropped());
+		jsonRtpStream[JsonStringRetransmissionBytesDropped] =
+		  static_cast<Json::UInt>(this->retransmissionBudget.GetBytesDropped());
+
+		if (this->fecEncoder != nullptr)
+		{
+			jsonRtpStream[JsonStringFecSsrc]      = Json::UInt{ this->fecEncoder->GetSsrc() };
+			jsonRtpStream[JsonStringFecGroupSize] = Json::UInt{ this->fecEncoder->GetGroupSize() };
+			jsonRtpStream[JsonStringFecPacketCount] =
+			  static_cast<Json::UInt>(this->fecCounter.GetPacketCount());
+			jsonRtpStream[JsonStringFecByteCount] = static_cast<Json::UInt>(this->fecCounter.GetBytes());
+		}
+
+		if (this->redEncoder != nullptr)
+		{
+			jsonRtpStream[JsonStringRedPayloadType] = Json::UInt{ this->redEncoder->GetPayloadType() };
+			jsonRtpStream[JsonStringRedDistance]    = Json::UInt{ this->redEncoder->GetDistance() };
+			jsonRtpStream[JsonStringRedPacketCount] =
+			  static_cast<Json::UInt>(this->redEncoder->GetPacketCount());
+			jsonRtpStream[JsonStringRedByteCount] =
+			  static_cast<Json::UInt>(this->redEncoder->GetRedundantBytes());
+			jsonRtpStream[JsonStringRedBitrate] =
+			  Json::UInt{ this->redEncoder->GetBitrate(DepLibUV::GetTime()) };
+		}
+
 		if (this->transport != nullptr)
 		{
 			jsonRtpStream[JsonStringTransportId] = this->transport->transportId;
 		}
 
+		if (this->kind == RTC::Media::Kind::VIDEO)
+		{
+			jsonRtpStream[JsonStringUpSwitchLatency]   = this->upSwitchLatencyHistogram.ToJson();
+			jsonRtpStream[JsonStringDownSwitchLatency] = this->downSwitchLatencyHistogram.ToJson();
+			jsonRtpStream[JsonStringKeyFrameRequestCount] =
+			  static_cast<Json::UInt>(this->keyFrameRequestCount);
+		}
+		else if (this->suppressComfortNoise)
+		{
+			jsonRtpStream[JsonStringComfortNoiseDropped] =
+			  static_cast<Json::UInt>(this->comfortNoiseDroppedCount);
+		}
+
 		if (this->effectiveProfile == RTC::RtpEncodingParameters::Profile::NONE)
 		{
 			json.append(jsonRtpStream);
@@ -141,29 +215,54 @@ namespace RTC
 		return json;
 	}
 
+	void Consumer::FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const
+	{
+		MS_TRACE();
+
+		if (this->rtpStream == nullptr)
+			return;
+
+		RTC::StatsSnapshot::Record record;
+
+		record.type         = RTC::StatsSnapshot::RecordType::CONSUMER;
+		record.id           = this->consumerId;
+		record.ssrc         = this->rtpStream->GetSsrc();
+		record.fractionLost = this->rtpStream->fractionLost;
+		record.rtt          = static_cast<uint16_t>(std::min(this->rtpStream->GetRtt(), 65535.0f));
+		record.bitrate      = this->rtpStream->transmissionCounter.GetRate(now);
+		record.packetCount  = this->rtpStream->transmissionCounter.GetPacketCount();
+		record.byteCount    = this->rtpStream->transmissionCounter.GetBytes();
+		record.packetsLost  = this->rtpStream->packetsLost;
+		record.nackCount    = static_cast<uint32_t>(this->rtpStream->nackCount);
+		record.pliCount     = static_cast<uint32_t>(this->rtpStream->pliCount);
+		record.firCount     = static_cast<uint32_t>(this->rtpStream->firCount);
+
+		snapshot.AddRecord(record);
+	}
+
 	/**
 	 * A Transport has been assigned, and hence sending RTP parameters.
 	 */
-	void Consumer::Enable(RTC::Transport* transport, RTC::RtpParameters& rtpParameters)
+	void Consumer::Enable(
+	  RTC::Transport* transport,
+	  std::shared_ptr<const RTC::SharedRtpParameters> rtpParameters,
+	  const RTC::RtpEncodingParameters& encoding)
 	{
 		MS_TRACE();
 
 		// Must have a single encoding.
-		if (rtpParameters.encodings.empty())
-			MS_THROW_ERROR("invalid empty rtpParameters.encodings");
-		else if (rtpParameters.encodings[0].ssrc == 0)
+		if (encoding.ssrc == 0)
 			MS_THROW_ERROR("missing rtpParameters.encodings[0].ssrc");
 
 		if (IsEnabled())
 			Disable();
 
 		this->transport     = transport;
-		this->rtpParameters = rtpParameters;
-
-		FillSupportedCodecPayloadTypes();
+		this->rtpParameters = std::move(rtpParameters);
+		this->encoding      = encoding;
 
 		// Create RtpStreamSend instance.
-		CreateRtpStream(this->rtpParameters.encodings[0]);
+		CreateRtpStream();
 
 		MS_DEBUG_DEV("Consumer enabled [consumerId:%" PRIu32 "]", this->consumerId);
 	}
@@ -183,6 +282,8 @@ namespace RTC
 		{
 			this->rtpMonitor->Reset();
 			this->rtpStream->ClearRetransmissionBuffer();
+			this->retransmissionBudget.Reset();
+			this->budgetKeyFrameRequested   = false;
 			this->rtpPacketsBeforeProbation = RtpPacketsBeforeProbation;
 
 			if (IsProbing())
@@ -228,6 +329,8 @@ namespace RTC
 		{
 			this->rtpMonitor->Reset();
 			this->rtpStream->ClearRetransmissionBuffer();
+			this->retransmissionBudget.Reset();
+			this->budgetKeyFrameRequested   = false;
 			this->rtpPacketsBeforeProbation = RtpPacketsBeforeProbation;
 
 			if (IsProbing())
@@ -256,6 +359,17 @@ namespace RTC
 		}
 	}
 
+	/**
+	 * Called when packets of the source were not forwarded on purpose so the
+	 * receiver does not see them as lost.
+	 */
+	void Consumer::RequireSync()
+	{
+		MS_TRACE();
+
+		this->syncRequired = true;
+	}
+
 	void Consumer::AddProfile(
 	  const RTC::RtpEncodingParameters::Profile profile, const RTC::RtpStream* rtpStream)
 	{
@@ -372,6 +486,20 @@ namespace RTC
 		this->encodingContext->SetPreferences(preferences);
 	}
 
+	/**
+	 * When enabled, comfort noise packets are not forwarded to the receiver once it
+	 * already got one since the last non comfort noise packet.
+	 */
+	void Consumer::SetComfortNoiseSuppression(bool enabled)
+	{
+		MS_TRACE();
+
+		if (this->kind != RTC::Media::Kind::AUDIO)
+			return;
+
+		this->suppressComfortNoise = enabled;
+	}
+
 	/**
 	 * Called when the Transport assigned to this Consumer has been closed, so this
 	 * Consumer becomes unhandled.
@@ -382,7 +510,7 @@ namespace RTC
 
 		this->transport = nullptr;
 
-		this->supportedCodecPayloadTypes.clear();
+		this->rtpParameters.reset();
 
 		if (this->rtpStream != nullptr)
 		{
@@ -390,6 +518,15 @@ namespace RTC
 			this->rtpStream = nullptr;
 		}
 
+		this->retransmissionBudget.Reset();
+		this->budgetKeyFrameRequested = false;
+
+		delete this->fecEncoder;
+		this->fecEncoder = nullptr;
+
+		delete this->redEncoder;
+		this->redEncoder = nullptr;
+
 		// Reset last RTCP sent time counter.
 		this->lastRtcpSentTime = 0;
 
@@ -398,27 +535,30 @@ namespace RTC
 			StopProbation();
 	}
 
-	void Consumer::SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpEncodingParameters::Profile profile)
+	/**
+	 * Returns true if the packet was sent to the Transport.
+	 */
+	bool Consumer::SendRtpPacket(RTC::RtpPacket* packet, RTC::RtpEncodingParameters::Profile profile)
 	{
 		MS_TRACE();
 
 		if (!IsEnabled())
-			return;
+			return false;
 
 		// If paused don't forward RTP.
 		if (IsPaused())
-			return;
+			return false;
 
 		// Map the payload type.
 		auto payloadType = packet->GetPayloadType();
 
 		// NOTE: This may happen if this Consumer supports just some codecs of those
 		// in the corresponding Producer.
-		if (this->supportedCodecPayloadTypes.find(payloadType) == this->supportedCodecPayloadTypes.end())
+		if (!this->rtpParameters->IsSupportedPayloadType(payloadType))
 		{
 			MS_DEBUG_DEV("payload type not supported [payloadType:%" PRIu8 "]", payloadType);
 
-			return;
+			return false;
 		}
 
 		// Check whether this is the key frame we are waiting for in order to update the effective
@@ -459,7 +599,28 @@ namespace RTC
 		// If the packet belongs to different profile than the one being sent, drop it.
 		// NOTE: This is specific to simulcast with no temporal layers.
 		if (profile != this->effectiveProfile)
-			return;
+			return false;
+
+		if (this->suppressComfortNoise)
+		{
+			bool isComfortNoise =
+			  this->rtpParameters->IsComfortNoisePayloadType(payloadType) ||
+			  (payloadType == this->rtpStream->GetPayloadType() &&
+			   Codecs::IsComfortNoise(packet, this->rtpStream->GetMimeType()));
+
+			// Let the sequence numbers continue where the dropped comfort noise left
+			// them while keeping the output to input mapping (needed by NACK).
+			// RTP timestamps are kept since they still follow the sender clock.
+			if (isComfortNoise && this->comfortNoiseSent)
+			{
+				this->rtpSeqManager.Drop(packet->GetSequenceNumber());
+				this->comfortNoiseDroppedCount++;
+
+				return false;
+			}
+
+			this->comfortNoiseSent = isComfortNoise;
+		}
 
 		// Whether this is the first packet after re-sync.
 		bool isSyncPacket = false;
@@ -494,7 +655,7 @@ namespace RTC
 			this->rtpSeqManager.Drop(packet->GetSequenceNumber());
 			this->rtpTimestampManager.Drop(packet->GetTimestamp());
 
-			return;
+			return false;
 		}
 
 		// Update RTP seq number and timestamp.
@@ -514,7 +675,7 @@ namespace RTC
 		auto origTimestamp = packet->GetTimestamp();
 
 		// Rewrite packet SSRC.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
+		packet->SetSsrc(this->encoding.ssrc);
 
 		// Rewrite packet sequence number.
 		packet->SetSequenceNumber(rtpSeq);
@@ -537,10 +698,23 @@ namespace RTC
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		bool sent = this->rtpStream->ReceivePacket(packet);
+
+		if (sent)
 		{
-			// Send the packet.
-			this->transport->SendRtpPacket(packet);
+			// The key frame requested due to the exhausted budget is on its way.
+			if (this->budgetKeyFrameRequested && packet->IsKeyFrame())
+				this->budgetKeyFrameRequested = false;
+
+			// Send the packet (RED encapsulated if enabled).
+			if (this->redEncoder != nullptr)
+				SendRedPacket(packet);
+			else
+				this->transport->SendRtpPacket(packet);
+
+			// Protect the packet with FEC if enabled.
+			if (this->fecEncoder != nullptr)
+				SendFecPacket(packet);
 
 			// Retransmit the RTP packet if probing.
 			if (IsProbing())
@@ -579,6 +753,8 @@ namespace RTC
 			this->rtpPacketsBeforeProbation = RtpPacketsBeforeProbation;
 			MayRunProbation();
 		}
+
+		return sent;
 	}
 
 	void Consumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
@@ -597,8 +773,8 @@ namespace RTC
 			return;
 
 		// NOTE: This assumes a single stream.
-		uint32_t ssrc     = this->rtpParameters.encodings[0].ssrc;
-		std::string cname = this->rtpParameters.rtcp.cname;
+		uint32_t ssrc     = this->encoding.ssrc;
+		std::string cname = this->rtpParameters->GetRtpParameters().rtcp.cname;
 
 		report->SetSsrc(ssrc);
 		packet->AddSenderReport(report);
@@ -622,13 +798,32 @@ namespace RTC
 
 		this->rtpStream->nackCount++;
 
+		uint64_t now          = DepLibUV::GetTime();
+		uint32_t mediaBitrate = this->rtpStream->GetRate(now);
+		bool budgetExhausted{ false };
+
+		MissingSourceSeqs.clear();
+
 		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
 		{
 			RTC::RTCP::FeedbackRtpNackItem* item = *it;
 
-			this->rtpStream->RequestRtpRetransmission(
+			uint32_t missingBitmask = this->rtpStream->RequestRtpRetransmission(
 			  item->GetPacketId(), item->GetLostPacketBitmask(), RtpRetransmissionContainer);
 
+			// Map the packets we never sent to the source seq numbers.
+			for (uint16_t idx = 0; missingBitmask != 0; ++idx, missingBitmask >>= 1)
+			{
+				uint16_t sourceSeq;
+
+				if (
+				  (missingBitmask & 1) != 0 &&
+				  this->rtpSeqManager.GetInput(item->GetPacketId() + idx, sourceSeq))
+				{
+					MissingSourceSeqs.push_back(sourceSeq);
+				}
+			}
+
 			auto it2 = RtpRetransmissionContainer.begin();
 			for (; it2 != RtpRetransmissionContainer.end(); ++it2)
 			{
@@ -637,14 +832,66 @@ namespace RTC
 				if (packet == nullptr)
 					break;
 
+				// Don't let retransmissions exceed the budget.
+				if (!this->retransmissionBudget.Consume(packet->GetSize(), mediaBitrate, now))
+				{
+					budgetExhausted = true;
+
+					continue;
+				}
+
 				RetransmitRtpPacket(packet);
 
+				if (RTC::PacketLatency::IsSampled())
+				{
+					uint64_t latency = RTC::PacketLatency::GetElapsed();
+
+					for (auto& listener : this->listeners)
+					{
+						listener->OnConsumerRtpPacketRetransmitted(this, latency);
+					}
+				}
+
 				this->rtpMonitor->RtpPacketRepaired(packet);
 
 				// Packet repaired after applying RTX.
 				this->rtpStream->packetsRepaired++;
 			}
 		}
+
+		// Packets lost before reaching us. Let the Producer ask for them so the
+		// repaired packets are forwarded to us again.
+		if (
+		  !MissingSourceSeqs.empty() &&
+		  this->effectiveProfile != RTC::RtpEncodingParameters::Profile::NONE)
+		{
+			MS_DEBUG_TAG(
+			  rtx,
+			  "relaying NACK for packets not in the buffer [ssrc:%" PRIu32 ", count:%zu]",
+			  this->rtpStream->GetSsrc(),
+			  MissingSourceSeqs.size());
+
+			for (auto& listener : this->listeners)
+			{
+				listener->OnConsumerRetransmissionRequired(this, this->effectiveProfile, MissingSourceSeqs);
+			}
+		}
+
+		// Repairing the losses would cost more than allowed, so ask for a key frame
+		// instead. Once is enough, later NACKs are caused by the same losses.
+		if (budgetExhausted && !this->budgetKeyFrameRequested)
+		{
+			MS_DEBUG_TAG(
+			  rtx,
+			  "retransmission budget exhausted, requesting a key frame [ssrc:%" PRIu32
+			  ", budget:%" PRIu32 "bps]",
+			  this->rtpStream->GetSsrc(),
+			  this->retransmissionBudget.GetBitrate());
+
+			this->budgetKeyFrameRequested = true;
+
+			RequestKeyFrame();
+		}
 	}
 
 	void Consumer::ReceiveKeyFrameRequest(RTCP::FeedbackPs::MessageType messageType)
@@ -690,6 +937,14 @@ namespace RTC
 
 		if (this->kind == RTC::Media::Kind::VIDEO)
 			this->rtpMonitor->ReceiveRtcpReceiverReport(report);
+
+		// Adapt the FEC protection level to the reported loss.
+		if (this->fecEncoder != nullptr)
+			this->fecEncoder->SetFractionLost(report->GetFractionLost());
+
+		// Enable or disable audio redundancy based on the reported loss.
+		if (this->redEncoder != nullptr)
+			this->redEncoder->SetFractionLost(report->GetFractionLost());
 	}
 
 	float Consumer::GetLossPercentage() const
@@ -723,6 +978,8 @@ namespace RTC
 		if (this->kind != RTC::Media::Kind::VIDEO || IsPaused())
 			return;
 
+		this->keyFrameRequestCount++;
+
 		for (auto& listener : this->listeners)
 		{
 			listener->OnConsumerKeyFrameRequired(this);
@@ -757,23 +1014,20 @@ namespace RTC
 		RecalculateTargetProfile();
 	}
 
-	void Consumer::FillSupportedCodecPayloadTypes()
+	void Consumer::CreateRtpStream()
 	{
 		MS_TRACE();
 
-		for (auto& codec : this->rtpParameters.codecs)
-		{
-			this->supportedCodecPayloadTypes.insert(codec.payloadType);
-		}
-	}
+		auto& encoding = this->encoding;
+		uint32_t ssrc  = encoding.ssrc;
+		// Get the codec of the stream/encoding.
+		auto* mediaCodec = this->rtpParameters->GetCodec(encoding.codecPayloadType);
 
-	void Consumer::CreateRtpStream(RTC::RtpEncodingParameters& encoding)
-	{
-		MS_TRACE();
+		// This should never happen.
+		if (mediaCodec == nullptr)
+			MS_ABORT("no valid codec payload type for the given encoding");
 
-		uint32_t ssrc = encoding.ssrc;
-		// Get the codec of the stream/encoding.
-		auto& codec = this->rtpParameters.GetCodecForEncoding(encoding);
+		auto& codec = *mediaCodec;
 		bool useNack{ false };
 		bool usePli{ false };
 
@@ -811,9 +1065,44 @@ namespace RTC
 
 		if (encoding.hasRtx && encoding.rtx.ssrc != 0u)
 		{
-			auto& codec = this->rtpParameters.GetRtxCodecForEncoding(encoding);
+			auto* rtxCodec = this->rtpParameters->GetRtxCodec(encoding.codecPayloadType);
+
+			// Same as when the RTX codec was looked up in the codecs.
+			this->rtpStream->SetRtx(rtxCodec != nullptr ? rtxCodec->payloadType : 0, encoding.rtx.ssrc);
+		}
+
+		// Enable FlexFEC for video if negotiated.
+		if (
+		  this->kind == RTC::Media::Kind::VIDEO && encoding.hasFec && encoding.fec.ssrc != 0u &&
+		  encoding.fec.mechanism.find("flexfec") == 0)
+		{
+			for (auto& fecCodec : this->rtpParameters->GetRtpParameters().codecs)
+			{
+				if (fecCodec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::FLEXFEC)
+				{
+					MS_DEBUG_TAG(rtp, "FlexFEC supported");
+
+					this->fecEncoder = new RTC::FlexFecEncoder(fecCodec.payloadType, encoding.fec.ssrc);
+
+					break;
+				}
+			}
+		}
+
+		// Enable RED for audio if negotiated.
+		if (this->kind == RTC::Media::Kind::AUDIO)
+		{
+			for (auto& redCodec : this->rtpParameters->GetRtpParameters().codecs)
+			{
+				if (redCodec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RED)
+				{
+					MS_DEBUG_TAG(rtp, "RED supported");
 
-			this->rtpStream->SetRtx(codec.payloadType, encoding.rtx.ssrc);
+					this->redEncoder = new RTC::RedEncoder(redCodec.payloadType);
+
+					break;
+				}
+			}
 		}
 
 		this->encodingContext.reset(RTC::Codecs::GetEncodingContext(codec.mimeType));
@@ -821,6 +1110,45 @@ namespace RTC
 		this->rtpMonitor = new RTC::RtpMonitor(this, this->rtpStream);
 	}
 
+	void Consumer::SendRedPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		auto* redPacket = this->redEncoder->Encode(packet);
+
+		// RED is currently disabled or the packet is already RED, send the
+		// original packet.
+		if (redPacket == nullptr)
+		{
+			this->transport->SendRtpPacket(packet);
+
+			return;
+		}
+
+		// Send the packet.
+		this->transport->SendRtpPacket(redPacket);
+
+		delete redPacket;
+	}
+
+	void Consumer::SendFecPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		auto* fecPacket = this->fecEncoder->AddPacket(packet);
+
+		if (fecPacket == nullptr)
+			return;
+
+		// Update FEC RTP data counter.
+		this->fecCounter.Update(fecPacket);
+
+		// Send the packet.
+		this->transport->SendRtpPacket(fecPacket);
+
+		delete fecPacket;
+	}
+
 	void Consumer::RetransmitRtpPacket(RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
@@ -908,9 +1236,14 @@ namespace RTC
 
 			auto it = this->mapProfileRtpStream.find(this->effectiveProfile);
 
-			// This is already the lowest profile.
+			// This is already the lowest profile. Drop its temporal layers.
 			if (it == this->mapProfileRtpStream.begin())
+			{
+				if (this->encodingContext)
+					this->encodingContext->SetTemporalLayerLimit(0);
+
 				return;
+			}
 
 			// Downgrade the target profile.
 			newTargetProfile = (std::prev(it))->first;
@@ -944,6 +1277,10 @@ namespace RTC
 			}
 		}
 
+		// Unless a down-switch is ongoing, forward all the temporal layers again.
+		if (this->encodingContext && this->targetProfile >= this->effectiveProfile)
+			this->encodingContext->SetTemporalLayerLimit(std::numeric_limits<uint8_t>::max());
+
 		// Not enabled. Make this the target profile.
 		if (!IsEnabled())
 		{
@@ -1000,7 +1337,19 @@ namespace RTC
 		}
 
 		if (this->targetProfile == this->effectiveProfile)
+		{
+			this->profileSwitchStartedAt = 0;
+
 			return;
+		}
+
+		if (this->profileSwitchStartedAt == 0)
+			this->profileSwitchStartedAt = DepLibUV::GetTime();
+
+		// Down-switch. Drop the temporal layers of the effective profile right now
+		// rather than waiting for a key frame in the target profile.
+		if (this->targetProfile < this->effectiveProfile && this->encodingContext)
+			this->encodingContext->SetTemporalLayerLimit(0);
 
 		if (IsEnabled() && !IsPaused())
 			RequestKeyFrame();
@@ -1019,8 +1368,25 @@ namespace RTC
 
 		Json::Value eventData(Json::objectValue);
 
+		// Account the latency of the switch.
+		if (this->profileSwitchStartedAt != 0 && profile != RtpEncodingParameters::Profile::NONE)
+		{
+			auto latency = DepLibUV::GetTime() - this->profileSwitchStartedAt;
+
+			if (profile > this->effectiveProfile)
+				this->upSwitchLatencyHistogram.Add(latency);
+			else
+				this->downSwitchLatencyHistogram.Add(latency);
+
+			this->profileSwitchStartedAt = 0;
+		}
+
 		this->effectiveProfile = profile;
 
+		// New profile, forward all its temporal layers.
+		if (this->encodingContext)
+			this->encodingContext->SetTemporalLayerLimit(std::numeric_limits<uint8_t>::max());
+
 		MS_DEBUG_TAG(
 		  rtp,
 		  "effective profile set [profile:%s]",
@@ -1034,7 +1400,7 @@ namespace RTC
 		// Notify.
 		eventData[JsonStringProfile] = RTC::RtpEncodingParameters::profile2String[this->effectiveProfile];
 
-		this->notifier->Emit(this->consumerId, "effectiveprofilechange", eventData);
+		this->notifier->EmitCoalesced(this->consumerId, "effectiveprofilechange", eventData);
 	}
 
 	void Consumer::SendProbation(RTC::RtpPacket* packet)
@@ -0,0 +1,89 @@
+#define MS_CLASS "RTC::CpuUsage"
+// #define MS_LOG_DEV
+
+#include "RTC/CpuUsage.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Class variables. */
+
+	CpuUsage::Scope* CpuUsage::currentScope{ nullptr };
+
+	/* Scope methods. */
+
+	CpuUsage::Scope::Scope(CpuUsage* cpuUsage)
+	  : cpuUsage(cpuUsage), parent(CpuUsage::currentScope), startTime(uv_hrtime())
+	{
+		CpuUsage::currentScope = this;
+	}
+
+	CpuUsage::Scope::~Scope()
+	{
+		uint64_t elapsed = uv_hrtime() - this->startTime;
+
+		CpuUsage::currentScope = this->parent;
+
+		if (this->parent != nullptr)
+			this->parent->childTime += elapsed;
+
+		// The owner was destroyed within this scope.
+		if (this->cpuUsage == nullptr)
+			return;
+
+		this->cpuUsage->Add(elapsed - this->childTime, DepLibUV::GetTime());
+	}
+
+	/* Instance methods. */
+
+	CpuUsage::~CpuUsage()
+	{
+		MS_TRACE();
+
+		for (auto* scope = CpuUsage::currentScope; scope != nullptr; scope = scope->parent)
+		{
+			if (scope->cpuUsage == this)
+				scope->cpuUsage = nullptr;
+		}
+	}
+
+	void CpuUsage::Add(uint64_t time, uint64_t now)
+	{
+		MS_TRACE();
+
+		if (now >= this->windowStartTime + WindowSize)
+		{
+			// Not a single Add() during the previous window.
+			if (now >= this->windowStartTime + (2 * WindowSize))
+				this->lastWindowTime = 0;
+			else
+				this->lastWindowTime = this->windowTime;
+
+			this->windowStartTime = now - ((now - this->windowStartTime) % WindowSize);
+			this->windowTime      = 0;
+		}
+
+		this->totalTime += time;
+		this->windowTime += time;
+	}
+
+	uint32_t CpuUsage::GetRate(uint64_t now) const
+	{
+		MS_TRACE();
+
+		uint64_t time;
+
+		// Nothing accounted during the latest complete window.
+		if (now >= this->windowStartTime + (2 * WindowSize))
+			time = 0;
+		// The current window is complete.
+		else if (now >= this->windowStartTime + WindowSize)
+			time = this->windowTime;
+		else
+			time = this->lastWindowTime;
+
+		// Nanoseconds per millisecond are microseconds per second.
+		return static_cast<uint32_t>(time / WindowSize);
+	}
+} // namespace RTC
@@ -0,0 +1,335 @@
+#define MS_CLASS "RTC::FlexFec"
+// #define MS_LOG_DEV
+
+#include "RTC/FlexFec.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy(), std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Size of the fixed RTP header, which is not covered by the payload recovery.
+	static constexpr size_t RtpHeaderSize{ 12 };
+	static uint8_t FecPacketBuffer[RTC::MtuSize];
+
+	/* Class methods. */
+
+	/**
+	 * XOR src into dst. Process 8 bytes per iteration so the compiler can
+	 * vectorize the loop, std::memcpy() avoids unaligned access issues.
+	 */
+	void FlexFec::Xor(uint8_t* dst, const uint8_t* src, size_t len)
+	{
+		size_t i{ 0 };
+
+		for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+		{
+			uint64_t a;
+			uint64_t b;
+
+			std::memcpy(&a, dst + i, sizeof(uint64_t));
+			std::memcpy(&b, src + i, sizeof(uint64_t));
+			a ^= b;
+			std::memcpy(dst + i, &a, sizeof(uint64_t));
+		}
+
+		for (; i < len; ++i)
+		{
+			dst[i] ^= src[i];
+		}
+	}
+
+	/**
+	 * Recover the single media packet protected by fecPacket which is missing
+	 * in the given packets. The recovered packet is written into buffer (which
+	 * must be at least MtuSize bytes long).
+	 */
+	RtpPacket* FlexFec::RecoverPacket(
+	  const RtpPacket* fecPacket, const std::vector<RtpPacket*>& packets, uint8_t* buffer)
+	{
+		MS_TRACE();
+
+		const uint8_t* fecHeader = fecPacket->GetPayload();
+		size_t fecLength         = fecPacket->GetPayloadLength();
+
+		if (fecLength < FlexFec::HeaderSize)
+		{
+			MS_WARN_TAG(rtp, "FlexFEC packet too short");
+
+			return nullptr;
+		}
+
+		// Just a single SSRC and a single 15 bits mask are supported.
+		if (fecHeader[8] != 1 || (fecHeader[18] & 0x80) == 0)
+		{
+			MS_WARN_TAG(rtp, "unsupported FlexFEC header");
+
+			return nullptr;
+		}
+
+		uint32_t mediaSsrc = Utils::Byte::Get4Bytes(fecHeader, 12);
+		uint16_t seqBase   = Utils::Byte::Get2Bytes(fecHeader, 16);
+		uint16_t mask      = Utils::Byte::Get2Bytes(fecHeader, 18) & 0x7FFF;
+		size_t payloadRecoveryLength = fecLength - FlexFec::HeaderSize;
+
+		uint8_t headerRecovery[2]  = { fecHeader[0], fecHeader[1] };
+		uint16_t lengthRecovery    = Utils::Byte::Get2Bytes(fecHeader, 2);
+		uint32_t timestampRecovery = Utils::Byte::Get4Bytes(fecHeader, 4);
+		size_t numMissing{ 0 };
+		uint16_t missingSeq{ 0 };
+
+		std::memcpy(buffer + RtpHeaderSize, fecHeader + FlexFec::HeaderSize, payloadRecoveryLength);
+
+		for (uint8_t idx = 0; idx < FlexFec::MaxGroupSize; ++idx)
+		{
+			if ((mask & (1 << (14 - idx))) == 0)
+				continue;
+
+			uint16_t seq           = seqBase + idx;
+			const RtpPacket* found = nullptr;
+
+			for (auto* packet : packets)
+			{
+				if (packet->GetSsrc() == mediaSsrc && packet->GetSequenceNumber() == seq)
+				{
+					found = packet;
+
+					break;
+				}
+			}
+
+			if (found == nullptr)
+			{
+				numMissing++;
+				missingSeq = seq;
+
+				continue;
+			}
+
+			const uint8_t* data = found->GetData();
+			size_t length       = found->GetSize() - RtpHeaderSize;
+
+			if (length > payloadRecoveryLength)
+			{
+				MS_WARN_TAG(rtp, "protected packet bigger than the FlexFEC payload");
+
+				return nullptr;
+			}
+
+			headerRecovery[0] ^= data[0];
+			headerRecovery[1] ^= data[1];
+			lengthRecovery ^= static_cast<uint16_t>(length);
+			timestampRecovery ^= found->GetTimestamp();
+
+			FlexFec::Xor(buffer + RtpHeaderSize, data + RtpHeaderSize, length);
+		}
+
+		// XOR can just recover a single lost packet.
+		if (numMissing != 1)
+			return nullptr;
+
+		if (lengthRecovery > payloadRecoveryLength)
+		{
+			MS_WARN_TAG(rtp, "wrong FlexFEC length recovery");
+
+			return nullptr;
+		}
+
+		// Version 2 plus recovered P, X and CC fields.
+		buffer[0] = 0x80 | (headerRecovery[0] & 0x3F);
+		// Recovered M and PT fields.
+		buffer[1] = headerRecovery[1];
+		Utils::Byte::Set2Bytes(buffer, 2, missingSeq);
+		Utils::Byte::Set4Bytes(buffer, 4, timestampRecovery);
+		Utils::Byte::Set4Bytes(buffer, 8, mediaSsrc);
+
+		return RtpPacket::Parse(buffer, RtpHeaderSize + lengthRecovery);
+	}
+
+	/* Instance methods. */
+
+	FlexFecEncoder::FlexFecEncoder(uint8_t payloadType, uint32_t ssrc)
+	  : payloadType(payloadType), ssrc(ssrc)
+	{
+		MS_TRACE();
+
+		this->seq = static_cast<uint16_t>(Utils::Crypto::GetRandomUInt(0u, 0xFFFF));
+
+		// NOTE: ResetGroup() just clears the used part of the payload recovery, so
+		// the rest of it must always remain zeroed.
+		std::memset(this->payloadRecovery, 0, sizeof(this->payloadRecovery));
+
+		ResetGroup();
+	}
+
+	/**
+	 * Protect the given media packet (already in its definitive form). Returns
+	 * a FEC packet if the current group is complete, which must be sent and
+	 * deleted by the caller before calling this method again.
+	 */
+	RtpPacket* FlexFecEncoder::AddPacket(const RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (this->groupSize == 0)
+			return nullptr;
+
+		size_t length = packet->GetSize() - RtpHeaderSize;
+
+		// The FEC packet must fit into the MTU.
+		if (RtpHeaderSize + FlexFec::HeaderSize + length > RTC::MtuSize)
+		{
+			MS_DEBUG_TAG(
+			  rtp,
+			  "packet too big to be protected by FlexFEC [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
+			  packet->GetSsrc(),
+			  packet->GetSequenceNumber(),
+			  packet->GetSize());
+
+			ResetGroup();
+
+			return nullptr;
+		}
+
+		// Protected packets must be consecutive, otherwise start a new group.
+		if (
+		  this->numPackets != 0 &&
+		  (packet->GetSsrc() != this->mediaSsrc ||
+		   packet->GetSequenceNumber() != static_cast<uint16_t>(this->seqBase + this->numPackets)))
+		{
+			ResetGroup();
+		}
+
+		if (this->numPackets == 0)
+		{
+			this->mediaSsrc = packet->GetSsrc();
+			this->seqBase   = packet->GetSequenceNumber();
+		}
+
+		const uint8_t* data = packet->GetData();
+
+		this->headerRecovery[0] ^= data[0];
+		this->headerRecovery[1] ^= data[1];
+		this->lengthRecovery ^= static_cast<uint16_t>(length);
+		this->timestampRecovery ^= packet->GetTimestamp();
+		this->lastTimestamp = packet->GetTimestamp();
+
+		FlexFec::Xor(this->payloadRecovery, data + RtpHeaderSize, length);
+
+		if (length > this->payloadRecoveryLength)
+			this->payloadRecoveryLength = length;
+
+		if (++this->numPackets < this->groupSize)
+			return nullptr;
+
+		auto* fecPacket = CreateFecPacket();
+
+		ResetGroup();
+
+		return fecPacket;
+	}
+
+	/**
+	 * Adapt the protection level to the loss reported by the receiver
+	 * (fraction lost in 1/256 units).
+	 */
+	void FlexFecEncoder::SetFractionLost(uint8_t fractionLost)
+	{
+		MS_TRACE();
+
+		uint8_t groupSize;
+
+		// Less than 1%.
+		if (fractionLost < 3)
+			groupSize = 0;
+		// Less than 5%.
+		else if (fractionLost < 13)
+			groupSize = 10;
+		// Less than 10%.
+		else if (fractionLost < 26)
+			groupSize = 6;
+		// Less than 20%.
+		else if (fractionLost < 51)
+			groupSize = 4;
+		else
+			groupSize = 2;
+
+		SetGroupSize(groupSize);
+	}
+
+	void FlexFecEncoder::SetGroupSize(uint8_t groupSize)
+	{
+		MS_TRACE();
+
+		if (groupSize > FlexFec::MaxGroupSize)
+			groupSize = FlexFec::MaxGroupSize;
+
+		if (groupSize == this->groupSize)
+			return;
+
+		MS_DEBUG_TAG(
+		  rtp,
+		  "FlexFEC protection changed [ssrc:%" PRIu32 ", group size:%" PRIu8 "]",
+		  this->ssrc,
+		  groupSize);
+
+		this->groupSize = groupSize;
+
+		ResetGroup();
+	}
+
+	void FlexFecEncoder::ResetGroup()
+	{
+		MS_TRACE();
+
+		std::memset(this->payloadRecovery, 0, this->payloadRecoveryLength);
+
+		this->numPackets            = 0;
+		this->headerRecovery[0]     = 0;
+		this->headerRecovery[1]     = 0;
+		this->lengthRecovery        = 0;
+		this->timestampRecovery     = 0;
+		this->payloadRecoveryLength = 0;
+	}
+
+	RtpPacket* FlexFecEncoder::CreateFecPacket()
+	{
+		MS_TRACE();
+
+		uint8_t* buffer    = FecPacketBuffer;
+		uint8_t* fecHeader = buffer + RtpHeaderSize;
+		uint16_t mask{ 0 };
+
+		for (uint8_t idx = 0; idx < this->numPackets; ++idx)
+		{
+			mask |= 1 << (14 - idx);
+		}
+
+		// RTP header.
+		buffer[0] = 0x80;
+		buffer[1] = this->payloadType;
+		Utils::Byte::Set2Bytes(buffer, 2, this->seq++);
+		Utils::Byte::Set4Bytes(buffer, 4, this->lastTimestamp);
+		Utils::Byte::Set4Bytes(buffer, 8, this->ssrc);
+
+		// FlexFEC header (R and F bits must be zero).
+		fecHeader[0] = this->headerRecovery[0] & 0x3F;
+		fecHeader[1] = this->headerRecovery[1];
+		Utils::Byte::Set2Bytes(fecHeader, 2, this->lengthRecovery);
+		Utils::Byte::Set4Bytes(fecHeader, 4, this->timestampRecovery);
+		// SSRCCount and reserved.
+		Utils::Byte::Set4Bytes(fecHeader, 8, 0x01000000);
+		Utils::Byte::Set4Bytes(fecHeader, 12, this->mediaSsrc);
+		Utils::Byte::Set2Bytes(fecHeader, 16, this->seqBase);
+		// k bit set since the mask fits into 15 bits.
+		Utils::Byte::Set2Bytes(fecHeader, 18, 0x8000 | mask);
+
+		std::memcpy(
+		  fecHeader + FlexFec::HeaderSize, this->payloadRecovery, this->payloadRecoveryLength);
+
+		return RtpPacket::Parse(
+		  buffer, RtpHeaderSize + FlexFec::HeaderSize + this->payloadRecoveryLength);
+	}
+} // namespace RTC
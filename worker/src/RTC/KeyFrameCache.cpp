@@ -0,0 +1,152 @@
+#define MS_CLASS "RTC::KeyFrameCache"
+// #define MS_LOG_DEV
+
+#include "RTC/KeyFrameCache.hpp"
+#include "Logger.hpp"
+#include "RTC/Codecs/Codecs.hpp"
+#include "RTC/SeqManager.hpp"
+
+namespace RTC
+{
+	/* Item instance methods. */
+
+	KeyFrameCache::Item::Item(const RTC::RtpPacket* packet, std::unique_ptr<StorageItem> storage)
+	  : storage(std::move(storage))
+	{
+		MS_TRACE();
+
+		this->packet = packet->Clone(this->storage->store);
+	}
+
+	KeyFrameCache::Item::~Item()
+	{
+		MS_TRACE();
+
+		delete this->packet;
+	}
+
+	/* Instance methods. */
+
+	KeyFrameCache::KeyFrameCache(const RTC::RtpCodecMimeType& mimeType) : mimeType(mimeType)
+	{
+		MS_TRACE();
+
+		this->decodingContext.reset(Codecs::GetDecodingContext(mimeType));
+
+		this->packets.reserve(MaxPackets);
+	}
+
+	void KeyFrameCache::ReceivePacket(const RTC::RtpPacket* packet, uint64_t now)
+	{
+		MS_TRACE();
+
+		uint16_t seq = packet->GetSequenceNumber();
+
+		// First packet of a new key frame, start over.
+		if (
+		  packet->IsKeyFrame() &&
+		  (!this->hasKeyFrame || packet->GetTimestamp() != this->keyFrameTimestamp))
+		{
+			Reset();
+
+			this->hasKeyFrame       = true;
+			this->keyFrameTimestamp = packet->GetTimestamp();
+			this->keyFrameTime      = now;
+			this->lastSeq           = seq - 1;
+		}
+
+		if (!this->hasKeyFrame)
+			return;
+
+		// Old or retransmitted packet, already cached.
+		if (SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq + 1))
+			return;
+
+		// A gap would prevent the receiver from decoding the cached frames.
+		if (seq != static_cast<uint16_t>(this->lastSeq + 1))
+		{
+			MS_DEBUG_DEV("gap in the key frame cache [seq:%" PRIu16 "]", seq);
+
+			Reset();
+
+			return;
+		}
+
+		// Too many packets to be sent at once, wait for the next key frame.
+		if (this->packets.size() == MaxPackets)
+		{
+			MS_DEBUG_DEV("key frame cache full [seq:%" PRIu16 "]", seq);
+
+			Reset();
+
+			return;
+		}
+
+		if (packet->GetSize() > RTC::MtuSize)
+		{
+			MS_WARN_TAG(rtp, "packet too big for the key frame cache [seq:%" PRIu16 "]", seq);
+
+			Reset();
+
+			return;
+		}
+
+		AddPacket(packet);
+
+		this->lastSeq = seq;
+
+		if (packet->GetTimestamp() == this->keyFrameTimestamp && packet->HasMarker())
+			this->keyFrameComplete = true;
+	}
+
+	/**
+	 * Whether the cache holds a complete key frame and every packet after it,
+	 * and it is recent enough to be sent to a new receiver.
+	 */
+	bool KeyFrameCache::IsValid(uint64_t now) const
+	{
+		MS_TRACE();
+
+		return this->hasKeyFrame && this->keyFrameComplete && now - this->keyFrameTime <= MaxAge;
+	}
+
+	void KeyFrameCache::Reset()
+	{
+		MS_TRACE();
+
+		// Keep the storage of the packets not being sent to reuse it.
+		for (auto& item : this->packets)
+		{
+			if (item.use_count() == 1)
+				this->freeStorage.push_back(std::move(item->storage));
+		}
+
+		this->packets.clear();
+		this->hasKeyFrame      = false;
+		this->keyFrameComplete = false;
+	}
+
+	void KeyFrameCache::AddPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		std::unique_ptr<StorageItem> storage;
+
+		if (!this->freeStorage.empty())
+		{
+			storage = std::move(this->freeStorage.back());
+			this->freeStorage.pop_back();
+		}
+		else
+		{
+			storage.reset(new StorageItem);
+		}
+
+		auto item = std::make_shared<Item>(packet, std::move(storage));
+
+		// Set the payload descriptor handler (needed to rewrite the payload).
+		Codecs::ProcessRtpPacket(item->packet, this->mimeType, this->decodingContext.get());
+
+		this->packets.push_back(item);
+	}
+} // namespace RTC
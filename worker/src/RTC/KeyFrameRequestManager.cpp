@@ -0,0 +1,207 @@
+#define MS_CLASS "RTC::KeyFrameRequestManager"
+// #define MS_LOG_DEV
+
+#include "RTC/KeyFrameRequestManager.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	KeyFrameRequestManager::KeyFrameRequestManager(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+
+		this->timer = new Timer(this);
+	}
+
+	KeyFrameRequestManager::~KeyFrameRequestManager()
+	{
+		MS_TRACE();
+
+		this->timer->Destroy();
+	}
+
+	void KeyFrameRequestManager::AddStream(uint32_t ssrc, bool usePli, bool useFir)
+	{
+		MS_TRACE();
+
+		auto& stream = this->streams[ssrc];
+
+		stream.usePli = usePli;
+		stream.useFir = useFir;
+	}
+
+	void KeyFrameRequestManager::SetRtt(uint32_t ssrc, uint32_t rtt)
+	{
+		MS_TRACE();
+
+		auto it = this->streams.find(ssrc);
+
+		if (it == this->streams.end())
+			return;
+
+		it->second.rtt = rtt;
+	}
+
+	/**
+	 * A key frame is needed in the given stream. It is requested right now unless
+	 * another request was sent within the stream min interval, in which case it
+	 * is sent once the interval expires. If 'force' is set the request is sent
+	 * right now anyway.
+	 */
+	void KeyFrameRequestManager::KeyFrameNeeded(uint32_t ssrc, bool force)
+	{
+		MS_TRACE();
+
+		auto it = this->streams.find(ssrc);
+
+		if (it == this->streams.end())
+			return;
+
+		auto& stream = it->second;
+
+		stream.requestCount++;
+
+		if (!stream.usePli && !stream.useFir)
+			return;
+
+		auto now = DepLibUV::GetTime();
+
+		if (force || stream.lastSentAt == 0 || now - stream.lastSentAt >= GetRequestInterval(stream))
+		{
+			SendRequest(ssrc, stream, now);
+
+			return;
+		}
+
+		MS_DEBUG_2TAGS(rtcp, rtx, "coalescing key frame request [ssrc:%" PRIu32 "]", ssrc);
+
+		stream.coalescedCount++;
+
+		if (!stream.pending)
+		{
+			stream.pending = true;
+
+			MayRunTimer(now);
+		}
+	}
+
+	void KeyFrameRequestManager::KeyFrameReceived(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		auto it = this->streams.find(ssrc);
+
+		if (it == this->streams.end())
+			return;
+
+		auto& stream = it->second;
+
+		stream.keyFrameReceived = true;
+
+		if (stream.waitingForKeyFrame || stream.pending)
+			stream.servedCount++;
+
+		// A pending request is also satisfied by this key frame.
+		stream.waitingForKeyFrame = false;
+		stream.pending            = false;
+	}
+
+	Json::Value KeyFrameRequestManager::GetStats(uint32_t ssrc) const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringRequestCount{ "requestCount" };
+		static const Json::StaticString JsonStringCoalescedCount{ "coalescedCount" };
+		static const Json::StaticString JsonStringServedCount{ "servedCount" };
+		static const Json::StaticString JsonStringRequestInterval{ "requestInterval" };
+
+		Json::Value json(Json::objectValue);
+
+		auto it = this->streams.find(ssrc);
+
+		if (it == this->streams.end())
+			return json;
+
+		auto& stream = it->second;
+
+		json[JsonStringRequestCount]    = static_cast<Json::UInt>(stream.requestCount);
+		json[JsonStringCoalescedCount]  = static_cast<Json::UInt>(stream.coalescedCount);
+		json[JsonStringServedCount]     = static_cast<Json::UInt>(stream.servedCount);
+		json[JsonStringRequestInterval] = static_cast<Json::UInt>(GetRequestInterval(stream));
+
+		return json;
+	}
+
+	/**
+	 * FIR is used if the stream does not support PLI, has not produced any key
+	 * frame yet, or did not answer the previous request. Otherwise PLI is used.
+	 */
+	void KeyFrameRequestManager::SendRequest(uint32_t ssrc, StreamState& stream, uint64_t now)
+	{
+		MS_TRACE();
+
+		bool useFir =
+		  stream.useFir && (!stream.usePli || !stream.keyFrameReceived || stream.waitingForKeyFrame);
+
+		stream.lastSentAt         = now;
+		stream.pending            = false;
+		stream.waitingForKeyFrame = true;
+
+		if (useFir)
+			this->listener->OnKeyFrameRequestManagerSendFir(this, ssrc, stream.firSeqNumber++);
+		else
+			this->listener->OnKeyFrameRequestManagerSendPli(this, ssrc);
+	}
+
+	void KeyFrameRequestManager::MayRunTimer(uint64_t now)
+	{
+		MS_TRACE();
+
+		uint64_t timeout{ 0 };
+
+		for (auto& kv : this->streams)
+		{
+			auto& stream = kv.second;
+
+			if (!stream.pending)
+				continue;
+
+			auto sendAt        = stream.lastSentAt + GetRequestInterval(stream);
+			uint64_t remaining = sendAt > now ? sendAt - now : 1;
+
+			if (timeout == 0 || remaining < timeout)
+				timeout = remaining;
+		}
+
+		if (timeout != 0)
+			this->timer->Start(timeout);
+		else
+			this->timer->Stop();
+	}
+
+	inline void KeyFrameRequestManager::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		auto now = DepLibUV::GetTime();
+
+		for (auto& kv : this->streams)
+		{
+			auto ssrc    = kv.first;
+			auto& stream = kv.second;
+
+			if (stream.pending && now - stream.lastSentAt >= GetRequestInterval(stream))
+			{
+				MS_DEBUG_2TAGS(
+				  rtcp, rtx, "sending coalesced key frame request [ssrc:%" PRIu32 "]", ssrc);
+
+				SendRequest(ssrc, stream, now);
+			}
+		}
+
+		MayRunTimer(now);
+	}
+} // namespace RTC
@@ -0,0 +1,36 @@
+#define MS_CLASS "RTC::LastN"
+// #define MS_LOG_DEV
+
+#include "RTC/LastN.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	bool LastN::Forward(uint32_t producerId, uint32_t transportId)
+	{
+		MS_TRACE();
+
+		auto it = this->limits.find(transportId);
+
+		// No Last-N in this Transport.
+		if (it == this->limits.end())
+			return true;
+
+		auto& selection = this->selections[transportId];
+
+		// Same decision for another Consumer of the same Producer.
+		if (selection.hasProducer && selection.producerId == producerId)
+			return selection.forward;
+
+		selection.producerId  = producerId;
+		selection.hasProducer = true;
+		selection.forward     = selection.forwarded < it->second;
+
+		if (selection.forward)
+			selection.forwarded++;
+
+		return selection.forward;
+	}
+} // namespace RTC
@@ -0,0 +1,105 @@
+#define MS_CLASS "RTC::LatencyHistogram"
+// #define MS_LOG_DEV
+
+#include "RTC/LatencyHistogram.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::min()
+#include <cstring>   // std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	inline static size_t getBucket(uint64_t value)
+	{
+		size_t bucket{ 0 };
+
+		while (value > 1 && bucket < LatencyHistogram::NumBuckets - 1)
+		{
+			value >>= 1;
+			bucket++;
+		}
+
+		return bucket;
+	}
+
+	/* Instance methods. */
+
+	void LatencyHistogram::Add(uint64_t value)
+	{
+		MS_TRACE();
+
+		this->buckets[getBucket(value)]++;
+		this->count++;
+		this->sum += value;
+
+		if (value > this->max)
+			this->max = value;
+	}
+
+	/**
+	 * Upper bound of the bucket containing the given percentile (capped by the
+	 * max value seen).
+	 */
+	uint64_t LatencyHistogram::GetPercentile(uint8_t percentile) const
+	{
+		MS_TRACE();
+
+		if (this->count == 0)
+			return 0;
+
+		uint64_t threshold = (this->count * std::min(percentile, uint8_t{ 100 }) + 99) / 100;
+		uint64_t accumulated{ 0 };
+
+		for (size_t bucket = 0; bucket < NumBuckets - 1; ++bucket)
+		{
+			accumulated += this->buckets[bucket];
+
+			if (accumulated >= threshold && accumulated != 0)
+				return std::min((uint64_t{ 2 } << bucket) - 1, this->max);
+		}
+
+		// The last bucket has no upper bound.
+		return this->max;
+	}
+
+	void LatencyHistogram::Reset()
+	{
+		MS_TRACE();
+
+		std::memset(this->buckets, 0, sizeof(this->buckets));
+		this->count = 0;
+		this->sum   = 0;
+		this->max   = 0;
+	}
+
+	Json::Value LatencyHistogram::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringCount{ "count" };
+		static const Json::StaticString JsonStringAvg{ "avg" };
+		static const Json::StaticString JsonStringMax{ "max" };
+		static const Json::StaticString JsonStringP50{ "p50" };
+		static const Json::StaticString JsonStringP99{ "p99" };
+		static const Json::StaticString JsonStringBuckets{ "buckets" };
+
+		Json::Value json(Json::objectValue);
+		Json::Value jsonBuckets(Json::arrayValue);
+
+		json[JsonStringCount] = static_cast<Json::UInt64>(this->count);
+		json[JsonStringAvg] =
+		  this->count != 0 ? static_cast<Json::UInt64>(this->sum / this->count) : Json::UInt64{ 0 };
+		json[JsonStringMax] = static_cast<Json::UInt64>(this->max);
+		json[JsonStringP50] = static_cast<Json::UInt64>(GetPercentile(50));
+		json[JsonStringP99] = static_cast<Json::UInt64>(GetPercentile(99));
+
+		for (auto bucket : this->buckets)
+		{
+			jsonBuckets.append(static_cast<Json::UInt64>(bucket));
+		}
+		json[JsonStringBuckets] = jsonBuckets;
+
+		return json;
+	}
+} // namespace RTC
@@ -4,13 +4,12 @@
 #include "RTC/NackGenerator.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
-#include <utility> // std::make_pair()
 
 namespace RTC
 {
 	/* Static. */
 
-	constexpr size_t MaxPacketAge{ 5000 };
+	constexpr uint16_t MaxPacketAge{ 5000 };
 	constexpr size_t MaxNackPackets{ 1000 };
 	constexpr uint32_t DefaultRtt{ 100 };
 	constexpr uint8_t MaxNackRetries{ 8 };
@@ -22,6 +21,13 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		static_assert(MaxPacketAge < NackRingSize, "NackRingSize must be bigger than MaxPacketAge");
+
+		std::memset(this->nackBitmap, 0, sizeof(this->nackBitmap));
+
+		// A NACK batch never contains more items than packets in the NACK list.
+		this->nackBatch.reserve(MaxNackPackets);
+
 		// Set the timer.
 		this->timer = new Timer(this);
 	}
@@ -48,7 +54,10 @@ namespace RTC
 			this->started = true;
 
 			if (isKeyFrame)
-				this->keyFrameList.insert(seq);
+			{
+				this->hasKeyFrame = true;
+				this->keyFrameSeq = seq;
+			}
 
 			return false;
 		}
@@ -61,10 +70,12 @@ namespace RTC
 		// or a retransmitted packet.
 		if (SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq))
 		{
-			auto it = this->nackList.find(seq);
+			// Items in the NACK list are never older than MaxPacketAge, so a packet
+			// older than that would just be aliasing the ring slot of another seq.
+			uint16_t age = this->lastSeq - seq;
 
 			// It was a nacked packet.
-			if (it != this->nackList.end())
+			if (age <= MaxPacketAge && IsInNackList(seq))
 			{
 				MS_DEBUG_TAG(
 				  rtx,
@@ -72,7 +83,8 @@ namespace RTC
 				  packet->GetSsrc(),
 				  packet->GetSequenceNumber());
 
-				this->nackList.erase(it);
+				SetInNackList(seq, false);
+				this->nackListLength--;
 
 				return true;
 			}
@@ -98,7 +110,8 @@ namespace RTC
 		{
 			RemoveNackItemsUntilKeyFrame();
 
-			this->keyFrameList.insert(seq);
+			this->hasKeyFrame = true;
+			this->keyFrameSeq = seq;
 		}
 
 		// Expected seq number so nothing else to do.
@@ -118,27 +131,79 @@ namespace RTC
 		this->lastSeq = seq;
 
 		// Check if there are any nacks that are waiting for this seq number.
-		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::SEQ);
+		GetNackBatch(NackFilter::SEQ);
 
-		if (!nackBatch.empty())
-			this->listener->OnNackGeneratorNackRequired(nackBatch);
+		if (!this->nackBatch.empty())
+			this->listener->OnNackGeneratorNackRequired(this->nackBatch);
 
 		MayRunTimer();
 
 		return false;
 	}
 
+	/**
+	 * Packets requested by downstream receivers. The ones still missing which
+	 * were not NACKed within the last RTT are NACKed right away, so a single
+	 * upstream request serves all the receivers.
+	 */
+	void NackGenerator::RequestPackets(const std::vector<uint16_t>& seqs)
+	{
+		MS_TRACE();
+
+		if (!this->started || this->nackListLength == 0)
+			return;
+
+		uint64_t now = DepLibUV::GetTime();
+
+		this->nackBatch.clear();
+
+		for (auto seq : seqs)
+		{
+			uint16_t age = this->lastSeq - seq;
+
+			// See ReceivePacket().
+			if (!SeqManager<uint16_t>::IsSeqLowerThan(seq, this->lastSeq) || age > MaxPacketAge)
+				continue;
+
+			if (!IsInNackList(seq))
+				continue;
+
+			size_t slot = seq % NackRingSize;
+
+			// Already NACKed within the last RTT.
+			if (this->sentAtTime[slot] != 0 && this->sentAtTime[slot] + this->rtt >= now)
+				continue;
+
+			AddToNackBatch(seq, now);
+		}
+
+		if (!this->nackBatch.empty())
+			this->listener->OnNackGeneratorNackRequired(this->nackBatch);
+
+		MayRunTimer();
+	}
+
 	void NackGenerator::CleanOldNackItems(uint16_t seq)
 	{
 		MS_TRACE();
 
-		auto it = this->nackList.lower_bound(seq - MaxPacketAge);
+		uint16_t oldestAllowedSeq = seq - MaxPacketAge;
+		uint16_t seqLimit         = oldestAllowedSeq;
 
-		this->nackList.erase(this->nackList.begin(), it);
+		if (
+		  this->nackListLength != 0 && SeqManager<uint16_t>::IsSeqLowerThan(this->oldestSeq, seqLimit))
+		{
+			// Every item in the NACK list is lower than lastSeq.
+			if (SeqManager<uint16_t>::IsSeqHigherThan(seqLimit, this->lastSeq))
+				seqLimit = this->lastSeq;
 
-		auto it2 = this->keyFrameList.lower_bound(seq - MaxPacketAge);
+			RemoveNackItems(this->oldestSeq, seqLimit);
+		}
 
-		this->keyFrameList.erase(this->keyFrameList.begin(), it2);
+		if (
+		  this->hasKeyFrame &&
+		  SeqManager<uint16_t>::IsSeqLowerThan(this->keyFrameSeq, oldestAllowedSeq))
+			this->hasKeyFrame = false;
 	}
 
 	void NackGenerator::AddPacketsToNackList(uint16_t seqStart, uint16_t seqEnd)
@@ -148,31 +213,40 @@ namespace RTC
 		// If the nack list is too large, clear it and request a key frame.
 		uint16_t numNewNacks = seqEnd - seqStart;
 
-		if (this->nackList.size() + numNewNacks > MaxNackPackets)
+		if (this->nackListLength + numNewNacks > MaxNackPackets)
 		{
 			MS_DEBUG_TAG(
 			  rtx,
 			  "NACK list too large, clearing it and requesting a key frame [seqEnd:%" PRIu16 "]",
 			  seqEnd);
 
-			this->nackList.clear();
-			this->keyFrameList.clear();
+			std::memset(this->nackBitmap, 0, sizeof(this->nackBitmap));
+			this->nackListLength = 0;
+			this->hasKeyFrame    = false;
 			this->listener->OnNackGeneratorKeyFrameRequired();
 
 			return;
 		}
 
+		if (this->nackListLength == 0)
+			this->oldestSeq = seqStart;
+
 		for (uint16_t seq = seqStart; seq != seqEnd; ++seq)
 		{
-			MS_ASSERT(this->nackList.find(seq) == this->nackList.end(), "packet already in the NACK list");
+			MS_ASSERT(!IsInNackList(seq), "packet already in the NACK list");
+
+			size_t slot = seq % NackRingSize;
 
 			// NOTE: We may not generate a NACK for this seq right now, but wait a bit
 			// assuming that this packet may be in its way.
 			// TODO: To be done.
-			uint16_t sendAtSeq = seq + 0;
+			this->sentAtTime[slot] = 0;
+			this->retries[slot]    = 0;
 
-			this->nackList.emplace(std::make_pair(seq, NackInfo{ seq, sendAtSeq }));
+			SetInNackList(seq, true);
 		}
+
+		this->nackListLength += numNewNacks;
 	}
 
 	void NackGenerator::RemoveNackItemsUntilKeyFrame()
@@ -180,18 +254,18 @@ namespace RTC
 		MS_TRACE();
 
 		// No previous key frame, so do nothing.
-		if (this->keyFrameList.empty())
+		if (!this->hasKeyFrame)
 			return;
 
-		auto it               = this->keyFrameList.begin();
-		auto seq              = *it;
-		size_t numItemsBefore = this->nackList.size();
-		auto it2              = this->nackList.lower_bound(seq);
+		auto seq              = this->keyFrameSeq;
+		size_t numItemsBefore = this->nackListLength;
 
-		this->nackList.erase(this->nackList.begin(), it2);
-		this->keyFrameList.erase(seq);
+		if (this->nackListLength != 0 && SeqManager<uint16_t>::IsSeqLowerThan(this->oldestSeq, seq))
+			RemoveNackItems(this->oldestSeq, seq);
 
-		size_t numItemsRemoved = numItemsBefore - this->nackList.size();
+		this->hasKeyFrame = false;
+
+		size_t numItemsRemoved = numItemsBefore - this->nackListLength;
 
 		if (numItemsRemoved > 0)
 		{
@@ -203,76 +277,131 @@ namespace RTC
 		}
 	}
 
-	std::vector<uint16_t> NackGenerator::GetNackBatch(NackFilter filter)
+	// Removes the items in the [seqStart, seqEnd) range, being seqStart the
+	// lower bound of the NACK list.
+	void NackGenerator::RemoveNackItems(uint16_t seqStart, uint16_t seqEnd)
 	{
 		MS_TRACE();
 
-		uint64_t now = DepLibUV::GetTime();
-		std::vector<uint16_t> nackBatch;
-		auto it = this->nackList.begin();
+		for (uint16_t seq = GetNextNackSeq(seqStart, seqEnd); seq != seqEnd;
+		     seq = GetNextNackSeq(seq + 1, seqEnd))
+		{
+			SetInNackList(seq, false);
+			this->nackListLength--;
+		}
+
+		this->oldestSeq = seqEnd;
+	}
 
-		while (it != this->nackList.end())
+	// Fills the NACK batch with NACK items ready to be sent.
+	void NackGenerator::GetNackBatch(NackFilter filter)
+	{
+		MS_TRACE();
+
+		this->nackBatch.clear();
+
+		if (this->nackListLength == 0)
+			return;
+
+		uint64_t now      = DepLibUV::GetTime();
+		bool oldestSeqSet = false;
+
+		for (uint16_t seq = GetNextNackSeq(this->oldestSeq, this->lastSeq); seq != this->lastSeq;
+		     seq = GetNextNackSeq(seq + 1, this->lastSeq))
 		{
-			NackInfo& nackInfo = it->second;
-			uint16_t seq       = nackInfo.seq;
+			size_t slot = seq % NackRingSize;
 
 			if (
-			  filter == NackFilter::SEQ && nackInfo.sentAtTime == 0 &&
-			  SeqManager<uint16_t>::IsSeqHigherThan(this->lastSeq, nackInfo.sendAtSeq))
+			  (filter == NackFilter::SEQ && this->sentAtTime[slot] == 0) ||
+			  (filter == NackFilter::TIME && this->sentAtTime[slot] + this->rtt < now))
 			{
-				nackInfo.retries++;
-				nackInfo.sentAtTime = now;
-
-				if (nackInfo.retries >= MaxNackRetries)
-				{
-					MS_WARN_TAG(
-					  rtx,
-					  "sequence number removed from the NACK list due to max retries [seq:%" PRIu16 "]",
-					  seq);
-
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					nackBatch.emplace_back(seq);
-					++it;
-				}
+				if (!AddToNackBatch(seq, now))
+					continue;
+			}
 
-				continue;
+			// Move the lower bound of the NACK list up to the first alive item.
+			if (!oldestSeqSet)
+			{
+				this->oldestSeq = seq;
+				oldestSeqSet    = true;
 			}
+		}
+	}
+
+	// Appends the given seq (which must be in the NACK list) to the NACK batch.
+	// Returns false if it was removed from the NACK list instead.
+	bool NackGenerator::AddToNackBatch(uint16_t seq, uint64_t now)
+	{
+		MS_TRACE();
+
+		size_t slot = seq % NackRingSize;
+
+		this->retries[slot]++;
+		this->sentAtTime[slot] = now;
+
+		if (this->retries[slot] >= MaxNackRetries)
+		{
+			MS_WARN_TAG(
+			  rtx, "sequence number removed from the NACK list due to max retries [seq:%" PRIu16 "]", seq);
+
+			SetInNackList(seq, false);
+			this->nackListLength--;
 
-			if (filter == NackFilter::TIME && nackInfo.sentAtTime + this->rtt < now)
+			return false;
+		}
+
+		// Append the seq to the last NACK item if it fits into its bitmask.
+		if (!this->nackBatch.empty())
+		{
+			auto& nackItem = this->nackBatch.back();
+			uint16_t shift = seq - nackItem.packetId - 1;
+
+			if (shift <= 15)
 			{
-				nackInfo.retries++;
-				nackInfo.sentAtTime = now;
-
-				if (nackInfo.retries >= MaxNackRetries)
-				{
-					MS_WARN_TAG(
-					  rtx,
-					  "sequence number removed from the NACK list due to max retries [seq:%" PRIu16 "]",
-					  seq);
-
-					it = this->nackList.erase(it);
-				}
-				else
-				{
-					nackBatch.emplace_back(seq);
-					++it;
-				}
+				nackItem.lostPacketBitmask |= (1 << shift);
+
+				return true;
+			}
+		}
+
+		this->nackBatch.emplace_back();
+		this->nackBatch.back().packetId = seq;
+
+		return true;
+	}
+
+	// Returns the first seq in the NACK list within the [seq, seqEnd) range, or
+	// seqEnd if none. Empty 64 bits words of the bitmap are skipped at once.
+	uint16_t NackGenerator::GetNextNackSeq(uint16_t seq, uint16_t seqEnd) const
+	{
+		while (seq != seqEnd)
+		{
+			size_t slot    = seq % NackRingSize;
+			uint64_t word  = this->nackBitmap[slot / 64] >> (slot % 64);
+			uint16_t steps = 64 - (slot % 64);
+
+			if (word == 0)
+			{
+				if (static_cast<uint16_t>(seqEnd - seq) <= steps)
+					return seqEnd;
+
+				seq += steps;
 
 				continue;
 			}
 
-			++it;
+			if ((word & 1) != 0)
+				return seq;
+
+			++seq;
 		}
 
-		return nackBatch;
+		return seqEnd;
 	}
 
 	inline void NackGenerator::MayRunTimer() const
 	{
-		if (!this->nackList.empty())
+		if (this->nackListLength != 0)
 			this->timer->Start(TimerInterval);
 	}
 
@@ -280,10 +409,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		std::vector<uint16_t> nackBatch = GetNackBatch(NackFilter::TIME);
+		GetNackBatch(NackFilter::TIME);
 
-		if (!nackBatch.empty())
-			this->listener->OnNackGeneratorNackRequired(nackBatch);
+		if (!this->nackBatch.empty())
+			this->listener->OnNackGeneratorNackRequired(this->nackBatch);
 
 		MayRunTimer();
 	}
@@ -0,0 +1,12 @@
+#define MS_CLASS "RTC::PacketLatency"
+// #define MS_LOG_DEV
+
+#include "RTC/PacketLatency.hpp"
+
+namespace RTC
+{
+	/* Class variables. */
+
+	uint32_t PacketLatency::packetCount{ 0 };
+	uint64_t PacketLatency::ingressTime{ 0 };
+} // namespace RTC
@@ -122,8 +122,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		static const Json::StaticString JsonStringCpuTime{ "cpuTime" };
+		static const Json::StaticString JsonStringCpuUsage{ "cpuUsage" };
+
 		Json::Value json(Json::objectValue);
 
+		json[JsonStringCpuTime]  = Json::UInt64{ this->cpuUsage.GetTime() };
+		json[JsonStringCpuUsage] = Json::UInt{ this->cpuUsage.GetRate(DepLibUV::GetTime()) };
+
 		return json;
 	}
 
@@ -183,6 +189,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		if (!IsConnected())
 			return;
 
@@ -200,6 +208,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		if (!IsConnected())
 			return;
 
@@ -221,6 +231,22 @@ namespace RTC
 			this->udpSocket = new RTC::UdpSocket(this, localIP);
 	}
 
+	size_t PlainRtpTransport::GetRecvBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetRecvBytes();
+	}
+
+	size_t PlainRtpTransport::GetSentBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetSentBytes();
+	}
+
 	bool PlainRtpTransport::IsConnected() const
 	{
 		return this->tuple != nullptr;
@@ -268,6 +294,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		// Mirror RTP if needed.
 		if (this->mirrorTuple != nullptr && this->mirroringOptions.recvRtp)
 			this->mirrorTuple->Send(data, len);
@@ -296,6 +324,17 @@ namespace RTC
 			packet->AddExtensionMapping(
 			  RtpHeaderExtensionUri::Type::RTP_STREAM_ID, this->headerExtensionIds.rid);
 		}
+		if (this->headerExtensionIds.frameMarking != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::FRAME_MARKING, this->headerExtensionIds.frameMarking);
+		}
+		if (this->headerExtensionIds.dependencyDescriptor != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR,
+			  this->headerExtensionIds.dependencyDescriptor);
+		}
 
 		// Get the associated Producer.
 		RTC::Producer* producer = this->rtpListener.GetProducer(packet);
@@ -329,6 +368,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		// Mirror RTCP if needed.
 		if (this->mirrorTuple != nullptr && this->mirroringOptions.recvRtcp)
 			this->mirrorTuple->Send(data, len);
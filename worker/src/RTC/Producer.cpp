@@ -2,8 +2,11 @@
 // #define MS_LOG_DEV
 
 #include "RTC/Producer.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
+#include "RTC/Codecs/Codecs.hpp"
+#include "RTC/RTCP/FeedbackPsFir.hpp"
 #include "RTC/RTCP/FeedbackPsPli.hpp"
 #include "RTC/RTCP/FeedbackRtp.hpp"
 #include "RTC/RTCP/FeedbackRtpNack.hpp"
@@ -13,7 +16,6 @@ namespace RTC
 	/* Static. */
 
 	static uint8_t ClonedPacketBuffer[RTC::RtpBufferSize];
-	static constexpr uint64_t KeyFrameRequestBlockTimeout{ 1000 }; // In ms.
 
 	/* Instance methods. */
 
@@ -41,8 +43,8 @@ namespace RTC
 		else
 			this->maxRtcpInterval = RTC::RTCP::MaxVideoIntervalMs;
 
-		// Set the RTP key frame request block timer.
-		this->keyFrameRequestBlockTimer = new Timer(this);
+		// Set the key frame request manager.
+		this->keyFrameRequestManager = new RTC::KeyFrameRequestManager(this);
 	}
 
 	Producer::~Producer()
@@ -56,7 +58,10 @@ namespace RTC
 			auto* rtpStream = info.rtpStream;
 
 			delete rtpStream;
+			delete info.keyFrameCache;
 		}
+
+		delete this->keyFrameRequestManager;
 	}
 
 	void Producer::Destroy()
@@ -68,9 +73,6 @@ namespace RTC
 			listener->OnProducerClosed(this);
 		}
 
-		// Close the RTP key frame request block timer.
-		this->keyFrameRequestBlockTimer->Destroy();
-
 		delete this;
 	}
 
@@ -175,6 +177,7 @@ namespace RTC
 		MS_TRACE();
 
 		static const Json::StaticString JsonStringTransportId{ "transportId" };
+		static const Json::StaticString JsonStringKeyFrameRequests{ "keyFrameRequests" };
 
 		Json::Value json(Json::arrayValue);
 
@@ -187,12 +190,43 @@ namespace RTC
 			if (this->transport != nullptr)
 				jsonRtpStream[JsonStringTransportId] = this->transport->transportId;
 
+			if (this->kind == RTC::Media::Kind::VIDEO)
+			{
+				jsonRtpStream[JsonStringKeyFrameRequests] =
+				  this->keyFrameRequestManager->GetStats(rtpStream->GetSsrc());
+			}
+
 			json.append(jsonRtpStream);
 		}
 
 		return json;
 	}
 
+	void Producer::FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapSsrcRtpStreamInfo)
+		{
+			auto* rtpStream = kv.second.rtpStream;
+			RTC::StatsSnapshot::Record record;
+
+			record.type         = RTC::StatsSnapshot::RecordType::PRODUCER_STREAM;
+			record.id           = this->producerId;
+			record.ssrc         = rtpStream->GetSsrc();
+			record.fractionLost = rtpStream->fractionLost;
+			record.bitrate      = rtpStream->transmissionCounter.GetRate(now);
+			record.packetCount  = rtpStream->transmissionCounter.GetPacketCount();
+			record.byteCount    = rtpStream->transmissionCounter.GetBytes();
+			record.packetsLost  = rtpStream->packetsLost;
+			record.nackCount    = static_cast<uint32_t>(rtpStream->nackCount);
+			record.pliCount     = static_cast<uint32_t>(rtpStream->pliCount);
+			record.firCount     = static_cast<uint32_t>(rtpStream->firCount);
+
+			snapshot.AddRecord(record);
+		}
+	}
+
 	void Producer::Pause()
 	{
 		MS_TRACE();
@@ -204,6 +238,15 @@ namespace RTC
 
 		MS_DEBUG_DEV("Producer paused [producerId:%" PRIu32 "]", this->producerId);
 
+		// Cached packets will not be followed by the ones received after resuming.
+		for (auto& kv : this->mapSsrcRtpStreamInfo)
+		{
+			auto& info = kv.second;
+
+			if (info.keyFrameCache != nullptr)
+				info.keyFrameCache->Reset();
+		}
+
 		for (auto& listener : this->listeners)
 		{
 			listener->OnProducerPaused(this);
@@ -244,6 +287,7 @@ namespace RTC
 		// Find the corresponding RtpStreamRecv.
 		uint32_t ssrc = packet->GetSsrc();
 		RTC::RtpStreamRecv* rtpStream{ nullptr };
+		RTC::KeyFrameCache* keyFrameCache{ nullptr };
 		RTC::RtpEncodingParameters::Profile profile;
 		std::unique_ptr<RTC::RtpPacket> clonedPacket;
 
@@ -252,9 +296,10 @@ namespace RTC
 		{
 			rtpStream = this->mapSsrcRtpStreamInfo[ssrc].rtpStream;
 
-			auto& info = this->mapSsrcRtpStreamInfo[ssrc];
-			rtpStream  = info.rtpStream;
-			profile    = info.profile;
+			auto& info    = this->mapSsrcRtpStreamInfo[ssrc];
+			rtpStream     = info.rtpStream;
+			keyFrameCache = info.keyFrameCache;
+			profile       = info.profile;
 
 			// Let's clone the RTP packet so we can mangle the payload (if needed) and other
 			// stuff that would change its size.
@@ -274,8 +319,9 @@ namespace RTC
 
 				if (info.rtxSsrc != 0u && info.rtxSsrc == ssrc)
 				{
-					rtpStream = info.rtpStream;
-					profile   = info.profile;
+					rtpStream     = info.rtpStream;
+					keyFrameCache = info.keyFrameCache;
+					profile       = info.profile;
 
 					// Let's clone the RTP packet so we can mangle the payload (if needed) and
 					// other stuff that would change its size.
@@ -302,9 +348,10 @@ namespace RTC
 			return;
 		}
 
-		// TODO: Remove this, it's CPU consuming and provides nothing.
-		if (packet->IsKeyFrame())
+		if (this->kind == RTC::Media::Kind::VIDEO && packet->IsKeyFrame())
 		{
+			this->keyFrameRequestManager->KeyFrameReceived(rtpStream->GetSsrc());
+
 			MS_DEBUG_TAG(
 			  rtp,
 			  "key frame received [ssrc:%" PRIu32 ", seq:%" PRIu16 ", profile:%s]",
@@ -321,6 +368,9 @@ namespace RTC
 		// dispatching the packet.
 		ApplyRtpMapping(packet);
 
+		if (keyFrameCache != nullptr)
+			keyFrameCache->ReceivePacket(packet, DepLibUV::GetTime());
+
 		for (auto& listener : this->listeners)
 		{
 			listener->OnProducerRtpPacket(this, packet, profile);
@@ -384,34 +434,114 @@ namespace RTC
 		if (this->kind != RTC::Media::Kind::VIDEO || this->paused)
 			return;
 
-		if (force)
+		for (auto& kv : this->mapSsrcRtpStreamInfo)
 		{
-			// Stop the timer.
-			this->keyFrameRequestBlockTimer->Stop();
+			auto& info      = kv.second;
+			auto* rtpStream = info.rtpStream;
+
+			// The KeyFrameRequestManager coalesces the requests of each stream.
+			rtpStream->RequestKeyFrame(force);
 		}
-		else if (this->keyFrameRequestBlockTimer->IsActive())
-		{
-			MS_DEBUG_2TAGS(rtcp, rtx, "blocking key frame request due to flood protection");
+	}
 
-			// Set flag.
-			this->isKeyFrameRequested = true;
+	/**
+	 * Request a key frame just in the streams of the given profile (i.e. the
+	 * target profile of a Consumer switching to it). If there is no such stream,
+	 * request it in all the streams. The RTT of the requesting receiver (if
+	 * known) sets the min interval between requests of those streams.
+	 */
+	void Producer::RequestKeyFrame(RTC::RtpEncodingParameters::Profile profile, uint32_t rtt)
+	{
+		MS_TRACE();
 
+		if (this->kind != RTC::Media::Kind::VIDEO || this->paused)
 			return;
-		}
 
-		// Run the timer.
-		this->keyFrameRequestBlockTimer->Start(KeyFrameRequestBlockTimeout);
+		bool found{ false };
 
 		for (auto& kv : this->mapSsrcRtpStreamInfo)
 		{
 			auto& info      = kv.second;
 			auto* rtpStream = info.rtpStream;
 
-			rtpStream->RequestKeyFrame();
+			if (info.profile == profile)
+			{
+				found = true;
+
+				if (rtt != 0)
+					this->keyFrameRequestManager->SetRtt(kv.first, rtt);
+
+				rtpStream->RequestKeyFrame();
+			}
 		}
 
-		// Reset flag.
-		this->isKeyFrameRequested = false;
+		if (found)
+			return;
+
+		if (rtt != 0)
+		{
+			for (auto& kv : this->mapSsrcRtpStreamInfo)
+			{
+				this->keyFrameRequestManager->SetRtt(kv.first, rtt);
+			}
+		}
+
+		RequestKeyFrame();
+	}
+
+	/**
+	 * Packets missing in some Consumer for the given profile. Let the NACK
+	 * generator of the corresponding stream ask the sender for them.
+	 */
+	void Producer::RequestRtpRetransmission(
+	  RTC::RtpEncodingParameters::Profile profile, const std::vector<uint16_t>& seqs)
+	{
+		MS_TRACE();
+
+		if (this->paused)
+			return;
+
+		for (auto& kv : this->mapSsrcRtpStreamInfo)
+		{
+			auto& info = kv.second;
+
+			if (info.profile != profile)
+				continue;
+
+			info.rtpStream->RequestRtpRetransmission(seqs);
+
+			break;
+		}
+	}
+
+	/**
+	 * Returns the key frame cache of the stream with the given profile if it can
+	 * be used to start a new receiver, nullptr otherwise.
+	 */
+	const RTC::KeyFrameCache* Producer::GetKeyFrameCache(
+	  RTC::RtpEncodingParameters::Profile profile) const
+	{
+		MS_TRACE();
+
+		if (this->paused)
+			return nullptr;
+
+		uint64_t now = DepLibUV::GetTime();
+
+		for (auto& kv : this->mapSsrcRtpStreamInfo)
+		{
+			auto& info = kv.second;
+
+			if (info.profile != profile)
+				continue;
+
+			if (info.keyFrameCache != nullptr && info.keyFrameCache->IsValid(now))
+				return info.keyFrameCache;
+
+			return nullptr;
+		}
+
+		return nullptr;
 	}
 
 	void Producer::FillHeaderExtensionIds()
@@ -423,6 +553,8 @@ namespace RTC
 		uint8_t absSendTimeId{ 0 };
 		uint8_t midId{ 0 };
 		uint8_t ridId{ 0 };
+		uint8_t frameMarkingId{ 0 };
+		uint8_t dependencyDescriptorId{ 0 };
 
 		for (auto& exten : this->rtpParameters.headerExtensions)
 		{
@@ -470,6 +602,32 @@ namespace RTC
 				this->headerExtensionIds.rid          = ridId;
 				this->transportHeaderExtensionIds.rid = exten.id;
 			}
+
+			if (
+			  this->kind == RTC::Media::Kind::VIDEO && (frameMarkingId == 0u) &&
+			  exten.type == RTC::RtpHeaderExtensionUri::Type::FRAME_MARKING)
+			{
+				if (idMapping.find(exten.id) != idMapping.end())
+					frameMarkingId = idMapping[exten.id];
+				else
+					frameMarkingId = exten.id;
+
+				this->headerExtensionIds.frameMarking          = frameMarkingId;
+				this->transportHeaderExtensionIds.frameMarking = exten.id;
+			}
+
+			if (
+			  this->kind == RTC::Media::Kind::VIDEO && (dependencyDescriptorId == 0u) &&
+			  exten.type == RTC::RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR)
+			{
+				if (idMapping.find(exten.id) != idMapping.end())
+					dependencyDescriptorId = idMapping[exten.id];
+				else
+					dependencyDescriptorId = exten.id;
+
+				this->headerExtensionIds.dependencyDescriptor          = dependencyDescriptorId;
+				this->transportHeaderExtensionIds.dependencyDescriptor = exten.id;
+			}
 		}
 	}
 
@@ -555,6 +713,7 @@ namespace RTC
 		auto& codec = this->rtpParameters.GetCodecForEncoding(encoding);
 		bool useNack{ false };
 		bool usePli{ false };
+		bool useFir{ false };
 		bool useRemb{ false };
 
 		for (auto& fb : codec.rtcpFeedback)
@@ -571,6 +730,12 @@ namespace RTC
 
 				usePli = true;
 			}
+			else if (!useFir && fb.type == "ccm" && fb.parameter == "fir")
+			{
+				MS_DEBUG_TAG(rtcp, "FIR supported");
+
+				useFir = true;
+			}
 			else if (!useRemb && fb.type == "goog-remb")
 			{
 				MS_DEBUG_TAG(rbe, "REMB supported");
@@ -588,6 +753,7 @@ namespace RTC
 		params.clockRate   = codec.clockRate;
 		params.useNack     = useNack;
 		params.usePli      = usePli;
+		params.useFir      = useFir;
 
 		// Create a RtpStreamRecv for receiving a media stream.
 		auto* rtpStream = new RTC::RtpStreamRecv(this, params);
@@ -597,6 +763,12 @@ namespace RTC
 
 		info.rtpStream = rtpStream;
 		info.rid       = encoding.encodingId;
+
+		// Cache the latest key frame so new Consumers can start without requesting
+		// a key frame to the sender.
+		if (Codecs::CanBeKeyFrame(codec.mimeType))
+			info.keyFrameCache = new RTC::KeyFrameCache(codec.mimeType);
+
 		info.profile   = encoding.profile;
 		info.rtxSsrc   = 0;
 		info.active    = false;
@@ -624,8 +796,13 @@ namespace RTC
 		// Activate the stream.
 		ActivateStream(rtpStream);
 
-		// Request a key frame since we may have lost the first packets of this stream.
-		RequestKeyFrame(true);
+		if (this->kind == RTC::Media::Kind::VIDEO)
+		{
+			this->keyFrameRequestManager->AddStream(ssrc, usePli, useFir);
+
+			// Request a key frame since we may have lost the first packets of this stream.
+			RequestKeyFrame(true);
+		}
 	}
 
 	void Producer::ApplyRtpMapping(RTC::RtpPacket* packet) const
@@ -661,6 +838,19 @@ namespace RTC
 			packet->AddExtensionMapping(
 			  RtpHeaderExtensionUri::Type::RTP_STREAM_ID, this->headerExtensionIds.rid);
 		}
+
+		if (this->headerExtensionIds.frameMarking != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::FRAME_MARKING, this->headerExtensionIds.frameMarking);
+		}
+
+		if (this->headerExtensionIds.dependencyDescriptor != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR,
+			  this->headerExtensionIds.dependencyDescriptor);
+		}
 	}
 
 	void Producer::ActivateStream(RTC::RtpStreamRecv* rtpStream)
@@ -716,38 +906,15 @@ namespace RTC
 	}
 
 	void Producer::OnRtpStreamRecvNackRequired(
-	  RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers)
+	  RTC::RtpStreamRecv* rtpStream, const std::vector<RTC::NackGenerator::NackItem>& nackItems)
 	{
 		MS_TRACE();
 
 		RTC::RTCP::FeedbackRtpNackPacket packet(0, rtpStream->GetSsrc());
-		auto it        = seqNumbers.begin();
-		const auto end = seqNumbers.end();
 
-		while (it != end)
+		for (auto& item : nackItems)
 		{
-			uint16_t seq;
-			uint16_t bitmask{ 0 };
-
-			seq = *it;
-			++it;
-
-			while (it != end)
-			{
-				uint16_t shift = *it - seq - 1;
-
-				if (shift <= 15)
-				{
-					bitmask |= (1 << shift);
-					++it;
-				}
-				else
-				{
-					break;
-				}
-			}
-
-			auto* nackItem = new RTC::RTCP::FeedbackRtpNackItem(seq, bitmask);
+			auto* nackItem = new RTC::RTCP::FeedbackRtpNackItem(item.packetId, item.lostPacketBitmask);
 
 			packet.AddItem(nackItem);
 		}
@@ -766,19 +933,11 @@ namespace RTC
 		rtpStream->nackCount++;
 	}
 
-	void Producer::OnRtpStreamRecvPliRequired(RTC::RtpStreamRecv* rtpStream)
+	void Producer::OnRtpStreamRecvKeyFrameRequired(RTC::RtpStreamRecv* rtpStream, bool force)
 	{
 		MS_TRACE();
 
-		MS_DEBUG_2TAGS(rtcp, rtx, "sending PLI [ssrc:%" PRIu32 "]", rtpStream->GetSsrc());
-
-		RTC::RTCP::FeedbackPsPliPacket packet(0, rtpStream->GetSsrc());
-
-		packet.Serialize(RTC::RTCP::Buffer);
-
-		this->transport->SendRtcpPacket(&packet);
-
-		rtpStream->pliCount++;
+		this->keyFrameRequestManager->KeyFrameNeeded(rtpStream->GetSsrc(), force);
 	}
 
 	void Producer::OnRtpStreamInactive(RTC::RtpStream* rtpStream)
@@ -841,19 +1000,53 @@ namespace RTC
 		}
 	}
 
-	inline void Producer::OnTimer(Timer* timer)
+	void Producer::OnKeyFrameRequestManagerSendPli(
+	  RTC::KeyFrameRequestManager* /*keyFrameRequestManager*/, uint32_t ssrc)
 	{
 		MS_TRACE();
 
-		if (timer == this->keyFrameRequestBlockTimer)
-		{
-			// Nobody asked for a key frame since the timer was started.
-			if (!this->isKeyFrameRequested)
-				return;
+		auto it = this->mapSsrcRtpStreamInfo.find(ssrc);
 
-			MS_DEBUG_2TAGS(rtcp, rtx, "key frame requested during flood protection, requesting it now");
+		if (it == this->mapSsrcRtpStreamInfo.end())
+			return;
 
-			RequestKeyFrame();
-		}
+		auto* rtpStream = it->second.rtpStream;
+
+		MS_DEBUG_2TAGS(rtcp, rtx, "sending PLI [ssrc:%" PRIu32 "]", ssrc);
+
+		RTC::RTCP::FeedbackPsPliPacket packet(0, ssrc);
+
+		packet.Serialize(RTC::RTCP::Buffer);
+
+		this->transport->SendRtcpPacket(&packet);
+
+		rtpStream->pliCount++;
+	}
+
+	void Producer::OnKeyFrameRequestManagerSendFir(
+	  RTC::KeyFrameRequestManager* /*keyFrameRequestManager*/, uint32_t ssrc, uint8_t seqNumber)
+	{
+		MS_TRACE();
+
+		auto it = this->mapSsrcRtpStreamInfo.find(ssrc);
+
+		if (it == this->mapSsrcRtpStreamInfo.end())
+			return;
+
+		auto* rtpStream = it->second.rtpStream;
+
+		MS_DEBUG_2TAGS(
+		  rtcp, rtx, "sending FIR [ssrc:%" PRIu32 ", seqNumber:%" PRIu8 "]", ssrc, seqNumber);
+
+		// Media SSRC must be 0 in FIR, the SSRC goes in the item (RFC 5104).
+		RTC::RTCP::FeedbackPsFirPacket packet(0, 0);
+		RTC::RTCP::FeedbackPsFirItem item(ssrc, seqNumber);
+
+		packet.AddItem(&item);
+		packet.Serialize(RTC::RTCP::Buffer);
+
+		this->transport->SendRtcpPacket(&packet);
+
+		rtpStream->firCount++;
 	}
 } // namespace RTC
@@ -0,0 +1,177 @@
+#define MS_CLASS "RTC::RedEncoder"
+// #define MS_LOG_DEV
+
+#include "RTC/RedEncoder.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::min()
+#include <cstring>   // std::memcpy()
+
+namespace RTC
+{
+	/* Static. */
+
+	static uint8_t RedPacketBuffer[RTC::MtuSize];
+
+	/* Instance methods. */
+
+	RedEncoder::RedEncoder(uint8_t payloadType) : payloadType(payloadType)
+	{
+		MS_TRACE();
+	}
+
+	/**
+	 * Build a RED packet with the payload of the given packet as primary block
+	 * preceded by the payloads of up to 'distance' previous packets. The
+	 * returned packet is written into a static buffer and must be freed by the
+	 * caller before calling this method again. nullptr is returned if RED is
+	 * disabled or if the packet is already a RED packet.
+	 */
+	RtpPacket* RedEncoder::Encode(const RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (this->distance == 0)
+			return nullptr;
+
+		// The Producer already sends RED, pass it through.
+		if (packet->GetPayloadType() == this->payloadType)
+			return nullptr;
+
+		const uint8_t* data  = packet->GetData();
+		size_t headerLength  = packet->GetPayload() - data;
+		size_t payloadLength = packet->GetPayloadLength();
+		size_t size          = headerLength + PrimaryHeaderSize + payloadLength;
+
+		if (size > RTC::MtuSize)
+			return nullptr;
+
+		const Block* redundantBlocks[MaxDistance];
+		uint8_t numRedundantBlocks{ 0 };
+		uint8_t maxBlocks = std::min(this->distance, this->numBlocks);
+
+		// Oldest blocks go first.
+		for (uint8_t i = maxBlocks; i > 0; --i)
+		{
+			auto& block       = this->blocks[(this->blocksIdx + MaxDistance - i) % MaxDistance];
+			uint16_t seqDiff  = packet->GetSequenceNumber() - block.seq;
+			uint32_t tsOffset = packet->GetTimestamp() - block.timestamp;
+
+			// Ignore blocks too old or not representable in the RED header.
+			if (seqDiff == 0 || seqDiff > this->distance)
+				continue;
+			if (tsOffset == 0 || tsOffset > MaxTimestampOffset)
+				continue;
+			if (size + BlockHeaderSize + block.length > RTC::MtuSize)
+				continue;
+
+			redundantBlocks[numRedundantBlocks++] = &block;
+			size += BlockHeaderSize + block.length;
+		}
+
+		uint8_t* buffer = RedPacketBuffer;
+		uint8_t* ptr    = buffer + headerLength;
+
+		// Copy the RTP header (including CSRC and header extensions), remove the
+		// padding flag and set the RED payload type.
+		std::memcpy(buffer, data, headerLength);
+		buffer[0] &= 0xDF;
+		buffer[1] = (buffer[1] & 0x80) | (this->payloadType & 0x7F);
+
+		// Redundant block headers.
+		for (uint8_t i = 0; i < numRedundantBlocks; ++i)
+		{
+			auto* block       = redundantBlocks[i];
+			uint32_t tsOffset = packet->GetTimestamp() - block->timestamp;
+
+			ptr[0] = 0x80 | block->payloadType;
+			ptr[1] = static_cast<uint8_t>(tsOffset >> 6);
+			ptr[2] = static_cast<uint8_t>(((tsOffset & 0x3F) << 2) | (block->length >> 8));
+			ptr[3] = static_cast<uint8_t>(block->length & 0xFF);
+			ptr += BlockHeaderSize;
+		}
+
+		// Primary block header.
+		*ptr = packet->GetPayloadType() & 0x7F;
+		ptr += PrimaryHeaderSize;
+
+		// Redundant blocks.
+		for (uint8_t i = 0; i < numRedundantBlocks; ++i)
+		{
+			auto* block = redundantBlocks[i];
+
+			std::memcpy(ptr, block->data, block->length);
+			ptr += block->length;
+		}
+
+		// Primary block.
+		std::memcpy(ptr, packet->GetPayload(), payloadLength);
+
+		// Account the RED overhead.
+		size_t overhead = size - headerLength - payloadLength;
+
+		this->packetCount++;
+		this->redundantBytes += overhead;
+		this->redundantRate.Update(overhead, DepLibUV::GetTime());
+
+		StoreBlock(packet);
+
+		return RtpPacket::Parse(buffer, size);
+	}
+
+	void RedEncoder::SetFractionLost(uint8_t fractionLost)
+	{
+		MS_TRACE();
+
+		// fractionLost is expressed in 1/256 units. Enable RED above ~2% loss and
+		// disable it below ~1%, carrying two redundant blocks above ~10% loss.
+		if (fractionLost >= 26)
+			SetDistance(2);
+		else if (fractionLost >= 5)
+			SetDistance(1);
+		else if (fractionLost < 3)
+			SetDistance(0);
+	}
+
+	void RedEncoder::SetDistance(uint8_t distance)
+	{
+		MS_TRACE();
+
+		if (distance > MaxDistance)
+			distance = MaxDistance;
+
+		if (distance == this->distance)
+			return;
+
+		MS_DEBUG_TAG(
+		  rtp, "RED distance changed [from:%" PRIu8 ", to:%" PRIu8 "]", this->distance, distance);
+
+		this->distance = distance;
+
+		// History is not kept while disabled.
+		if (this->distance == 0)
+			this->numBlocks = 0;
+	}
+
+	void RedEncoder::StoreBlock(const RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// The payload does not fit into the RED block length field.
+		if (packet->GetPayloadLength() > MaxBlockLength)
+			return;
+
+		auto& block = this->blocks[this->blocksIdx];
+
+		block.payloadType = packet->GetPayloadType() & 0x7F;
+		block.seq         = packet->GetSequenceNumber();
+		block.timestamp   = packet->GetTimestamp();
+		block.length      = packet->GetPayloadLength();
+		std::memcpy(block.data, packet->GetPayload(), block.length);
+
+		this->blocksIdx = (this->blocksIdx + 1) % MaxDistance;
+
+		if (this->numBlocks < MaxDistance)
+			this->numBlocks++;
+	}
+} // namespace RTC
@@ -0,0 +1,67 @@
+#define MS_CLASS "RTC::RetransmissionBudget"
+// #define MS_LOG_DEV
+
+#include "RTC/RetransmissionBudget.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	/**
+	 * Returns true if a retransmission of the given size fits into the budget,
+	 * in which case the budget is consumed.
+	 */
+	bool RetransmissionBudget::Consume(size_t size, uint32_t mediaBitrate, uint64_t now)
+	{
+		MS_TRACE();
+
+		Refill(mediaBitrate, now);
+
+		if (size > this->tokens)
+		{
+			this->packetsDropped++;
+			this->bytesDropped += size;
+
+			return false;
+		}
+
+		this->tokens -= size;
+
+		return true;
+	}
+
+	void RetransmissionBudget::Refill(uint32_t mediaBitrate, uint64_t now)
+	{
+		MS_TRACE();
+
+		this->bitrate = static_cast<uint32_t>(mediaBitrate * MaxRetransmissionRatio);
+
+		if (this->bitrate < MinBitrate)
+			this->bitrate = MinBitrate;
+
+		size_t maxTokens = this->bitrate * BurstWindow / 8000;
+
+		// First usage, start with a full bucket.
+		if (this->lastRefillTime == 0)
+		{
+			this->tokens         = maxTokens;
+			this->lastRefillTime = now;
+
+			return;
+		}
+
+		uint64_t elapsed = now - this->lastRefillTime;
+		size_t newTokens = this->bitrate * elapsed / 8000;
+
+		// Wait until there is something to add so rounding does not eat the budget.
+		if (newTokens == 0)
+			return;
+
+		this->tokens += newTokens;
+		this->lastRefillTime = now;
+
+		if (this->tokens > maxTokens)
+			this->tokens = maxTokens;
+	}
+} // namespace RTC
@@ -2,13 +2,17 @@
 // #define MS_LOG_DEV
 
 #include "RTC/Router.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
+#include "RTC/PacketLatency.hpp"
 #include "RTC/PlainRtpTransport.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/WebRtcTransport.hpp"
-#include <cmath> // std::lround()
+#include <algorithm> // std::min()
+#include <cmath>     // std::lround()
+#include <iterator>  // std::next()
 #include <map>
 #include <set>
 #include <string>
@@ -17,7 +21,8 @@ namespace RTC
 {
 	/* Static. */
 
-	static constexpr uint64_t AudioLevelsInterval{ 500 }; // In ms.
+	static constexpr uint64_t AudioLevelsInterval{ 500 };   // In ms.
+	static constexpr uint64_t ActiveSpeakerInterval{ 200 }; // In ms.
 
 	/* Instance methods. */
 
@@ -28,6 +33,12 @@ namespace RTC
 
 		// Set the audio levels timer.
 		this->audioLevelsTimer = new Timer(this);
+
+		// Set the active speaker timer.
+		this->activeSpeakerTimer = new Timer(this);
+
+		// Set the key frame cache timer.
+		this->keyFrameCacheTimer = new Timer(this);
 	}
 
 	Router::~Router()
@@ -39,6 +50,10 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Disable Last-N so closing Producers does not resume any Consumer.
+		this->lastN.Clear();
+		this->lastNPausedConsumers.clear();
+
 		// Close all the Producers.
 		for (auto it = this->producers.begin(); it != this->producers.end();)
 		{
@@ -71,6 +86,13 @@ namespace RTC
 		// Close the audio level timer.
 		this->audioLevelsTimer->Destroy();
 
+		// Close the active speaker timer and detector.
+		this->activeSpeakerTimer->Destroy();
+		delete this->activeSpeakerDetector;
+
+		// Close the key frame cache timer.
+		this->keyFrameCacheTimer->Destroy();
+
 		// Notify the listener.
 		this->listener->OnRouterClosed(this);
 
@@ -88,23 +110,38 @@ namespace RTC
 		static const Json::StaticString JsonStringMapProducerConsumers{ "mapProducerConsumers" };
 		static const Json::StaticString JsonStringMapConsumerProducer{ "mapConsumerProducer" };
 		static const Json::StaticString JsonStringAudioLevelsEventEnabled{ "audioLevelsEventEnabled" };
-
+		static const Json::StaticString JsonStringActiveSpeakerEventEnabled{ "activeSpeakerEventEnabled" };
+		static const Json::StaticString JsonStringMapTransportLastN{ "mapTransportLastN" };
+		static const Json::StaticString JsonStringAudioTopK{ "audioTopK" };
+		static const Json::StaticString JsonStringRtpParametersCacheSize{ "rtpParametersCacheSize" };
+		static const Json::StaticString JsonStringCpuTime{ "cpuTime" };
+		static const Json::StaticString JsonStringCpuUsage{ "cpuUsage" };
+
+		uint64_t now = DepLibUV::GetTime();
 		Json::Value json(Json::objectValue);
 		Json::Value jsonTransports(Json::arrayValue);
 		Json::Value jsonProducers(Json::arrayValue);
 		Json::Value jsonConsumers(Json::arrayValue);
 		Json::Value jsonMapProducerConsumers(Json::objectValue);
 		Json::Value jsonMapConsumerProducer(Json::objectValue);
+		Json::Value jsonMapTransportLastN(Json::objectValue);
 
 		// Add routerId.
 		json[JsonStringRouterId] = Json::UInt{ this->routerId };
 
+		// CPU time of the Router timers and of its current Transports.
+		uint64_t cpuTime  = this->cpuUsage.GetTime();
+		uint32_t cpuUsage = this->cpuUsage.GetRate(now);
+
 		// Add transports.
 		for (auto& kv : this->transports)
 		{
 			auto* transport = kv.second;
 
 			jsonTransports.append(transport->ToJson());
+
+			cpuTime += transport->GetCpuUsage().GetTime();
+			cpuUsage += transport->GetCpuUsage().GetRate(now);
 		}
 		json[JsonStringTransports] = jsonTransports;
 
@@ -153,11 +190,55 @@ namespace RTC
 		}
 		json[JsonStringMapConsumerProducer] = jsonMapConsumerProducer;
 
-		json[JsonStringAudioLevelsEventEnabled] = this->audioLevelsEventEnabled;
+		// Add mapTransportLastN.
+		for (auto& kv : this->lastN.GetLimits())
+		{
+			auto transportId = kv.first;
+			auto limit       = kv.second;
+
+			jsonMapTransportLastN[std::to_string(transportId)] = Json::UInt{ limit };
+		}
+		json[JsonStringMapTransportLastN] = jsonMapTransportLastN;
+
+		json[JsonStringAudioLevelsEventEnabled]   = this->audioLevelsEventEnabled;
+		json[JsonStringActiveSpeakerEventEnabled] = this->activeSpeakerEventEnabled;
+		json[JsonStringAudioTopK]                 = Json::UInt{ this->audioTopK.GetK() };
+		json[JsonStringRtpParametersCacheSize] =
+		  Json::UInt{ static_cast<uint32_t>(this->rtpParametersCache.GetSize()) };
+		json[JsonStringCpuTime]  = Json::UInt64{ cpuTime };
+		json[JsonStringCpuUsage] = Json::UInt{ cpuUsage };
 
 		return json;
 	}
 
+	void Router::FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->transports)
+		{
+			auto* transport = kv.second;
+			RTC::StatsSnapshot::Record record;
+
+			record.type          = RTC::StatsSnapshot::RecordType::TRANSPORT;
+			record.id            = transport->transportId;
+			record.bytesReceived = transport->GetRecvBytes();
+			record.bytesSent     = transport->GetSentBytes();
+
+			snapshot.AddRecord(record);
+		}
+
+		for (auto& kv : this->producers)
+		{
+			kv.second->FillStats(snapshot, now);
+		}
+
+		for (auto& kv : this->consumers)
+		{
+			kv.second->FillStats(snapshot, now);
+		}
+	}
+
 	void Router::HandleRequest(Channel::Request* request)
 	{
 		MS_TRACE();
@@ -173,6 +254,38 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::ROUTER_GET_STATS:
+			{
+				static const Json::StaticString JsonStringDelta{ "delta" };
+				static const Json::StaticString JsonStringRecordCount{ "recordCount" };
+				static const Json::StaticString JsonStringLatency{ "latency" };
+				static const Json::StaticString JsonStringForwarding{ "forwarding" };
+				static const Json::StaticString JsonStringRetransmission{ "retransmission" };
+
+				bool delta{ false };
+
+				if (request->data[JsonStringDelta].isBool())
+					delta = request->data[JsonStringDelta].asBool();
+
+				uint64_t now = DepLibUV::GetTime();
+
+				this->statsSnapshot.Begin(now, delta);
+
+				FillStats(this->statsSnapshot, now);
+
+				Json::Value data(Json::objectValue);
+
+				data[JsonStringRecordCount] =
+				  Json::UInt{ static_cast<uint32_t>(this->statsSnapshot.GetRecordCount()) };
+				data[JsonStringLatency][JsonStringForwarding] = this->forwardingLatencyHistogram.ToJson();
+				data[JsonStringLatency][JsonStringRetransmission] =
+				  this->retransmissionLatencyHistogram.ToJson();
+
+				request->Accept(data, this->statsSnapshot.GetData(), this->statsSnapshot.GetSize());
+
+				break;
+			}
+
 			case Channel::Request::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT:
 			{
 				static const Json::StaticString JsonStringUdp{ "udp" };
@@ -447,6 +560,10 @@ namespace RTC
 				// Ensure the entry will exist even with an empty array.
 				this->mapProducerConsumers[producer];
 
+				// New video Producers are the least recently active ones.
+				if (producer->kind == RTC::Media::Kind::VIDEO)
+					this->lastNRanking.push_back(producer);
+
 				MS_DEBUG_DEV("Producer created [producerId:%" PRIu32 "]", producerId);
 
 				request->Accept();
@@ -511,35 +628,160 @@ namespace RTC
 					return;
 				}
 
-				auto* consumer = new RTC::Consumer(this->notifier, consumerId, kind, producer->producerId);
+				CreateConsumer(consumerId, kind, producer);
 
-				// If the Producer is paused tell it to the new Consumer.
-				if (producer->IsPaused())
-					consumer->SourcePause();
+				request->Accept();
 
-				// Provide the preferred RTP profile of the Producer.
-				consumer->SetSourcePreferredProfile(producer->GetPreferredProfile());
+				break;
+			}
 
-				// Add us as listener.
-				consumer->AddListener(this);
+			case Channel::Request::MethodId::ROUTER_CREATE_CONSUMERS:
+			{
+				static const Json::StaticString JsonStringKind{ "kind" };
+				static const Json::StaticString JsonStringConsumers{ "consumers" };
+				static const Json::StaticString JsonStringConsumerId{ "consumerId" };
+				static const Json::StaticString JsonStringTransportId{ "transportId" };
+				static const Json::StaticString JsonStringRtpParameters{ "rtpParameters" };
+				static const Json::StaticString JsonStringSsrc{ "ssrc" };
+				static const Json::StaticString JsonStringRtxSsrc{ "rtxSsrc" };
 
-				auto activeProfiles = producer->GetActiveProfiles();
-				std::map<RTC::RtpEncodingParameters::Profile, const RTC::RtpStream*>::reverse_iterator it;
+				RTC::Producer* producer;
 
-				for (it = activeProfiles.rbegin(); it != activeProfiles.rend(); ++it)
+				try
+				{
+					producer = GetProducerFromRequest(request);
+				}
+				catch (const MediaSoupError& error)
 				{
-					auto profile = it->first;
-					auto stats   = it->second;
+					request->Reject(error.what());
 
-					consumer->AddProfile(profile, stats);
+					return;
 				}
 
-				// Insert into the maps.
-				this->consumers[consumerId] = consumer;
-				this->mapProducerConsumers[producer].insert(consumer);
-				this->mapConsumerProducer[consumer] = producer;
+				if (!request->data[JsonStringKind].isString())
+				{
+					request->Reject("missing data.kind");
+
+					return;
+				}
+
+				auto& jsonConsumers = request->data[JsonStringConsumers];
+
+				if (!jsonConsumers.isArray())
+				{
+					request->Reject("missing data.consumers");
+
+					return;
+				}
+
+				RTC::Media::Kind kind;
+				std::string kindStr = request->data[JsonStringKind].asString();
+				// Shared by all the Consumers enabled on creation.
+				std::shared_ptr<const RTC::SharedRtpParameters> rtpParameters;
+				RTC::RtpEncodingParameters encoding;
+				std::set<uint32_t> consumerIds;
+				std::vector<RTC::Transport*> transports;
+
+				// Validate everything before creating any Consumer so the request is
+				// either fully applied or rejected.
+				try
+				{
+					// NOTE: This may throw.
+					kind = RTC::Media::GetKind(kindStr);
+
+					if (kind == RTC::Media::Kind::ALL)
+						MS_THROW_ERROR("invalid empty kind");
+					else if (kind != producer->kind)
+						MS_THROW_ERROR("not matching kind");
+
+					if (request->data[JsonStringRtpParameters].isObject())
+					{
+						auto& jsonRtpParameters = request->data[JsonStringRtpParameters];
+
+						// NOTE: This may throw.
+						rtpParameters = this->rtpParametersCache.Get(jsonRtpParameters);
+						encoding      = rtpParameters->GetEncoding(jsonRtpParameters);
+					}
+
+					for (auto& jsonConsumer : jsonConsumers)
+					{
+						if (!jsonConsumer[JsonStringConsumerId].isUInt())
+							MS_THROW_ERROR("missing consumers[].consumerId");
+
+						uint32_t consumerId = jsonConsumer[JsonStringConsumerId].asUInt();
+
+						if (
+						  this->consumers.find(consumerId) != this->consumers.end() ||
+						  !consumerIds.insert(consumerId).second)
+						{
+							MS_THROW_ERROR("a Consumer with same consumerId already exists");
+						}
+
+						RTC::Transport* transport{ nullptr };
+
+						if (jsonConsumer[JsonStringTransportId].isUInt())
+						{
+							auto it = this->transports.find(jsonConsumer[JsonStringTransportId].asUInt());
+
+							if (it == this->transports.end())
+								MS_THROW_ERROR("Transport not found");
+
+							if (!rtpParameters)
+								MS_THROW_ERROR("missing data.rtpParameters");
+
+							uint32_t ssrc = jsonConsumer[JsonStringSsrc].isUInt()
+							                  ? jsonConsumer[JsonStringSsrc].asUInt()
+							                  : encoding.ssrc;
+
+							if (ssrc == 0)
+								MS_THROW_ERROR("missing rtpParameters.encodings[0].ssrc");
+
+							transport = it->second;
+						}
+
+						transports.push_back(transport);
+					}
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				bool mayApplyLastN{ false };
+
+				for (Json::ArrayIndex idx{ 0 }; idx < jsonConsumers.size(); ++idx)
+				{
+					auto& jsonConsumer = jsonConsumers[idx];
+					auto* transport    = transports[idx];
+					auto* consumer =
+					  CreateConsumer(jsonConsumer[JsonStringConsumerId].asUInt(), kind, producer);
+
+					if (transport == nullptr)
+						continue;
+
+					// Each Consumer gets its own SSRCs over the shared RTP parameters.
+					RTC::RtpEncodingParameters consumerEncoding(encoding);
+
+					if (jsonConsumer[JsonStringSsrc].isUInt())
+						consumerEncoding.ssrc = jsonConsumer[JsonStringSsrc].asUInt();
+
+					if (consumerEncoding.hasRtx && jsonConsumer[JsonStringRtxSsrc].isUInt())
+						consumerEncoding.rtx.ssrc = jsonConsumer[JsonStringRtxSsrc].asUInt();
 
-				MS_DEBUG_DEV("Consumer created [consumerId:%" PRIu32 "]", consumerId);
+					// NOTE: This does not throw since the parameters were validated above.
+					consumer->Enable(transport, rtpParameters, consumerEncoding);
+
+					// Tell the Transport to handle the new Consumer.
+					transport->HandleConsumer(consumer);
+
+					mayApplyLastN = true;
+				}
+
+				// The Consumers may be out of the Last-N of their Transports.
+				if (mayApplyLastN)
+					ApplyLastN();
 
 				request->Accept();
 
@@ -586,6 +828,79 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::ROUTER_SET_ACTIVE_SPEAKER_EVENT:
+			{
+				static const Json::StaticString JsonStringEnabled{ "enabled" };
+				static const Json::StaticString JsonStringHysteresis{ "hysteresis" };
+
+				if (!request->data[JsonStringEnabled].isBool())
+				{
+					request->Reject("Request has invalid data.enabled");
+
+					return;
+				}
+
+				this->activeSpeakerEventEnabled = request->data[JsonStringEnabled].asBool();
+
+				MS_DEBUG_DEV(
+				  "activespeakerchange event %s",
+				  this->activeSpeakerEventEnabled ? "enabled" : "disabled");
+
+				MayUpdateActiveSpeakerDetector();
+
+				if (this->activeSpeakerEventEnabled && request->data[JsonStringHysteresis].isUInt())
+				{
+					auto hysteresis = request->data[JsonStringHysteresis].asUInt();
+
+					this->activeSpeakerDetector->SetHysteresis(
+					  static_cast<uint8_t>(std::min(hysteresis, 127u)));
+				}
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::ROUTER_SET_AUDIO_TOP_K:
+			{
+				static const Json::StaticString JsonStringTopK{ "topK" };
+
+				uint32_t topK{ 0 };
+
+				// A missing value or 0 means forwarding all the audio Producers.
+				if (request->data[JsonStringTopK].isUInt())
+					topK = request->data[JsonStringTopK].asUInt();
+
+				// Audio Producers that were not forwarded must resync their Consumers.
+				if (this->audioTopK.GetK() != 0 && topK == 0)
+				{
+					for (auto& kv : this->producers)
+					{
+						auto* producer = kv.second;
+
+						if (producer->kind != RTC::Media::Kind::AUDIO)
+							continue;
+
+						if (this->audioTopK.IsForwarded(producer->producerId))
+							continue;
+
+						for (auto* consumer : this->mapProducerConsumers[producer])
+						{
+							consumer->RequireSync();
+						}
+					}
+				}
+
+				MS_DEBUG_DEV("audio top-K set [topK:%" PRIu32 "]", topK);
+
+				// Start the selection again.
+				this->audioTopK.SetK(topK);
+
+				request->Accept();
+
+				break;
+			}
+
 			case Channel::Request::MethodId::TRANSPORT_CLOSE:
 			{
 				RTC::Transport* transport;
@@ -984,6 +1299,50 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::TRANSPORT_SET_LAST_N:
+			{
+				static const Json::StaticString JsonStringLastN{ "lastN" };
+
+				RTC::Transport* transport;
+
+				try
+				{
+					transport = GetTransportFromRequest(request);
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				// A missing or negative value disables Last-N.
+				if (request->data[JsonStringLastN].isUInt())
+				{
+					auto limit = request->data[JsonStringLastN].asUInt();
+
+					this->lastN.SetLimit(transport->transportId, limit);
+
+					MS_DEBUG_DEV(
+					  "Transport Last-N set [transportId:%" PRIu32 ", lastN:%u]",
+					  transport->transportId,
+					  limit);
+				}
+				else
+				{
+					this->lastN.RemoveLimit(transport->transportId);
+
+					MS_DEBUG_DEV("Transport Last-N disabled [transportId:%" PRIu32 "]", transport->transportId);
+				}
+
+				MayUpdateActiveSpeakerDetector();
+				ApplyLastN();
+
+				request->Accept();
+
+				break;
+			}
+
 			case Channel::Request::MethodId::PRODUCER_CLOSE:
 			{
 				RTC::Producer* producer;
@@ -1215,15 +1574,14 @@ namespace RTC
 					return;
 				}
 
-				RTC::RtpParameters rtpParameters;
-
 				try
 				{
+					auto& jsonRtpParameters = request->data[JsonStringRtpParameters];
 					// NOTE: This may throw.
-					rtpParameters = RTC::RtpParameters(request->data[JsonStringRtpParameters]);
+					auto rtpParameters = this->rtpParametersCache.Get(jsonRtpParameters);
 
 					// NOTE: This may throw.
-					consumer->Enable(transport, rtpParameters);
+					consumer->Enable(transport, rtpParameters, rtpParameters->GetEncoding(jsonRtpParameters));
 				}
 				catch (const MediaSoupError& error)
 				{
@@ -1235,6 +1593,9 @@ namespace RTC
 				// Tell the Transport to handle the new Consumer.
 				transport->HandleConsumer(consumer);
 
+				// The Consumer may be out of the Last-N of its Transport.
+				ApplyLastN();
+
 				request->Accept();
 
 				break;
@@ -1435,6 +1796,37 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::CONSUMER_SUPPRESS_COMFORT_NOISE:
+			{
+				static const Json::StaticString JsonStringEnabled{ "enabled" };
+
+				RTC::Consumer* consumer;
+
+				try
+				{
+					consumer = GetConsumerFromRequest(request);
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				if (!request->data[JsonStringEnabled].isBool())
+				{
+					request->Reject("missing data.enabled");
+
+					return;
+				}
+
+				consumer->SetComfortNoiseSuppression(request->data[JsonStringEnabled].asBool());
+
+				request->Accept();
+
+				break;
+			}
+
 			default:
 			{
 				MS_ERROR("unknown method");
@@ -1570,6 +1962,44 @@ namespace RTC
 		return consumerId;
 	}
 
+	RTC::Consumer* Router::CreateConsumer(
+	  uint32_t consumerId, RTC::Media::Kind kind, RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		auto* consumer = new RTC::Consumer(this->notifier, consumerId, kind, producer->producerId);
+
+		// If the Producer is paused tell it to the new Consumer.
+		if (producer->IsPaused())
+			consumer->SourcePause();
+
+		// Provide the preferred RTP profile of the Producer.
+		consumer->SetSourcePreferredProfile(producer->GetPreferredProfile());
+
+		// Add us as listener.
+		consumer->AddListener(this);
+
+		auto activeProfiles = producer->GetActiveProfiles();
+		std::map<RTC::RtpEncodingParameters::Profile, const RTC::RtpStream*>::reverse_iterator it;
+
+		for (it = activeProfiles.rbegin(); it != activeProfiles.rend(); ++it)
+		{
+			auto profile = it->first;
+			auto stats   = it->second;
+
+			consumer->AddProfile(profile, stats);
+		}
+
+		// Insert into the maps.
+		this->consumers[consumerId] = consumer;
+		this->mapProducerConsumers[producer].insert(consumer);
+		this->mapConsumerProducer[consumer] = producer;
+
+		MS_DEBUG_DEV("Consumer created [consumerId:%" PRIu32 "]", consumerId);
+
+		return consumer;
+	}
+
 	/**
 	 * Looks for internal.consumerId numeric field and returns the corresponding
 	 * Consumer.
@@ -1597,11 +2027,187 @@ namespace RTC
 		return consumer;
 	}
 
+	/**
+	 * The active speaker detector is needed by the activespeakerchange event and
+	 * by the Last-N of any Transport.
+	 */
+	void Router::MayUpdateActiveSpeakerDetector()
+	{
+		MS_TRACE();
+
+		bool needed = this->activeSpeakerEventEnabled || !this->lastN.IsEmpty();
+
+		if (needed && this->activeSpeakerDetector == nullptr)
+		{
+			this->activeSpeakerDetector = new RTC::ActiveSpeakerDetector(this);
+			this->activeSpeakerTimer->Start(ActiveSpeakerInterval, ActiveSpeakerInterval);
+		}
+		else if (!needed && this->activeSpeakerDetector != nullptr)
+		{
+			this->activeSpeakerTimer->Stop();
+
+			delete this->activeSpeakerDetector;
+			this->activeSpeakerDetector = nullptr;
+		}
+	}
+
+	/**
+	 * Forward to each Transport with Last-N only the video of its N most recently
+	 * active Producers and pause the rest. Resumed Consumers are served from the
+	 * key frame cache and, otherwise, a single key frame is requested per Producer.
+	 */
+	void Router::ApplyLastN()
+	{
+		MS_TRACE();
+
+		if (this->lastN.IsEmpty() && this->lastNPausedConsumers.empty())
+			return;
+
+		std::set<RTC::Producer*> keyFrameProducers;
+
+		this->lastN.Begin();
+
+		for (auto* producer : this->lastNRanking)
+		{
+			// A paused Producer does not take any slot.
+			if (producer->IsPaused())
+				continue;
+
+			for (auto* consumer : this->mapProducerConsumers[producer])
+			{
+				if (!consumer->IsEnabled())
+					continue;
+
+				bool forward =
+				  this->lastN.Forward(producer->producerId, consumer->GetTransport()->transportId);
+
+				if (!forward)
+				{
+					if (this->lastNPausedConsumers.insert(consumer).second)
+						consumer->SourcePause();
+				}
+				else if (this->lastNPausedConsumers.erase(consumer) != 0)
+				{
+					consumer->SourceResume();
+
+					if (!ScheduleKeyFrameFromCache(consumer, producer))
+						keyFrameProducers.insert(producer);
+				}
+			}
+		}
+
+		for (auto* producer : keyFrameProducers)
+		{
+			producer->RequestKeyFrame();
+		}
+	}
+
+	/**
+	 * Serve a Consumer waiting for a key frame from the Producer key frame cache
+	 * in the next loop iteration. Sending the cached packets may request a key
+	 * frame again (i.e. when the Consumer switches its profile), so they are not
+	 * sent from here. Returns false if there is no valid cached key frame.
+	 */
+	bool Router::ScheduleKeyFrameFromCache(RTC::Consumer* consumer, RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		if (!consumer->IsWaitingForKeyFrame())
+			return false;
+
+		if (producer->GetKeyFrameCache(consumer->GetTargetProfile()) == nullptr)
+			return false;
+
+		this->keyFrameCacheConsumers.insert(consumer);
+
+		if (!this->keyFrameCacheTimer->IsActive())
+			this->keyFrameCacheTimer->Start(0);
+
+		return true;
+	}
+
+	/**
+	 * Serve a Consumer waiting for a key frame from the Producer key frame cache.
+	 * Returns false if there is no valid cached key frame.
+	 */
+	bool Router::SendKeyFrameFromCache(RTC::Consumer* consumer, RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		if (!consumer->IsWaitingForKeyFrame())
+			return false;
+
+		auto profile              = consumer->GetTargetProfile();
+		const auto* keyFrameCache = producer->GetKeyFrameCache(profile);
+
+		if (keyFrameCache == nullptr)
+			return false;
+
+		// Keep a reference to the cached packets while sending them.
+		auto packets = keyFrameCache->GetPackets();
+
+		MS_DEBUG_TAG(
+		  rtp,
+		  "sending key frame from cache [consumerId:%" PRIu32 ", packets:%zu]",
+		  consumer->consumerId,
+		  packets.size());
+
+		for (auto& item : packets)
+		{
+			consumer->SendRtpPacket(item->packet, profile);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Update the audio activity of the given Producer with the ssrc-audio-level
+	 * of the packet and return whether it is among the top-K loudest ones.
+	 */
+	bool Router::UpdateAudioTopK(RTC::Producer* producer, const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		uint8_t volume;
+		bool voice;
+		uint8_t energy{ 0 };
+
+		// Packets without voice activity count as silence.
+		if (packet->ReadAudioLevel(&volume, &voice) && voice)
+			energy = 127 - std::min(volume, uint8_t{ 127 });
+
+		bool added;
+		bool forwarded =
+		  this->audioTopK.Update(producer->producerId, energy, DepLibUV::GetTime(), added);
+
+		if (!added)
+			return forwarded;
+
+		// Its Consumers did not send the skipped packets, so avoid a gap in the
+		// sequence numbers seen by the receivers.
+		for (auto* consumer : this->mapProducerConsumers[producer])
+		{
+			consumer->RequireSync();
+		}
+
+		return true;
+	}
+
+	void Router::RemoveAudioTopKProducer(RTC::Producer* producer)
+	{
+		MS_TRACE();
+
+		this->audioTopK.Remove(producer->producerId);
+	}
+
 	void Router::OnTransportClosed(RTC::Transport* transport)
 	{
 		MS_TRACE();
 
 		this->transports.erase(transport->transportId);
+
+		if (this->lastN.RemoveLimit(transport->transportId))
+			MayUpdateActiveSpeakerDetector();
 	}
 
 	void Router::OnTransportReceiveRtcpFeedback(
@@ -1644,6 +2250,22 @@ namespace RTC
 
 		// Also delete it from the map of audio levels.
 		this->mapProducerAudioLevelContainer.erase(producer);
+
+		// And from the active speaker detector.
+		if (this->activeSpeakerDetector != nullptr)
+			this->activeSpeakerDetector->RemoveProducer(producer->producerId);
+
+		// And from the audio top-K.
+		if (producer->kind == RTC::Media::Kind::AUDIO)
+			RemoveAudioTopKProducer(producer);
+
+		// And from the Last-N ranking, which may let another Producer in.
+		if (producer->kind == RTC::Media::Kind::VIDEO)
+		{
+			this->lastNRanking.remove(producer);
+
+			ApplyLastN();
+		}
 	}
 
 	void Router::OnProducerPaused(RTC::Producer* producer)
@@ -1660,6 +2282,14 @@ namespace RTC
 		{
 			consumer->SourcePause();
 		}
+
+		// A paused Producer cannot be the active speaker.
+		if (this->activeSpeakerDetector != nullptr)
+			this->activeSpeakerDetector->RemoveProducer(producer->producerId);
+
+		// Nor take a slot in the audio top-K.
+		if (producer->kind == RTC::Media::Kind::AUDIO)
+			RemoveAudioTopKProducer(producer);
 	}
 
 	void Router::OnProducerResumed(RTC::Producer* producer)
@@ -1672,10 +2302,20 @@ namespace RTC
 
 		auto& consumers = this->mapProducerConsumers[producer];
 
+		// The resumed Producer takes a Last-N slot again.
+		if (producer->kind == RTC::Media::Kind::VIDEO)
+			ApplyLastN();
+
 		for (auto* consumer : consumers)
 		{
-			if (consumer->IsEnabled())
-				consumer->SourceResume();
+			if (!consumer->IsEnabled())
+				continue;
+
+			// Keep it paused if out of the Last-N of its Transport.
+			if (this->lastNPausedConsumers.find(consumer) != this->lastNPausedConsumers.end())
+				continue;
+
+			consumer->SourceResume();
 		}
 	}
 
@@ -1691,11 +2331,21 @@ namespace RTC
 		auto& consumers = this->mapProducerConsumers[producer];
 
 		// Send the RtpPacket to all the Consumers associated to the Producer
-		// from which it was received.
-		for (auto* consumer : consumers)
+		// from which it was received. If the audio top-K is enabled, audio is
+		// only forwarded for the loudest Producers.
+		if (
+		  this->audioTopK.GetK() == 0 || producer->kind != RTC::Media::Kind::AUDIO ||
+		  UpdateAudioTopK(producer, packet))
 		{
-			if (consumer->IsEnabled())
-				consumer->SendRtpPacket(packet, profile);
+			for (auto* consumer : consumers)
+			{
+				if (!consumer->IsEnabled())
+					continue;
+
+				// Just packets actually sent count for the forwarding latency.
+				if (consumer->SendRtpPacket(packet, profile) && RTC::PacketLatency::IsSampled())
+					this->forwardingLatencyHistogram.Add(RTC::PacketLatency::GetElapsed());
+			}
 		}
 
 		// Update audio levels.
@@ -1713,6 +2363,16 @@ namespace RTC
 				audioLevelContainer.sumdBovs += dBov;
 			}
 		}
+
+		// Feed the active speaker detector.
+		if (this->activeSpeakerDetector != nullptr && producer->kind == RTC::Media::Kind::AUDIO)
+		{
+			uint8_t volume;
+			bool voice;
+
+			if (packet->ReadAudioLevel(&volume, &voice))
+				this->activeSpeakerDetector->ReceiveAudioLevel(producer->producerId, volume);
+		}
 	}
 
 	void Router::OnProducerProfileEnabled(
@@ -1766,6 +2426,9 @@ namespace RTC
 
 		// Finally delete the Consumer entry in the map.
 		this->mapConsumerProducer.erase(consumer);
+
+		this->lastNPausedConsumers.erase(consumer);
+		this->keyFrameCacheConsumers.erase(consumer);
 	}
 
 	void Router::OnConsumerKeyFrameRequired(RTC::Consumer* consumer)
@@ -1778,13 +2441,98 @@ namespace RTC
 
 		auto* producer = this->mapConsumerProducer[consumer];
 
-		producer->RequestKeyFrame();
+		// Serve a Consumer waiting for a key frame from the Producer key frame cache
+		// (if valid) instead of asking the sender for a new key frame.
+		if (ScheduleKeyFrameFromCache(consumer, producer))
+			return;
+
+		// Just the streams of the profile the Consumer is waiting for.
+		producer->RequestKeyFrame(
+		  consumer->GetTargetProfile(), static_cast<uint32_t>(consumer->GetRtt()));
+	}
+
+	void Router::OnConsumerRetransmissionRequired(
+	  RTC::Consumer* consumer,
+	  RTC::RtpEncodingParameters::Profile profile,
+	  const std::vector<uint16_t>& seqs)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(
+		  this->mapConsumerProducer.find(consumer) != this->mapConsumerProducer.end(),
+		  "Consumer not present in mapConsumerProducer");
+
+		auto* producer = this->mapConsumerProducer[consumer];
+
+		producer->RequestRtpRetransmission(profile, seqs);
+	}
+
+	void Router::OnConsumerRtpPacketRetransmitted(RTC::Consumer* /*consumer*/, uint64_t latency)
+	{
+		MS_TRACE();
+
+		this->retransmissionLatencyHistogram.Add(latency);
+	}
+
+	inline void Router::OnActiveSpeakerChanged(
+	  RTC::ActiveSpeakerDetector* /*activeSpeakerDetector*/, uint32_t producerId)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringProducerId{ "producerId" };
+
+		if (this->activeSpeakerEventEnabled)
+		{
+			Json::Value eventData(Json::objectValue);
+
+			eventData[JsonStringProducerId] = Json::UInt{ producerId };
+
+			this->notifier->EmitCoalesced(this->routerId, "activespeakerchange", eventData);
+		}
+
+		auto it = this->producers.find(producerId);
+
+		if (it == this->producers.end())
+			return;
+
+		// Move the video Producers of the speaker's Transport to the top of the
+		// Last-N ranking.
+		auto* transport = it->second->GetTransport();
+		std::list<RTC::Producer*> speakerProducers;
+
+		for (auto rankingIt = this->lastNRanking.begin(); rankingIt != this->lastNRanking.end();)
+		{
+			auto nextIt = std::next(rankingIt);
+
+			if ((*rankingIt)->GetTransport() == transport)
+				speakerProducers.splice(speakerProducers.end(), this->lastNRanking, rankingIt);
+
+			rankingIt = nextIt;
+		}
+
+		this->lastNRanking.splice(this->lastNRanking.begin(), speakerProducers);
+
+		ApplyLastN();
+	}
+
+	inline void Router::OnActiveSpeakerLost(RTC::ActiveSpeakerDetector* /*activeSpeakerDetector*/)
+	{
+		MS_TRACE();
+
+		if (!this->activeSpeakerEventEnabled)
+			return;
+
+		Json::Value eventData(Json::objectValue);
+
+		this->notifier->EmitCoalesced(this->routerId, "activespeakerchange", eventData);
 	}
 
 	inline void Router::OnTimer(Timer* timer)
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		static const Json::StaticString JsonStringEntries{ "entries" };
 
 		// Audio levels timer.
@@ -1819,7 +2567,41 @@ namespace RTC
 			this->mapProducerAudioLevelContainer.clear();
 
 			// Emit event.
-			this->notifier->Emit(this->routerId, "audiolevels", eventData);
+			this->notifier->EmitCoalesced(this->routerId, "audiolevels", eventData);
+		}
+		// Active speaker timer.
+		else if (timer == this->activeSpeakerTimer)
+		{
+			this->activeSpeakerDetector->Process();
+		}
+		// Key frame cache timer.
+		else if (timer == this->keyFrameCacheTimer)
+		{
+			// Consumers scheduled while sending are served in the next iteration.
+			auto consumers = std::move(this->keyFrameCacheConsumers);
+
+			this->keyFrameCacheConsumers.clear();
+
+			for (auto* consumer : consumers)
+			{
+				auto it = this->mapConsumerProducer.find(consumer);
+
+				// Closed while sending to a previous one.
+				if (it == this->mapConsumerProducer.end())
+					continue;
+
+				auto* producer = it->second;
+
+				// The cached key frame expired meanwhile.
+				if (!SendKeyFrameFromCache(consumer, producer) && consumer->IsWaitingForKeyFrame())
+				{
+					producer->RequestKeyFrame(
+					  consumer->GetTargetProfile(), static_cast<uint32_t>(consumer->GetRtt()));
+				}
+			}
+
+			if (!this->keyFrameCacheConsumers.empty())
+				this->keyFrameCacheTimer->Start(0);
 		}
 	}
 } // namespace RTC
@@ -463,7 +463,20 @@ namespace RTC
 		if (!this->payloadDescriptorHandler)
 			return true;
 
-		return this->payloadDescriptorHandler->Encode(context, this->payload);
+		bool marker = HasMarker();
+
+		if (!this->payloadDescriptorHandler->Encode(context, this->payload, marker))
+			return false;
+
+		// The codec handler may set the marker bit. Remember it so it can be restored.
+		if (marker != HasMarker())
+		{
+			SetMarker(marker);
+
+			this->markerEncoded = true;
+		}
+
+		return true;
 	}
 
 	void RtpPacket::RestorePayload()
@@ -474,6 +487,13 @@ namespace RTC
 			return;
 
 		this->payloadDescriptorHandler->Restore(this->payload);
+
+		if (this->markerEncoded)
+		{
+			SetMarker(!HasMarker());
+
+			this->markerEncoded = false;
+		}
 	}
 
 	void RtpPacket::ShiftPayload(size_t payloadOffset, size_t shift, bool expand)
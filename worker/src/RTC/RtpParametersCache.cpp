@@ -0,0 +1,147 @@
+#define MS_CLASS "RTC::RtpParametersCache"
+// #define MS_LOG_DEV
+
+#include "RTC/RtpParametersCache.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+#include "Channel/BinaryCodec.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t KeyBufferSize{ 65536 };
+
+	/* Instance methods. */
+
+	SharedRtpParameters::SharedRtpParameters(Json::Value& data) : rtpParameters(data)
+	{
+		MS_TRACE();
+
+		static const std::string AssociatedPayloadType = "apt";
+
+		if (this->rtpParameters.encodings.empty())
+			MS_THROW_ERROR("invalid empty rtpParameters.encodings");
+
+		for (auto& codec : this->rtpParameters.codecs)
+		{
+			this->codecs[codec.payloadType] = std::addressof(codec);
+
+			if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::CN)
+				this->comfortNoisePayloadTypes.insert(codec.payloadType);
+
+			if (codec.mimeType.IsFeatureCodec() && codec.parameters.HasInteger(AssociatedPayloadType))
+			{
+				auto payloadType = static_cast<uint8_t>(codec.parameters.GetInteger(AssociatedPayloadType));
+
+				this->rtxCodecs[payloadType] = std::addressof(codec);
+			}
+		}
+	}
+
+	/**
+	 * Copy of the first encoding with the SSRCs given in the rtpParameters JSON.
+	 */
+	RTC::RtpEncodingParameters SharedRtpParameters::GetEncoding(const Json::Value& data) const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringEncodings{ "encodings" };
+		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+		static const Json::StaticString JsonStringRtx{ "rtx" };
+		static const Json::StaticString JsonStringFec{ "fec" };
+
+		RTC::RtpEncodingParameters encoding(this->rtpParameters.encodings[0]);
+		const auto& jsonEncoding = data[JsonStringEncodings][0];
+
+		if (jsonEncoding[JsonStringSsrc].isUInt())
+			encoding.ssrc = jsonEncoding[JsonStringSsrc].asUInt();
+
+		if (encoding.hasRtx && jsonEncoding[JsonStringRtx][JsonStringSsrc].isUInt())
+			encoding.rtx.ssrc = jsonEncoding[JsonStringRtx][JsonStringSsrc].asUInt();
+
+		if (encoding.hasFec && jsonEncoding[JsonStringFec][JsonStringSsrc].isUInt())
+			encoding.fec.ssrc = jsonEncoding[JsonStringFec][JsonStringSsrc].asUInt();
+
+		return encoding;
+	}
+
+	/**
+	 * Get the shared parameters for the given rtpParameters JSON.
+	 * NOTE: It may throw if the parameters are not valid.
+	 */
+	std::shared_ptr<const SharedRtpParameters> RtpParametersCache::Get(Json::Value& data)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringEncodings{ "encodings" };
+		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+		static const Json::StaticString JsonStringRtx{ "rtx" };
+		static const Json::StaticString JsonStringFec{ "fec" };
+
+		if (!data.isObject())
+			MS_THROW_ERROR("rtpParameters is not an object");
+
+		// Canonical form: the parameters without SSRCs. Object members are
+		// always iterated in the same order so equal parameters get equal keys.
+		Json::Value canonical(data);
+
+		for (auto& jsonEncoding : canonical[JsonStringEncodings])
+		{
+			if (!jsonEncoding.isObject())
+				continue;
+
+			jsonEncoding.removeMember(JsonStringSsrc);
+
+			// Check with isMember() so missing members are not added as null.
+			if (jsonEncoding.isMember(JsonStringRtx) && jsonEncoding[JsonStringRtx].isObject())
+				jsonEncoding[JsonStringRtx].removeMember(JsonStringSsrc);
+
+			if (jsonEncoding.isMember(JsonStringFec) && jsonEncoding[JsonStringFec].isObject())
+				jsonEncoding[JsonStringFec].removeMember(JsonStringSsrc);
+		}
+
+		this->keyBuffer.resize(KeyBufferSize);
+
+		size_t keyLen = Channel::BinaryCodec::Encode(canonical, this->keyBuffer.data(), KeyBufferSize);
+
+		if (keyLen == 0)
+			MS_THROW_ERROR("rtpParameters too big");
+
+		std::string key(reinterpret_cast<const char*>(this->keyBuffer.data()), keyLen);
+		auto it = this->entries.find(key);
+
+		if (it != this->entries.end())
+		{
+			auto rtpParameters = it->second.lock();
+
+			if (rtpParameters)
+				return rtpParameters;
+		}
+
+		// NOTE: This may throw.
+		auto rtpParameters = std::make_shared<const SharedRtpParameters>(canonical);
+
+		// Not in the cache, so a good time to drop the entries no longer used.
+		RemoveUnused();
+
+		this->entries[key] = rtpParameters;
+
+		MS_DEBUG_DEV("new shared RTP parameters [entries:%zu]", this->entries.size());
+
+		return rtpParameters;
+	}
+
+	void RtpParametersCache::RemoveUnused()
+	{
+		MS_TRACE();
+
+		for (auto it = this->entries.begin(); it != this->entries.end();)
+		{
+			if (it->second.expired())
+				it = this->entries.erase(it);
+			else
+				++it;
+		}
+	}
+} // namespace RTC
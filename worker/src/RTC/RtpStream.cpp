@@ -242,6 +242,7 @@ namespace RTC
 		static const Json::StaticString JsonStringClockRate{ "clockRate" };
 		static const Json::StaticString JsonStringUseNack{ "useNack" };
 		static const Json::StaticString JsonStringUsePli{ "usePli" };
+		static const Json::StaticString JsonStringUseFir{ "useFir" };
 
 		Json::Value json(Json::objectValue);
 
@@ -251,6 +252,7 @@ namespace RTC
 		json[JsonStringClockRate]   = Json::UInt{ this->clockRate };
 		json[JsonStringUseNack]     = this->useNack;
 		json[JsonStringUsePli]      = this->usePli;
+		json[JsonStringUseFir]      = this->useFir;
 
 		return json;
 	}
@@ -11,6 +11,9 @@ namespace RTC
 	/* Static. */
 
 	static constexpr uint16_t StatusCheckPeriod{ 250 };
+	// Audio senders using DTX may send nothing during silence, so an audio stream
+	// is not considered inactive until no packet is received within this time.
+	static constexpr uint16_t AudioInactivityTimeout{ 5000 };
 
 	/* Instance methods. */
 
@@ -22,6 +25,8 @@ namespace RTC
 		if (this->params.useNack)
 			this->nackGenerator.reset(new RTC::NackGenerator(this));
 
+		this->decodingContext.reset(Codecs::GetDecodingContext(this->params.mimeType));
+
 		// Run the timer.
 		this->statusCheckTimer->Start(StatusCheckPeriod, StatusCheckPeriod);
 	}
@@ -62,7 +67,7 @@ namespace RTC
 
 		// Process the packet at codec level.
 		if (packet->GetPayloadType() == GetPayloadType())
-			Codecs::ProcessRtpPacket(packet, GetMimeType());
+			Codecs::ProcessRtpPacket(packet, GetMimeType(), this->decodingContext.get());
 
 		// Pass the packet to the NackGenerator.
 		if (this->params.useNack)
@@ -130,7 +135,7 @@ namespace RTC
 
 		// Process the packet at codec level.
 		if (packet->GetPayloadType() == GetPayloadType())
-			Codecs::ProcessRtpPacket(packet, GetMimeType());
+			Codecs::ProcessRtpPacket(packet, GetMimeType(), this->decodingContext.get());
 
 		// Pass the packet to the NackGenerator and return true just if this was a
 		// NACKed packet.
@@ -203,20 +208,28 @@ namespace RTC
 		this->lastSrTimestamp += report->GetNtpFrac() >> 16;
 	}
 
-	void RtpStreamRecv::RequestKeyFrame()
+	void RtpStreamRecv::RequestKeyFrame(bool force)
 	{
 		MS_TRACE();
 
-		if (this->params.usePli)
+		if (this->params.usePli || this->params.useFir)
 		{
 			// Reset NackGenerator.
 			if (this->params.useNack)
 				this->nackGenerator->Reset();
 
-			this->listener->OnRtpStreamRecvPliRequired(this);
+			this->listener->OnRtpStreamRecvKeyFrameRequired(this, force);
 		}
 	}
 
+	void RtpStreamRecv::RequestRtpRetransmission(const std::vector<uint16_t>& seqs)
+	{
+		MS_TRACE();
+
+		if (this->params.useNack)
+			this->nackGenerator->RequestPackets(seqs);
+	}
+
 	void RtpStreamRecv::CalculateJitter(uint32_t rtpTimestamp)
 	{
 		MS_TRACE();
@@ -239,8 +252,14 @@ namespace RTC
 		MS_TRACE();
 
 		auto now = DepLibUV::GetTime();
+		bool inactive;
+
+		if (this->params.mimeType.type == RTC::RtpCodecMimeType::Type::AUDIO)
+			inactive = now - this->maxPacketMs > AudioInactivityTimeout;
+		else
+			inactive = this->transmissionCounter.GetRate(now) == 0;
 
-		if (this->transmissionCounter.GetRate(now) == 0)
+		if (inactive)
 		{
 			if (this->active)
 			{
@@ -255,7 +274,8 @@ namespace RTC
 		}
 	}
 
-	void RtpStreamRecv::OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers)
+	void RtpStreamRecv::OnNackGeneratorNackRequired(
+	  const std::vector<RTC::NackGenerator::NackItem>& nackItems)
 	{
 		MS_TRACE();
 
@@ -263,12 +283,12 @@ namespace RTC
 
 		MS_DEBUG_TAG(
 		  rtx,
-		  "triggering NACK [ssrc:%" PRIu32 ", first seq:%" PRIu16 ", num packets:%zu]",
+		  "triggering NACK [ssrc:%" PRIu32 ", first seq:%" PRIu16 ", num items:%zu]",
 		  this->params.ssrc,
-		  seqNumbers[0],
-		  seqNumbers.size());
+		  nackItems[0].packetId,
+		  nackItems.size());
 
-		this->listener->OnRtpStreamRecvNackRequired(this, seqNumbers);
+		this->listener->OnRtpStreamRecvNackRequired(this, nackItems);
 	}
 
 	void RtpStreamRecv::OnNackGeneratorKeyFrameRequired()
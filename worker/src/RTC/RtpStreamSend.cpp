@@ -11,8 +11,12 @@ namespace RTC
 {
 	/* Static. */
 
-	// Don't retransmit packets older than this (ms).
+	// Don't retransmit packets older than the retransmission window, which is
+	// computed from the RTT and the jitter and kept within these bounds (ms).
+	static constexpr uint32_t MinRetransmissionDelay{ 300 };
 	static constexpr uint32_t MaxRetransmissionDelay{ 2000 };
+	static constexpr uint32_t RetransmissionRttFactor{ 3 };
+	static constexpr uint32_t RetransmissionJitterFactor{ 4 };
 	static constexpr uint32_t DefaultRtt{ 100 };
 
 	/* Instance methods. */
@@ -36,11 +40,13 @@ namespace RTC
 		static const std::string Type = "outbound-rtp";
 		static const Json::StaticString JsonStringType{ "type" };
 		static const Json::StaticString JsonStringRtt{ "roundTripTime" };
+		static const Json::StaticString JsonStringRetransmissionWindow{ "retransmissionWindow" };
 
 		Json::Value json = RtpStream::GetStats();
 
-		json[JsonStringType] = Type;
-		json[JsonStringRtt]  = Json::UInt{ static_cast<uint32_t>(this->rtt) };
+		json[JsonStringType]                 = Type;
+		json[JsonStringRtt]                  = Json::UInt{ static_cast<uint32_t>(this->rtt) };
+		json[JsonStringRetransmissionWindow] = Json::UInt{ GetRetransmissionWindow() };
 
 		return json;
 	}
@@ -91,11 +97,17 @@ namespace RTC
 
 		this->packetsLost  = report->GetTotalLost();
 		this->fractionLost = report->GetFractionLost();
+		this->jitter       = report->GetJitter();
 	}
 
 	// This method looks for the requested RTP packets and inserts them into the
 	// given container (and set to null the next container position).
-	void RtpStreamSend::RequestRtpRetransmission(
+	/**
+	 * Fills the container with the requested packets to be retransmitted.
+	 * Returns a bitmask of the requested packets not present in the buffer (bit
+	 * 0 refers to seq, bit 1 to seq + 1, etc).
+	 */
+	uint32_t RtpStreamSend::RequestRtpRetransmission(
 	  uint16_t seq, uint16_t bitmask, std::vector<RTC::RtpPacket*>& container)
 	{
 		MS_TRACE();
@@ -111,12 +123,15 @@ namespace RTC
 		{
 			MS_WARN_TAG(rtx, "NACK not negotiated");
 
-			return;
+			return 0;
 		}
 
+		// All the requested packets.
+		uint32_t requestedBitmask = 1 | (static_cast<uint32_t>(bitmask) << 1);
+
 		// If the buffer is empty just return.
 		if (this->buffer.empty())
-			return;
+			return requestedBitmask;
 
 		uint16_t firstSeq = seq;
 		uint16_t lastSeq  = firstSeq + MaxRequestedPackets - 1;
@@ -142,14 +157,20 @@ namespace RTC
 			  bufferFirstSeq,
 			  bufferLastSeq);
 
-			return;
+			// Packets newer than the buffer were never sent.
+			if (SeqManager<uint16_t>::IsSeqHigherThan(firstSeq, bufferLastSeq))
+				return requestedBitmask;
+
+			return 0;
 		}
 
 		// Look for each requested packet.
-		uint64_t now = DepLibUV::GetTime();
-		uint16_t rtt = (this->rtt != 0u ? this->rtt : DefaultRtt);
+		uint64_t now                  = DepLibUV::GetTime();
+		uint16_t rtt                  = (this->rtt != 0u ? this->rtt : DefaultRtt);
+		uint32_t retransmissionWindow = GetRetransmissionWindow();
 		bool requested{ true };
 		size_t containerIdx{ 0 };
+		uint32_t missingBitmask{ 0 };
 
 		// Some variables for debugging.
 		uint16_t origBitmask = bitmask;
@@ -165,6 +186,8 @@ namespace RTC
 
 			if (requested)
 			{
+				bool found = false;
+
 				for (; bufferIt != this->buffer.end(); ++bufferIt)
 				{
 					auto currentSeq = (*bufferIt).seq;
@@ -172,14 +195,16 @@ namespace RTC
 					// Found.
 					if (currentSeq == seq)
 					{
+						found = true;
+
 						auto currentPacket = (*bufferIt).packet;
 						// Calculate how the elapsed time between the max timestampt seen and
 						// the requested packet's timestampt (in ms).
 						uint32_t diffTs = this->maxPacketTs - currentPacket->GetTimestamp();
 						uint32_t diffMs = diffTs * 1000 / this->params.clockRate;
 
-						// Just provide the packet if no older than MaxRetransmissionDelay ms.
-						if (diffMs > MaxRetransmissionDelay)
+						// Just provide the packet if no older than the retransmission window.
+						if (diffMs > retransmissionWindow)
 						{
 							if (!tooOldPacketFound)
 							{
@@ -190,7 +215,7 @@ namespace RTC
 								  "ignoring retransmission for too old packet "
 								  "[seq:%" PRIu16 ", max age:%" PRIu32 "ms, packet age:%" PRIu32 "ms]",
 								  currentPacket->GetSequenceNumber(),
-								  MaxRetransmissionDelay,
+								  retransmissionWindow,
 								  diffMs);
 
 								tooOldPacketFound = true;
@@ -231,6 +256,11 @@ namespace RTC
 					if (SeqManager<uint16_t>::IsSeqHigherThan(currentSeq, seq))
 						break;
 				}
+
+				// Packets older than the buffer were already discarded, but the ones
+				// within the buffer range were never sent.
+				if (!found && SeqManager<uint16_t>::IsSeqHigherThan(seq, bufferFirstSeq))
+					missingBitmask |= uint32_t{ 1 } << static_cast<uint16_t>(seq - firstSeq);
 			}
 
 			requested = (bitmask & 1) != 0;
@@ -272,6 +302,33 @@ namespace RTC
 
 		// Set the next container element to null.
 		container[containerIdx] = nullptr;
+
+		return missingBitmask;
+	}
+
+	/**
+	 * Max age (ms) of a packet worth being retransmitted. Beyond a few RTTs
+	 * (plus the jitter the receiver is absorbing) the retransmitted packet is
+	 * likely to arrive too late to be played.
+	 */
+	uint32_t RtpStreamSend::GetRetransmissionWindow() const
+	{
+		MS_TRACE();
+
+		uint32_t rtt = (this->rtt != 0u ? static_cast<uint32_t>(this->rtt) : DefaultRtt);
+		uint32_t jitterMs{ 0 };
+
+		if (this->params.clockRate != 0u)
+			jitterMs = static_cast<uint64_t>(this->jitter) * 1000 / this->params.clockRate;
+
+		uint32_t window = RetransmissionRttFactor * rtt + RetransmissionJitterFactor * jitterMs;
+
+		if (window < MinRetransmissionDelay)
+			window = MinRetransmissionDelay;
+		else if (window > MaxRetransmissionDelay)
+			window = MaxRetransmissionDelay;
+
+		return window;
 	}
 
 	RTC::RTCP::SenderReport* RtpStreamSend::GetRtcpSenderReport(uint64_t now)
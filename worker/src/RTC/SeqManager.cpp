@@ -3,6 +3,7 @@
 
 #include "RTC/SeqManager.hpp"
 #include "Logger.hpp"
+#include <iterator> // std::distance()
 
 namespace RTC
 {
@@ -49,6 +50,9 @@ namespace RTC
 		// Update base.
 		this->base = this->maxOutput - input + 1;
 
+		// Update the first output of this sync.
+		this->syncOutput = this->maxOutput + 1;
+
 		// Update maxInput.
 		this->maxInput = input;
 
@@ -78,10 +82,15 @@ namespace RTC
 		// There are dropped inputs. Synchronize.
 		if (!this->dropped.empty())
 		{
-			// Delete dropped inputs older than input - MaxValue/2.
+			// Delete dropped inputs older than input - MaxValue/2. They are lower than
+			// any input to come, so they are moved into the base.
 			auto it = this->dropped.lower_bound(input - MaxValue / 2);
+
+			this->base -= static_cast<T>(std::distance(this->dropped.begin(), it));
 			this->dropped.erase(this->dropped.begin(), it);
 
+			base = this->base;
+
 			// Check whether this input was dropped.
 			it = this->dropped.find(input);
 
@@ -93,10 +102,7 @@ namespace RTC
 			}
 
 			// Count dropped entries before 'input' in order to adapt the base.
-			size_t dropped = std::count_if(
-			  this->dropped.begin(), this->dropped.end(), [&input](T i) { return i < input; });
-
-			base -= dropped;
+			base -= static_cast<T>(CountDroppedLowerThan(input));
 		}
 
 		output = input + base;
@@ -112,11 +118,72 @@ namespace RTC
 		// New output is higher than the maximum seen. But less than acceptable units higher.
 		// Keep it as the maximum seen. See Sync().
 		if (odelta < MaxValue / 2)
+		{
 			this->maxOutput = output;
 
+			// Outputs older than MaxValue/2 can not be told apart from future ones.
+			// Keep the first output of the sync within that range. See GetInput().
+			if (static_cast<T>(this->maxOutput - this->syncOutput) > MaxValue / 2)
+				this->syncOutput = this->maxOutput - MaxValue / 2;
+		}
+
 		return true;
 	}
 
+	/**
+	 * Reverse of Input(). Returns false if the given output does not belong to
+	 * the current sync or has not been produced yet.
+	 */
+	template<typename T>
+	bool SeqManager<T>::GetInput(const T output, T& input) const
+	{
+		if (
+		  SeqManager<T>::IsSeqLowerThan(output, this->syncOutput) ||
+		  SeqManager<T>::IsSeqHigherThan(output, this->maxOutput))
+		{
+			return false;
+		}
+
+		input = output - this->base;
+
+		// Undo the base adaptation due to dropped inputs (see Input()), skipping
+		// dropped inputs since they never produced an output.
+		while (!this->dropped.empty())
+		{
+			if (this->dropped.find(input) != this->dropped.end())
+			{
+				++input;
+
+				continue;
+			}
+
+			T candidate = output - this->base + static_cast<T>(CountDroppedLowerThan(input));
+
+			if (candidate == input)
+				break;
+
+			input = candidate;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Number of dropped inputs lower than the given one. Dropped inputs are
+	 * sorted, and in the usual case (in order input) all of them are lower.
+	 */
+	template<typename T>
+	size_t SeqManager<T>::CountDroppedLowerThan(T input) const
+	{
+		if (this->dropped.empty())
+			return 0;
+
+		if (SeqManager<T>::IsSeqLowerThan(*this->dropped.rbegin(), input))
+			return this->dropped.size();
+
+		return std::distance(this->dropped.begin(), this->dropped.lower_bound(input));
+	}
+
 	template<typename T>
 	T SeqManager<T>::GetMaxInput() const
 	{
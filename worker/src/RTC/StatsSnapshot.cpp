@@ -0,0 +1,128 @@
+#define MS_CLASS "RTC::StatsSnapshot"
+// #define MS_LOG_DEV
+
+#include "RTC/StatsSnapshot.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	/**
+	 * Start a new snapshot. Counters of the records added to it will be relative
+	 * to the previous snapshot if delta is true.
+	 */
+	void StatsSnapshot::Begin(uint64_t now, bool delta)
+	{
+		MS_TRACE();
+
+		// Counters of the last snapshot become the reference ones. Those of
+		// objects no longer present are dropped.
+		for (size_t idx{ 0 }; idx < 3; ++idx)
+		{
+			this->previousCounters[idx].swap(this->currentCounters[idx]);
+			this->currentCounters[idx].clear();
+		}
+
+		this->delta       = delta;
+		this->recordCount = 0;
+
+		this->buffer.resize(HeaderSize);
+
+		this->buffer[0] = Version;
+		this->buffer[1] = delta ? 0x01 : 0x00;
+		Utils::Byte::Set2Bytes(this->buffer.data(), 2, static_cast<uint16_t>(RecordSize));
+		Utils::Byte::Set4Bytes(this->buffer.data(), 4, 0);
+		Utils::Byte::Set8Bytes(this->buffer.data(), 8, now);
+	}
+
+	void StatsSnapshot::AddRecord(const Record& record)
+	{
+		MS_TRACE();
+
+		// The streams of a Producer are told apart by their SSRC.
+		size_t typeIdx = static_cast<size_t>(record.type) - 1;
+		uint64_t key   = (static_cast<uint64_t>(record.id) << 32) | record.ssrc;
+		Counters counters;
+
+		MS_ASSERT(typeIdx < 3, "invalid record type");
+
+		counters.packetCount   = record.packetCount;
+		counters.byteCount     = record.byteCount;
+		counters.packetsLost   = record.packetsLost;
+		counters.nackCount     = record.nackCount;
+		counters.pliCount      = record.pliCount;
+		counters.firCount      = record.firCount;
+		counters.bytesReceived = record.bytesReceived;
+		counters.bytesSent     = record.bytesSent;
+
+		this->currentCounters[typeIdx][key] = counters;
+
+		if (this->delta)
+		{
+			auto it = this->previousCounters[typeIdx].find(key);
+
+			if (it != this->previousCounters[typeIdx].end())
+			{
+				auto& previous = it->second;
+
+				// A counter lower than before means the object was reset (i.e. a stream
+				// created again with the same SSRC), so report it as a new record.
+				bool reset = counters.packetCount < previous.packetCount ||
+				             counters.byteCount < previous.byteCount ||
+				             counters.packetsLost < previous.packetsLost ||
+				             counters.nackCount < previous.nackCount ||
+				             counters.pliCount < previous.pliCount ||
+				             counters.firCount < previous.firCount ||
+				             counters.bytesReceived < previous.bytesReceived ||
+				             counters.bytesSent < previous.bytesSent;
+
+				if (!reset)
+				{
+					counters.packetCount -= previous.packetCount;
+					counters.byteCount -= previous.byteCount;
+					counters.packetsLost -= previous.packetsLost;
+					counters.nackCount -= previous.nackCount;
+					counters.pliCount -= previous.pliCount;
+					counters.firCount -= previous.firCount;
+					counters.bytesReceived -= previous.bytesReceived;
+					counters.bytesSent -= previous.bytesSent;
+				}
+			}
+		}
+
+		size_t offset = this->buffer.size();
+
+		// New elements are zero, so reserved fields are already set.
+		this->buffer.resize(offset + RecordSize);
+
+		uint8_t* data = this->buffer.data() + offset;
+
+		data[0] = static_cast<uint8_t>(record.type);
+		Utils::Byte::Set4Bytes(data, 4, record.id);
+
+		if (record.type == RecordType::TRANSPORT)
+		{
+			Utils::Byte::Set8Bytes(data, 16, counters.bytesReceived);
+			Utils::Byte::Set8Bytes(data, 24, counters.bytesSent);
+		}
+		else
+		{
+			data[1] = record.fractionLost;
+			Utils::Byte::Set2Bytes(data, 2, record.rtt);
+			Utils::Byte::Set4Bytes(data, 8, record.ssrc);
+			Utils::Byte::Set4Bytes(data, 12, record.bitrate);
+			Utils::Byte::Set8Bytes(data, 16, counters.packetCount);
+			Utils::Byte::Set8Bytes(data, 24, counters.byteCount);
+			Utils::Byte::Set4Bytes(data, 32, counters.packetsLost);
+			Utils::Byte::Set4Bytes(data, 36, counters.nackCount);
+			Utils::Byte::Set4Bytes(data, 40, counters.pliCount);
+			Utils::Byte::Set4Bytes(data, 44, counters.firCount);
+		}
+
+		this->recordCount++;
+
+		Utils::Byte::Set4Bytes(this->buffer.data(), 4, static_cast<uint32_t>(this->recordCount));
+	}
+} // namespace RTC
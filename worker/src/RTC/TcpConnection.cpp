@@ -4,6 +4,7 @@
 #include "RTC/TcpConnection.hpp"
 #include "Logger.hpp"
 #include "Utils.hpp"
+#include "RTC/PacketLatency.hpp"
 #include <cstring> // std::memmove()
 
 namespace RTC
@@ -66,6 +67,8 @@ namespace RTC
 				// Update received bytes and notify the listener.
 				if (packetLen != 0)
 				{
+					RTC::PacketLatency::Ingress ingress;
+
 					this->recvBytes += packetLen;
 					this->listener->OnPacketRecv(this, packet, packetLen);
 				}
@@ -167,6 +167,18 @@ namespace RTC
 
 		if (producer->GetTransportHeaderExtensionIds().rid != 0u)
 			this->headerExtensionIds.rid = producer->GetTransportHeaderExtensionIds().rid;
+
+		if (producer->GetTransportHeaderExtensionIds().frameMarking != 0u)
+		{
+			this->headerExtensionIds.frameMarking =
+			  producer->GetTransportHeaderExtensionIds().frameMarking;
+		}
+
+		if (producer->GetTransportHeaderExtensionIds().dependencyDescriptor != 0u)
+		{
+			this->headerExtensionIds.dependencyDescriptor =
+			  producer->GetTransportHeaderExtensionIds().dependencyDescriptor;
+		}
 	}
 
 	void Transport::HandleConsumer(RTC::Consumer* consumer)
@@ -497,17 +509,14 @@ namespace RTC
 				continue;
 
 			// NOTE: Use & since, otherwise, a full copy will be retrieved.
-			auto& rtpParameters = consumer->GetParameters();
-
-			for (auto& encoding : rtpParameters.encodings)
-			{
-				if (encoding.ssrc == ssrc)
-					return consumer;
-				if (encoding.hasFec && encoding.fec.ssrc == ssrc)
-					return consumer;
-				if (encoding.hasRtx && encoding.rtx.ssrc == ssrc)
-					return consumer;
-			}
+			auto& encoding = consumer->GetEncoding();
+
+			if (encoding.ssrc == ssrc)
+				return consumer;
+			if (encoding.hasFec && encoding.fec.ssrc == ssrc)
+				return consumer;
+			if (encoding.hasRtx && encoding.rtx.ssrc == ssrc)
+				return consumer;
 		}
 
 		return nullptr;
@@ -569,8 +578,24 @@ namespace RTC
 		// Do nothing.
 	}
 
+	void Transport::OnConsumerRetransmissionRequired(
+	  RTC::Consumer* /*consumer*/,
+	  RTC::RtpEncodingParameters::Profile /*profile*/,
+	  const std::vector<uint16_t>& /*seqs*/)
+	{
+		// Do nothing.
+	}
+
+	void Transport::OnConsumerRtpPacketRetransmitted(
+	  RTC::Consumer* /*consumer*/, uint64_t /*latency*/)
+	{
+		// Do nothing.
+	}
+
 	void Transport::OnTimer(Timer* timer)
 	{
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		if (timer == this->rtcpTimer)
 		{
 			uint64_t interval = RTC::RTCP::MaxVideoIntervalMs;
@@ -6,6 +6,7 @@
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Settings.hpp"
+#include "RTC/PacketLatency.hpp"
 #include "Utils.hpp"
 #include <string>
 
@@ -238,6 +239,8 @@ namespace RTC
 			return;
 		}
 
+		RTC::PacketLatency::Ingress ingress;
+
 		// Notify the reader.
 		this->listener->OnPacketRecv(this, data, len, addr);
 	}
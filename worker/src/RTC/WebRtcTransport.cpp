@@ -257,6 +257,8 @@ namespace RTC
 		static const Json::StaticString JsonStringAbsSendTime{ "absSendTime" };
 		static const Json::StaticString JsonStringMid{ "mid" };
 		static const Json::StaticString JsonStringRid{ "rid" };
+		static const Json::StaticString JsonStringFrameMarking{ "frameMarking" };
+		static const Json::StaticString JsonStringDependencyDescriptor{ "dependencyDescriptor" };
 		static const Json::StaticString JsonStringRtpListener{ "rtpListener" };
 
 		Json::Value json(Json::objectValue);
@@ -352,6 +354,15 @@ namespace RTC
 		if (this->headerExtensionIds.rid != 0u)
 			jsonHeaderExtensionIds[JsonStringRid] = this->headerExtensionIds.rid;
 
+		if (this->headerExtensionIds.frameMarking != 0u)
+			jsonHeaderExtensionIds[JsonStringFrameMarking] = this->headerExtensionIds.frameMarking;
+
+		if (this->headerExtensionIds.dependencyDescriptor != 0u)
+		{
+			jsonHeaderExtensionIds[JsonStringDependencyDescriptor] =
+			  this->headerExtensionIds.dependencyDescriptor;
+		}
+
 		json[JsonStringHeaderExtensionIds] = jsonHeaderExtensionIds;
 
 		// Add rtpListener.
@@ -390,12 +401,17 @@ namespace RTC
 		static const Json::StaticString JsonStringRemoteAvailableSendBw{ "remoteAvailableSendBw" };
 		static const Json::StaticString JsonStringRemoteAvailableSendBwValue{ "bitrate" };
 		static const Json::StaticString JsonStringRemoteAvailableSendBwSsrcs{ "ssrcs" };
+		static const Json::StaticString JsonStringCpuTime{ "cpuTime" };
+		static const Json::StaticString JsonStringCpuUsage{ "cpuUsage" };
 
+		uint64_t now = DepLibUV::GetTime();
 		Json::Value json(Json::objectValue);
 
 		json[JsonStringType]      = Type;
-		json[JsonStringTimestamp] = Json::UInt64{ DepLibUV::GetTime() };
+		json[JsonStringTimestamp] = Json::UInt64{ now };
 		json[JsonStringId]        = Json::UInt{ this->transportId };
+		json[JsonStringCpuTime]   = Json::UInt64{ this->cpuUsage.GetTime() };
+		json[JsonStringCpuUsage]  = Json::UInt{ this->cpuUsage.GetRate(now) };
 
 		if (this->selectedTuple != nullptr)
 		{
@@ -564,6 +580,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		if (!IsConnected())
 			return;
 
@@ -592,6 +610,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		if (!IsConnected())
 			return;
 
@@ -616,6 +636,22 @@ namespace RTC
 		this->selectedTuple->Send(data, len);
 	}
 
+	size_t WebRtcTransport::GetRecvBytes() const
+	{
+		if (this->selectedTuple == nullptr)
+			return 0;
+
+		return this->selectedTuple->GetRecvBytes();
+	}
+
+	size_t WebRtcTransport::GetSentBytes() const
+	{
+		if (this->selectedTuple == nullptr)
+			return 0;
+
+		return this->selectedTuple->GetSentBytes();
+	}
+
 	bool WebRtcTransport::IsConnected() const
 	{
 		return (
@@ -798,6 +834,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		// Ensure DTLS is connected.
 		if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
 		{
@@ -874,6 +912,17 @@ namespace RTC
 			packet->AddExtensionMapping(
 			  RtpHeaderExtensionUri::Type::RTP_STREAM_ID, this->headerExtensionIds.rid);
 		}
+		if (this->headerExtensionIds.frameMarking != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::FRAME_MARKING, this->headerExtensionIds.frameMarking);
+		}
+		if (this->headerExtensionIds.dependencyDescriptor != 0u)
+		{
+			packet->AddExtensionMapping(
+			  RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR,
+			  this->headerExtensionIds.dependencyDescriptor);
+		}
 
 		// Feed the remote bitrate estimator (REMB).
 		uint32_t absSendTime;
@@ -918,6 +967,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		RTC::CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
 		// Ensure DTLS is connected.
 		if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
 		{
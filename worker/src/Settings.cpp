@@ -67,6 +67,8 @@ void Settings::SetConfiguration(int argc, char* argv[])
 		{ "rtcMaxPort",          optional_argument, nullptr, 'M' },
 		{ "dtlsCertificateFile", optional_argument, nullptr, 'c' },
 		{ "dtlsPrivateKeyFile",  optional_argument, nullptr, 'p' },
+		{ "metricsFile",         optional_argument, nullptr, 'f' },
+		{ "metricsInterval",     optional_argument, nullptr, 'i' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
@@ -131,6 +133,15 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				Settings::configuration.dtlsPrivateKeyFile = stringValue;
 				break;
 
+			case 'f':
+				stringValue                         = std::string(optarg);
+				Settings::configuration.metricsFile = stringValue;
+				break;
+
+			case 'i':
+				Settings::configuration.metricsInterval = std::stoul(optarg);
+				break;
+
 			// Invalid option.
 			case '?':
 				if (isprint(optopt) != 0)
@@ -173,6 +184,9 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	// Validate RTC ports.
 	Settings::SetRtcPorts();
 
+	if (Settings::configuration.metricsInterval == 0)
+		MS_THROW_ERROR("metricsInterval can not be 0");
+
 	// Set DTLS certificate files (if provided),
 	Settings::SetDtlsCertificateAndPrivateKeyFiles();
 }
@@ -260,6 +274,12 @@ void Settings::PrintConfiguration()
 		MS_DEBUG_TAG(
 		  info, "  dtlsPrivateKeyFile  : \"%s\"", Settings::configuration.dtlsPrivateKeyFile.c_str());
 	}
+	if (!Settings::configuration.metricsFile.empty())
+	{
+		MS_DEBUG_TAG(
+		  info, "  metricsFile         : \"%s\"", Settings::configuration.metricsFile.c_str());
+	}
+	MS_DEBUG_TAG(info, "  metricsInterval     : %" PRIu32, Settings::configuration.metricsInterval);
 
 	MS_DEBUG_TAG(info, "</configuration>");
 }
@@ -0,0 +1,178 @@
+#define MS_CLASS "SharedMetrics"
+// #define MS_LOG_DEV
+
+#include "SharedMetrics.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+#include "Utils.hpp"
+#include <cerrno>
+#include <cstring>    // std::memcpy(), std::strerror()
+#include <new>        // placement new
+#include <fcntl.h>    // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <unistd.h>   // ftruncate(), close(), unlink()
+
+static_assert(sizeof(SharedMetrics::Header) <= SharedMetrics::HeaderSize, "header too big");
+
+/* Static methods. */
+
+/**
+ * Copy the snapshot in the given region. Returns false if the writer kept
+ * updating it while reading.
+ */
+bool SharedMetrics::Read(const uint8_t* region, std::vector<uint8_t>& snapshot, uint64_t& loopLag)
+{
+	MS_TRACE();
+
+	static constexpr size_t MaxRetries{ 100 };
+
+	auto* header = reinterpret_cast<const Header*>(region);
+
+	for (size_t retry{ 0 }; retry < MaxRetries; ++retry)
+	{
+		uint32_t sequence = header->sequence.load(std::memory_order_acquire);
+
+		// Being written.
+		if ((sequence & 1) != 0)
+			continue;
+
+		size_t size = header->size;
+
+		if (size > header->capacity)
+			continue;
+
+		snapshot.resize(size);
+		std::memcpy(snapshot.data(), region + HeaderSize, size);
+		loopLag = header->loopLag;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (header->sequence.load(std::memory_order_relaxed) == sequence)
+			return true;
+	}
+
+	return false;
+}
+
+/* Instance methods. */
+
+SharedMetrics::SharedMetrics(Listener* listener, const std::string& path, uint64_t interval)
+  : listener(listener), path(path), interval(interval)
+{
+	MS_TRACE();
+
+	this->fd = open(this->path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if (this->fd == -1)
+		MS_THROW_ERROR("open() failed for '%s': %s", this->path.c_str(), std::strerror(errno));
+
+	// The file is sparse, only the pages written take memory.
+	if (ftruncate(this->fd, HeaderSize + Capacity) == -1)
+	{
+		int error = errno;
+
+		close(this->fd);
+		unlink(this->path.c_str());
+
+		MS_THROW_ERROR("ftruncate() failed: %s", std::strerror(error));
+	}
+
+	void* addr =
+	  mmap(nullptr, HeaderSize + Capacity, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+
+	if (addr == MAP_FAILED)
+	{
+		int error = errno;
+
+		close(this->fd);
+		unlink(this->path.c_str());
+
+		MS_THROW_ERROR("mmap() failed: %s", std::strerror(error));
+	}
+
+	this->region = static_cast<uint8_t*>(addr);
+
+	auto* header = new (this->region) Header();
+
+	header->magic    = Magic;
+	header->version  = Version;
+	header->capacity = static_cast<uint32_t>(Capacity);
+	header->sequence.store(0, std::memory_order_release);
+
+	// Publish an empty snapshot so readers never find an empty region.
+	Publish();
+
+	this->timer = new Timer(this);
+
+	this->timer->Start(this->interval, this->interval);
+	this->lastTick = uv_hrtime() / 1000;
+
+	MS_DEBUG_TAG(
+	  info, "publishing metrics every %" PRIu64 "ms into '%s'", this->interval, this->path.c_str());
+}
+
+SharedMetrics::~SharedMetrics()
+{
+	MS_TRACE();
+
+	if (this->timer != nullptr)
+		this->timer->Destroy();
+
+	munmap(this->region, HeaderSize + Capacity);
+	close(this->fd);
+
+	// Don't let readers find metrics of a worker that no longer exists.
+	unlink(this->path.c_str());
+}
+
+void SharedMetrics::Publish()
+{
+	MS_TRACE();
+
+	uint64_t now = DepLibUV::GetTime();
+
+	this->snapshot.Begin(now, false);
+	this->listener->OnSharedMetricsCollect(this, this->snapshot, now);
+
+	auto* header       = reinterpret_cast<Header*>(this->region);
+	size_t size        = this->snapshot.GetSize();
+	size_t recordCount = this->snapshot.GetRecordCount();
+	uint32_t flags     = 0;
+	uint32_t sequence  = header->sequence.load(std::memory_order_relaxed);
+
+	// Leave out the records that do not fit.
+	if (size > Capacity)
+	{
+		recordCount = (Capacity - RTC::StatsSnapshot::HeaderSize) / RTC::StatsSnapshot::RecordSize;
+		size        = RTC::StatsSnapshot::HeaderSize + (recordCount * RTC::StatsSnapshot::RecordSize);
+		flags       = FlagTruncated;
+	}
+
+	header->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	std::memcpy(this->region + HeaderSize, this->snapshot.GetData(), size);
+
+	if ((flags & FlagTruncated) != 0)
+		Utils::Byte::Set4Bytes(this->region + HeaderSize, 4, static_cast<uint32_t>(recordCount));
+
+	header->size    = static_cast<uint32_t>(size);
+	header->flags   = flags;
+	header->loopLag = this->loopLag;
+
+	header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedMetrics::OnTimer(Timer* /*timer*/)
+{
+	MS_TRACE();
+
+	uint64_t now      = uv_hrtime() / 1000;
+	uint64_t expected = this->lastTick + (this->interval * 1000);
+
+	this->loopLag  = now > expected ? now - expected : 0;
+	this->lastTick = now;
+
+	Publish();
+}
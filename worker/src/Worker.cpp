@@ -4,6 +4,7 @@
 #include "Worker.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 #include "Settings.hpp"
 #include <json/json.h>
@@ -31,6 +32,21 @@ Worker::Worker(Channel::UnixStreamSocket* channel) : channel(channel)
 	this->signalsHandler->AddSignal(SIGINT, "INT");
 	this->signalsHandler->AddSignal(SIGTERM, "TERM");
 
+	// Periodically notify the loop metrics.
+	this->loopMetricsTimer = new Timer(this);
+	this->loopMetricsTimer->Start(
+	  Settings::configuration.metricsInterval, Settings::configuration.metricsInterval);
+
+	// Publish metrics into a shared memory region if requested.
+	if (!Settings::configuration.metricsFile.empty())
+	{
+		this->sharedMetrics = new SharedMetrics(
+		  this, Settings::configuration.metricsFile, Settings::configuration.metricsInterval);
+	}
+
+	// Send the logs written while starting.
+	Logger::Flush();
+
 	MS_DEBUG_DEV("starting libuv loop");
 	DepLibUV::RunLoop();
 	MS_DEBUG_DEV("libuv loop ended");
@@ -58,6 +74,16 @@ void Worker::Close()
 	if (this->signalsHandler != nullptr)
 		this->signalsHandler->Destroy();
 
+	// Close the loop metrics Timer and the loop metrics handles.
+	if (this->loopMetricsTimer != nullptr)
+		this->loopMetricsTimer->Destroy();
+
+	LoopMetrics::ClassDestroy();
+
+	// Delete the SharedMetrics (it also removes its file).
+	delete this->sharedMetrics;
+	this->sharedMetrics = nullptr;
+
 	// Close all the Routers.
 	// NOTE: Upon Router closure the onRouterClosed() method is called, which
 	// removes it from the map, so this is the safe way to iterate the map
@@ -73,6 +99,9 @@ void Worker::Close()
 	// Delete the Notifier.
 	delete this->notifier;
 
+	// Send the pending logs and close the Logger check handle.
+	Logger::ClassDestroy();
+
 	// Close the Channel socket.
 	if (this->channel != nullptr)
 		this->channel->Destroy();
@@ -137,11 +166,15 @@ void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::R
 		{
 			static const Json::StaticString JsonStringWorkerId{ "workerId" };
 			static const Json::StaticString JsonStringRouters{ "routers" };
+			static const Json::StaticString JsonStringDroppedLogRecords{ "droppedLogRecords" };
+			static const Json::StaticString JsonStringLoop{ "loop" };
 
 			Json::Value json(Json::objectValue);
 			Json::Value jsonRouters(Json::arrayValue);
 
-			json[JsonStringWorkerId] = Logger::id;
+			json[JsonStringWorkerId]          = Logger::id;
+			json[JsonStringDroppedLogRecords] = Json::UInt64{ Logger::droppedRecords };
+			json[JsonStringLoop]              = LoopMetrics::ToJson();
 
 			for (auto& kv : this->routers)
 			{
@@ -209,6 +242,79 @@ void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::R
 			break;
 		}
 
+		case Channel::Request::MethodId::WORKER_BATCH:
+		{
+			static const Json::StaticString JsonStringRequests{ "requests" };
+			static const Json::StaticString JsonStringResponses{ "responses" };
+			static const Json::StaticString JsonStringRejected{ "rejected" };
+			static const Json::StaticString JsonStringReason{ "reason" };
+
+			auto& jsonRequests = request->data[JsonStringRequests];
+
+			if (!jsonRequests.isArray())
+			{
+				request->Reject("missing data.requests");
+
+				return;
+			}
+
+			if (jsonRequests.size() > Channel::Request::BatchMaxRequests)
+			{
+				request->Reject("too many requests in batch");
+
+				return;
+			}
+
+			Json::Value data(Json::objectValue);
+			size_t pending = jsonRequests.size();
+
+			// Requests are run in order within this single loop iteration. Each one
+			// gets its own response, so a rejected request does not affect the others.
+			// Once the batch response is full the remaining requests are not run.
+			for (auto& jsonRequest : jsonRequests)
+			{
+				Json::Value jsonResponse(Json::objectValue);
+
+				--pending;
+
+				if (request->batchFull)
+				{
+					request->AddBatchResponse(jsonResponse, pending);
+
+					continue;
+				}
+
+				try
+				{
+					Channel::Request batchedRequest(request, jsonRequest);
+
+					if (batchedRequest.methodId == Channel::Request::MethodId::WORKER_BATCH)
+						batchedRequest.Reject("nested batch not allowed");
+					else
+						OnChannelRequest(this->channel, &batchedRequest);
+
+					// Some requests are not replied when they have no effect.
+					if (!batchedRequest.replied)
+						batchedRequest.Accept();
+
+					jsonResponse = batchedRequest.reply;
+				}
+				catch (const MediaSoupError& error)
+				{
+					jsonResponse[JsonStringRejected] = true;
+					jsonResponse[JsonStringReason]   = error.what();
+				}
+
+				request->AddBatchResponse(jsonResponse, pending);
+			}
+
+			data[JsonStringResponses].swap(request->batchResponses);
+
+			request->Accept(data);
+
+			break;
+		}
+
 		case Channel::Request::MethodId::ROUTER_CLOSE:
 		{
 			RTC::Router* router;
@@ -238,11 +344,15 @@ void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::R
 		}
 
 		case Channel::Request::MethodId::ROUTER_DUMP:
+		case Channel::Request::MethodId::ROUTER_GET_STATS:
 		case Channel::Request::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT:
 		case Channel::Request::MethodId::ROUTER_CREATE_PLAIN_RTP_TRANSPORT:
 		case Channel::Request::MethodId::ROUTER_CREATE_PRODUCER:
 		case Channel::Request::MethodId::ROUTER_CREATE_CONSUMER:
+		case Channel::Request::MethodId::ROUTER_CREATE_CONSUMERS:
 		case Channel::Request::MethodId::ROUTER_SET_AUDIO_LEVELS_EVENT:
+		case Channel::Request::MethodId::ROUTER_SET_ACTIVE_SPEAKER_EVENT:
+		case Channel::Request::MethodId::ROUTER_SET_AUDIO_TOP_K:
 		case Channel::Request::MethodId::TRANSPORT_CLOSE:
 		case Channel::Request::MethodId::TRANSPORT_DUMP:
 		case Channel::Request::MethodId::TRANSPORT_GET_STATS:
@@ -252,6 +362,7 @@ void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::R
 		case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
 		case Channel::Request::MethodId::TRANSPORT_START_MIRRORING:
 		case Channel::Request::MethodId::TRANSPORT_STOP_MIRRORING:
+		case Channel::Request::MethodId::TRANSPORT_SET_LAST_N:
 		case Channel::Request::MethodId::PRODUCER_CLOSE:
 		case Channel::Request::MethodId::PRODUCER_DUMP:
 		case Channel::Request::MethodId::PRODUCER_GET_STATS:
@@ -267,6 +378,7 @@ void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::R
 		case Channel::Request::MethodId::CONSUMER_SET_PREFERRED_PROFILE:
 		case Channel::Request::MethodId::CONSUMER_SET_ENCODING_PREFERENCES:
 		case Channel::Request::MethodId::CONSUMER_REQUEST_KEY_FRAME:
+		case Channel::Request::MethodId::CONSUMER_SUPPRESS_COMFORT_NOISE:
 		{
 			RTC::Router* router;
 
@@ -323,3 +435,26 @@ void Worker::OnRouterClosed(RTC::Router* router)
 
 	this->routers.erase(router->routerId);
 }
+
+void Worker::OnSharedMetricsCollect(
+  SharedMetrics* /*sharedMetrics*/, RTC::StatsSnapshot& snapshot, uint64_t now)
+{
+	MS_TRACE();
+
+	for (auto& kv : this->routers)
+	{
+		auto* router = kv.second;
+
+		router->FillStats(snapshot, now);
+	}
+}
+
+inline void Worker::OnTimer(Timer* /*timer*/)
+{
+	MS_TRACE();
+
+	Json::Value eventData = LoopMetrics::TakeWindow();
+
+	// The Worker itself is target 0.
+	this->notifier->Emit(0, "loopmetrics", eventData);
+}
@@ -4,6 +4,7 @@
 #include "handles/TcpConnection.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
 #include <cstdlib> // std::malloc(), std::free()
@@ -18,6 +19,8 @@ inline static void onAlloc(uv_handle_t* handle, size_t suggestedSize, uv_buf_t*
 
 inline static void onRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf)
 {
+	LoopMetrics::Scope scope(LoopMetrics::Category::TCP);
+
 	static_cast<TcpConnection*>(handle->data)->OnUvRead(nread, buf);
 }
 
@@ -4,12 +4,15 @@
 #include "handles/Timer.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 
 /* Static methods for UV callbacks. */
 
 inline static void onTimer(uv_timer_t* handle)
 {
+	LoopMetrics::Scope scope(LoopMetrics::Category::TIMER);
+
 	static_cast<Timer*>(handle->data)->OnUvTimer();
 }
 
@@ -4,6 +4,7 @@
 #include "handles/UdpSocket.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
 
@@ -22,6 +23,8 @@ inline static void onAlloc(uv_handle_t* handle, size_t suggestedSize, uv_buf_t*
 inline static void onRecv(
   uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags)
 {
+	LoopMetrics::Scope scope(LoopMetrics::Category::UDP);
+
 	static_cast<UdpSocket*>(handle->data)->OnUvRecv(nread, buf, addr, flags);
 }
 
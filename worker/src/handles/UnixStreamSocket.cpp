@@ -9,6 +9,7 @@
 #include "handles/UnixStreamSocket.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 #include <cstdlib> // std::malloc(), std::free()
 #include <cstring> // std::memcpy()
@@ -22,6 +23,8 @@ inline static void onAlloc(uv_handle_t* handle, size_t suggestedSize, uv_buf_t*
 
 inline static void onRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf)
 {
+	LoopMetrics::Scope scope(LoopMetrics::Category::CHANNEL);
+
 	static_cast<UnixStreamSocket*>(handle->data)->OnUvRead(nread, buf);
 }
 
@@ -6,6 +6,7 @@
 #include "DepLibUV.hpp"
 #include "DepOpenSSL.hpp"
 #include "Logger.hpp"
+#include "LoopMetrics.hpp"
 #include "MediaSoupError.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
@@ -46,8 +47,18 @@ int main(int argc, char* argv[])
 	// Initialize libuv stuff (we need it for the Channel).
 	DepLibUV::ClassInit();
 
+	// The Channel uses JSON messages unless the binary format is requested.
+	auto channelFormat = Channel::UnixStreamSocket::Format::JSON;
+
+	if (
+	  std::getenv("MEDIASOUP_CHANNEL_FORMAT") != nullptr &&
+	  std::string(std::getenv("MEDIASOUP_CHANNEL_FORMAT")) == "binary")
+	{
+		channelFormat = Channel::UnixStreamSocket::Format::BINARY;
+	}
+
 	// Set the Channel socket (this will be handled and deleted by the Worker).
-	auto* channel = new Channel::UnixStreamSocket(channelFd);
+	auto* channel = new Channel::UnixStreamSocket(channelFd, channelFormat);
 
 	// Initialize the Logger.
 	Logger::Init(id, channel);
@@ -118,6 +129,7 @@ void init()
 	RTC::TcpServer::ClassInit();
 	RTC::DtlsTransport::ClassInit();
 	RTC::SrtpSession::ClassInit();
+	LoopMetrics::ClassInit();
 }
 
 void ignoreSignals()
@@ -0,0 +1,65 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Channel/BinaryCodec.hpp"
+#include <json/json.h>
+
+using namespace Channel;
+
+SCENARIO("Channel binary codec", "[channel][binary]")
+{
+	SECTION("encodes and decodes a Channel request")
+	{
+		uint8_t buffer[256];
+		Json::Value json(Json::objectValue);
+
+		json["id"]                   = Json::UInt{ 3000000000u };
+		json["method"]               = "consumer.setPreferredProfile";
+		json["internal"]["routerId"] = 1;
+		json["data"]["profile"]      = "high";
+		json["data"]["ratio"]        = 0.5;
+		json["data"]["offset"]       = -20;
+		json["data"]["enabled"]      = true;
+		json["data"]["none"]         = Json::nullValue;
+		json["data"]["list"].append(1);
+		json["data"]["list"].append("a");
+
+		size_t len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+
+		REQUIRE(len > 0);
+
+		Json::Value decoded;
+
+		REQUIRE(BinaryCodec::Decode(buffer, len, decoded));
+		REQUIRE(decoded == json);
+		REQUIRE(decoded["id"].asUInt() == 3000000000u);
+		REQUIRE(decoded["data"]["offset"].asInt() == -20);
+	}
+
+	SECTION("fails to encode into a small buffer")
+	{
+		uint8_t buffer[16];
+		Json::Value json(Json::objectValue);
+
+		json["method"] = "worker.dump";
+
+		REQUIRE(BinaryCodec::Encode(json, buffer, sizeof(buffer)) == 0);
+	}
+
+	SECTION("rejects truncated or invalid data")
+	{
+		uint8_t buffer[64];
+		Json::Value json(Json::objectValue);
+
+		json["method"] = "worker.dump";
+
+		size_t len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+		Json::Value decoded;
+
+		REQUIRE(len > 0);
+		REQUIRE(!BinaryCodec::Decode(buffer, len - 1, decoded));
+
+		uint8_t invalid[] = { 0x42 };
+
+		REQUIRE(!BinaryCodec::Decode(invalid, sizeof(invalid), decoded));
+	}
+}
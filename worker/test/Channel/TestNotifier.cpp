@@ -0,0 +1,100 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Channel/Notifier.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include <json/json.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Read everything written so far by the Channel.
+static std::string readChannel(int fd)
+{
+	std::string data;
+	char buffer[65536];
+	ssize_t len;
+
+	while ((len = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+	{
+		data.append(buffer, static_cast<size_t>(len));
+	}
+
+	return data;
+}
+
+SCENARIO("Channel Notifier coalesced events", "[channel][notifier]")
+{
+	int fds[2];
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	auto* channel  = new Channel::UnixStreamSocket(fds[0]);
+	auto* notifier = new Channel::Notifier(channel);
+
+	SECTION("only the latest value of an event is sent, in update order")
+	{
+		Json::Value data1(Json::objectValue);
+		Json::Value data2(Json::objectValue);
+
+		data1["value"] = "first";
+		data2["value"] = "second";
+
+		notifier->EmitCoalesced(1, "audiolevels", data1);
+		notifier->EmitCoalesced(2, "sourcepaused");
+		notifier->EmitCoalesced(1, "audiolevels", data2);
+
+		REQUIRE(notifier->GetPendingCount() == 2);
+		REQUIRE(readChannel(fds[1]).empty());
+
+		notifier->Flush();
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(notifier->GetPendingCount() == 0);
+		REQUIRE(data.find("\"events\"") != std::string::npos);
+		REQUIRE(data.find("first") == std::string::npos);
+		REQUIRE(data.find("sourcepaused") < data.find("second"));
+	}
+
+	SECTION("events over the budget wait")
+	{
+		notifier->EmitCoalesced(1, "a");
+		notifier->EmitCoalesced(2, "a");
+		notifier->EmitCoalesced(3, "a");
+
+		notifier->Flush(2);
+
+		REQUIRE(notifier->GetPendingCount() == 1);
+		REQUIRE(readChannel(fds[1]).find("\"targetId\":3") == std::string::npos);
+	}
+
+	SECTION("regular events are sent after the pending ones")
+	{
+		notifier->EmitCoalesced(1, "effectiveprofilechange");
+		notifier->Emit(1, "close");
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(notifier->GetPendingCount() == 0);
+		REQUIRE(data.find("effectiveprofilechange") < data.find("close"));
+	}
+
+	SECTION("regular events do not send the pending ones of other targets")
+	{
+		notifier->EmitCoalesced(1, "effectiveprofilechange");
+		notifier->EmitCoalesced(2, "effectiveprofilechange");
+		notifier->EmitCoalesced(11, "effectiveprofilechange");
+		notifier->Emit(1, "sourcepaused");
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(notifier->GetPendingCount() == 2);
+		REQUIRE(data.find("effectiveprofilechange") < data.find("sourcepaused"));
+		REQUIRE(data.find("\"targetId\":2") == std::string::npos);
+		REQUIRE(data.find("\"targetId\":11") == std::string::npos);
+	}
+
+	delete notifier;
+	channel->Destroy();
+	close(fds[1]);
+}
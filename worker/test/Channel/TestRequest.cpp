@@ -0,0 +1,130 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Channel/Request.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include <json/json.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Read everything written so far by the Channel.
+static std::string readChannel(int fd)
+{
+	std::string data;
+	char buffer[65536];
+	ssize_t len;
+
+	while ((len = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+	{
+		data.append(buffer, static_cast<size_t>(len));
+	}
+
+	return data;
+}
+
+SCENARIO("Channel Request responses", "[channel][request]")
+{
+	int fds[2];
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	auto* channel = new Channel::UnixStreamSocket(fds[0]);
+	Json::Value jsonRequest(Json::objectValue);
+
+	jsonRequest["id"]     = 1234;
+	jsonRequest["method"] = "worker.dump";
+
+	SECTION("a response too large is rejected")
+	{
+		Channel::Request request(channel, jsonRequest);
+		Json::Value data(Json::objectValue);
+
+		data["value"] = std::string(70000, 'x');
+
+		request.Accept(data);
+
+		std::string sent = readChannel(fds[1]);
+
+		REQUIRE(request.replied);
+		REQUIRE(sent.find("1234") != std::string::npos);
+		REQUIRE(sent.find("response too large") != std::string::npos);
+		REQUIRE(sent.find("xxxx") == std::string::npos);
+	}
+
+	SECTION("binary data is not sent if the response is rejected")
+	{
+		Channel::Request request(channel, jsonRequest);
+		Json::Value data(Json::objectValue);
+		uint8_t binaryData[] = { 'y', 'y', 'y', 'y' };
+
+		data["value"] = std::string(70000, 'x');
+
+		request.Accept(data, binaryData, sizeof(binaryData));
+
+		std::string sent = readChannel(fds[1]);
+
+		REQUIRE(sent.find("response too large") != std::string::npos);
+		REQUIRE(sent.find("yyyy") == std::string::npos);
+	}
+
+	SECTION("binary data follows an accepted response")
+	{
+		Channel::Request request(channel, jsonRequest);
+		Json::Value data(Json::objectValue);
+		uint8_t binaryData[] = { 'y', 'y', 'y', 'y' };
+
+		request.Accept(data, binaryData, sizeof(binaryData));
+
+		std::string sent = readChannel(fds[1]);
+
+		REQUIRE(sent.find("\"accepted\"") != std::string::npos);
+		REQUIRE(sent.find("\"accepted\"") < sent.find("yyyy"));
+	}
+
+	SECTION("an oversized batch response rejects the remaining requests")
+	{
+		Json::Value jsonBatch(Json::objectValue);
+
+		jsonBatch["id"]     = 1234;
+		jsonBatch["method"] = "worker.batch";
+
+		Channel::Request batch(channel, jsonBatch);
+		Json::Value jsonResponse(Json::objectValue);
+
+		jsonResponse["accepted"]      = true;
+		jsonResponse["data"]["value"] = std::string(20000, 'x');
+
+		for (size_t pending = 4; pending > 0; --pending)
+		{
+			Json::Value jsonCopy(jsonResponse);
+
+			batch.AddBatchResponse(jsonCopy, pending - 1);
+		}
+
+		REQUIRE(batch.batchFull);
+		REQUIRE(batch.batchResponses.size() == 4);
+		REQUIRE(batch.batchResponses[2]["accepted"].asBool() == true);
+		REQUIRE(batch.batchResponses[3]["reason"].asString() == "response too large");
+
+		Json::Value jsonNotRun(Json::objectValue);
+
+		batch.AddBatchResponse(jsonNotRun, 0);
+
+		REQUIRE(batch.batchResponses[4]["reason"].asString() == "batch response too large");
+
+		Json::Value data(Json::objectValue);
+
+		data["responses"].swap(batch.batchResponses);
+
+		batch.Accept(data);
+
+		std::string sent = readChannel(fds[1]);
+
+		REQUIRE(sent.find("\"accepted\"") != std::string::npos);
+		REQUIRE(sent.find("batch response too large") != std::string::npos);
+		REQUIRE(sent.size() <= Channel::UnixStreamSocket::MessageMaxSize + 8);
+	}
+
+	channel->Destroy();
+	close(fds[1]);
+}
@@ -0,0 +1,243 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/Codecs/AV1.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <cstring> // std::memcpy()
+
+using namespace RTC;
+
+static uint8_t buffer[RTC::MtuSize];
+
+// L1T2 template dependency structure: template 0 (T0, key frame), template 1
+// (T0, one reference) and template 2 (T1, one reference), 2 decode targets,
+// no chains and no render resolutions.
+// clang-format off
+static const uint8_t structure[] =
+{
+	0x80, 0x01, 0x1C, 0x00, 0x11, 0x40, 0x00
+};
+// clang-format on
+
+// Create an AV1 packet with a dependency descriptor extension (id 8) for a
+// frame contained in a single packet.
+static RtpPacket* createPacket(
+  uint16_t seq, uint8_t templateId, bool withStructure, Codecs::AV1::DecodingContext* context)
+{
+	size_t ddLen = withStructure ? 3 + sizeof(structure) : 3;
+
+	buffer[0] = 0x90;
+	buffer[1] = 0x80 | 45;
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, seq * 3000);
+	Utils::Byte::Set4Bytes(buffer, 8, 1234);
+	// One-Byte extensions header with 3 words length.
+	Utils::Byte::Set2Bytes(buffer, 12, 0xBEDE);
+	Utils::Byte::Set2Bytes(buffer, 14, 3);
+	std::memset(buffer + 16, 0, 12);
+	buffer[16] = (8 << 4) | (ddLen - 1);
+	// Dependency descriptor: S=1, E=1, template id, frame number.
+	buffer[17] = 0xC0 | templateId;
+	Utils::Byte::Set2Bytes(buffer, 18, seq);
+
+	if (withStructure)
+		std::memcpy(buffer + 20, structure, sizeof(structure));
+
+	// Aggregation header (N=1 for the key frame) and an OBU.
+	buffer[28] = withStructure ? 0x18 : 0x10;
+	buffer[29] = 0x00;
+
+	auto* packet = RtpPacket::Parse(buffer, 30);
+
+	packet->AddExtensionMapping(RtpHeaderExtensionUri::Type::DEPENDENCY_DESCRIPTOR, 8);
+
+	Codecs::AV1::ProcessRtpPacket(packet, context);
+
+	return packet;
+}
+
+static bool encodePacket(Codecs::AV1::EncodingContext& context, RtpPacket* packet)
+{
+	bool forwarded = packet->EncodePayload(&context);
+
+	packet->RestorePayload();
+
+	return forwarded;
+}
+
+SCENARIO("AV1 dependency descriptor", "[codecs][av1]")
+{
+	SECTION("parse template dependency structure")
+	{
+		Codecs::AV1::DecodingContext decodingContext;
+		uint8_t data[] = { 0x18, 0x00 };
+		uint8_t dd[3 + sizeof(structure)];
+
+		dd[0] = 0xC0;
+		Utils::Byte::Set2Bytes(dd, 1, 1);
+		std::memcpy(dd + 3, structure, sizeof(structure));
+
+		const auto* payloadDescriptor =
+		  Codecs::AV1::Parse(data, sizeof(data), dd, sizeof(dd), &decodingContext);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->startOfFrame == 1);
+		REQUIRE(payloadDescriptor->endOfFrame == 1);
+		REQUIRE(payloadDescriptor->templateId == 0);
+		REQUIRE(payloadDescriptor->frameNumber == 1);
+		REQUIRE(payloadDescriptor->hasStructure == true);
+		REQUIRE(payloadDescriptor->hasLayers == true);
+		REQUIRE(payloadDescriptor->isKeyFrame == true);
+
+		REQUIRE(decodingContext.hasStructure == true);
+		REQUIRE(decodingContext.decodeTargetCount == 2);
+		REQUIRE(decodingContext.templates.size() == 3);
+		REQUIRE(decodingContext.templates[0].temporalLayer == 0);
+		REQUIRE(decodingContext.templates[0].fdiffCount == 0);
+		REQUIRE(decodingContext.templates[1].temporalLayer == 0);
+		REQUIRE(decodingContext.templates[1].fdiffCount == 1);
+		REQUIRE(decodingContext.templates[2].temporalLayer == 1);
+		REQUIRE(decodingContext.templates[2].fdiffCount == 1);
+
+		delete payloadDescriptor;
+
+		// Mandatory fields only. Layers come from the stored structure.
+		data[0] = 0x10;
+		dd[0]   = 0xC2;
+
+		payloadDescriptor = Codecs::AV1::Parse(data, sizeof(data), dd, 3, &decodingContext);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasLayers == true);
+		REQUIRE(payloadDescriptor->temporalLayer == 1);
+		REQUIRE(payloadDescriptor->isKeyFrame == false);
+
+		delete payloadDescriptor;
+
+		// Without structure there are no layers.
+		Codecs::AV1::DecodingContext emptyDecodingContext;
+
+		payloadDescriptor = Codecs::AV1::Parse(data, sizeof(data), dd, 3, &emptyDecodingContext);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasLayers == false);
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("parse template dependency structure with chains and render resolutions")
+	{
+		Codecs::AV1::DecodingContext decodingContext;
+		uint8_t data[] = { 0x10, 0x00 };
+
+		/**
+		 * Same L1T2 templates with 2 chains, each one protecting a decode target,
+		 * and a 640x360 render resolution. The frame has custom fdiffs (one
+		 * reference) after the structure.
+		 */
+
+		// clang-format off
+		uint8_t dd[] =
+		{
+			0xC0, 0x00, 0x01,
+			0x90, 0x01, 0x1E, 0xBC, 0x51, 0x41, 0xA0, 0x02, 0x22, 0x30, 0x27, 0xF0,
+			0x16, 0x74, 0x00
+		};
+		// clang-format on
+
+		const auto* payloadDescriptor =
+		  Codecs::AV1::Parse(data, sizeof(data), dd, sizeof(dd), &decodingContext);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasStructure == true);
+		REQUIRE(payloadDescriptor->hasLayers == true);
+		REQUIRE(payloadDescriptor->temporalLayer == 0);
+
+		REQUIRE(decodingContext.hasStructure == true);
+		REQUIRE(decodingContext.decodeTargetCount == 2);
+		REQUIRE(decodingContext.templates.size() == 3);
+		REQUIRE(decodingContext.templates[1].fdiffCount == 1);
+		REQUIRE(decodingContext.templates[2].temporalLayer == 1);
+
+		// The custom fdiffs after the structure are read from the right offset, so
+		// the frame references another one and is not a key frame.
+		REQUIRE(payloadDescriptor->isKeyFrame == false);
+
+		delete payloadDescriptor;
+
+		// A structure truncated within the render resolutions is invalid.
+		payloadDescriptor = Codecs::AV1::Parse(data, sizeof(data), dd, 14, &decodingContext);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasStructure == false);
+		REQUIRE(payloadDescriptor->hasLayers == false);
+		REQUIRE(decodingContext.hasStructure == false);
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("parse packet without dependency descriptor")
+	{
+		uint8_t data[] = { 0x18, 0x00 };
+
+		const auto* payloadDescriptor =
+		  Codecs::AV1::Parse(data, sizeof(data), nullptr, 0, nullptr);
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->startOfFrame == 0);
+		REQUIRE(payloadDescriptor->endOfFrame == 0);
+		REQUIRE(payloadDescriptor->templateId == 0);
+		REQUIRE(payloadDescriptor->hasLayers == false);
+		REQUIRE(payloadDescriptor->isKeyFrame == true);
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("drop temporal layers")
+	{
+		Codecs::AV1::DecodingContext decodingContext;
+		Codecs::AV1::EncodingContext context;
+		Codecs::EncodingContext::Preferences preferences;
+
+		preferences.temporalLayer = 0;
+		context.SetPreferences(preferences);
+
+		auto* packet = createPacket(1, 0, true, &decodingContext);
+		REQUIRE(packet->IsKeyFrame());
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(2, 2, false, &decodingContext);
+		REQUIRE(!packet->IsKeyFrame());
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(3, 1, false, &decodingContext);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		// Going up happens in a base temporal layer frame.
+		preferences.temporalLayer = 1;
+		context.SetPreferences(preferences);
+
+		packet = createPacket(4, 2, false, &decodingContext);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(5, 1, false, &decodingContext);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(6, 2, false, &decodingContext);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		// Going down is immediate.
+		preferences.temporalLayer = 0;
+		context.SetPreferences(preferences);
+
+		packet = createPacket(7, 2, false, &decodingContext);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+	}
+}
@@ -0,0 +1,77 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/Codecs/Codecs.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpPacket.hpp"
+
+using namespace RTC;
+
+SCENARIO("comfort noise detection", "[codecs][comfortnoise]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x80, 0x6f, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x04,
+		0x00, 0x00, 0x00, 0x05,
+		0xfc, 0xff, 0xfe, 0x01
+	};
+	// clang-format on
+
+	RtpCodecMimeType mimeType;
+
+	mimeType.type = RtpCodecMimeType::Type::AUDIO;
+
+	SECTION("Opus DTX frames are comfort noise")
+	{
+		mimeType.subtype = RtpCodecMimeType::Subtype::OPUS;
+
+		// TOC byte only.
+		RtpPacket* packet = RtpPacket::Parse(buffer, 13);
+
+		REQUIRE(packet);
+		REQUIRE(Codecs::IsComfortNoise(packet, mimeType));
+
+		delete packet;
+
+		// TOC byte plus an extra byte.
+		packet = RtpPacket::Parse(buffer, 14);
+
+		REQUIRE(packet);
+		REQUIRE(Codecs::IsComfortNoise(packet, mimeType));
+
+		delete packet;
+
+		// Regular Opus frame.
+		packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet);
+		REQUIRE(!Codecs::IsComfortNoise(packet, mimeType));
+
+		delete packet;
+	}
+
+	SECTION("CN payloads are comfort noise")
+	{
+		mimeType.subtype = RtpCodecMimeType::Subtype::CN;
+
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet);
+		REQUIRE(Codecs::IsComfortNoise(packet, mimeType));
+
+		delete packet;
+	}
+
+	SECTION("other codecs are never comfort noise")
+	{
+		mimeType.subtype = RtpCodecMimeType::Subtype::PCMU;
+
+		RtpPacket* packet = RtpPacket::Parse(buffer, 13);
+
+		REQUIRE(packet);
+		REQUIRE(!Codecs::IsComfortNoise(packet, mimeType));
+
+		delete packet;
+	}
+}
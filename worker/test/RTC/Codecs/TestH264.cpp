@@ -0,0 +1,155 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/Codecs/H264.hpp"
+#include "RTC/RtpPacket.hpp"
+
+using namespace RTC;
+
+static uint8_t buffer[RTC::MtuSize];
+
+// Create a single NAL unit H264 packet with a short form frame-marking
+// extension (id 7) for a frame contained in a single packet.
+static RtpPacket* createPacket(uint16_t seq, uint8_t tlIndex, bool independent, bool baseLayerSync)
+{
+	buffer[0] = 0x90;
+	buffer[1] = 0x80 | 107;
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, seq * 3000);
+	Utils::Byte::Set4Bytes(buffer, 8, 1234);
+	// One-Byte extensions header with 1 word length.
+	Utils::Byte::Set2Bytes(buffer, 12, 0xBEDE);
+	Utils::Byte::Set2Bytes(buffer, 14, 1);
+	// Frame-marking: S=1, E=1, I, D=0, B, TID.
+	buffer[16] = 0x70;
+	buffer[17] = 0xC0 | (independent ? 0x20 : 0x00) | (baseLayerSync ? 0x08 : 0x00) | tlIndex;
+	buffer[18] = 0x00;
+	buffer[19] = 0x00;
+	// NAL unit (IDR or non IDR slice).
+	buffer[20] = independent ? 0x65 : 0x41;
+	buffer[21] = 0x00;
+
+	auto* packet = RtpPacket::Parse(buffer, 22);
+
+	packet->AddExtensionMapping(RtpHeaderExtensionUri::Type::FRAME_MARKING, 7);
+
+	Codecs::H264::ProcessRtpPacket(packet);
+
+	return packet;
+}
+
+static bool encodePacket(Codecs::H264::EncodingContext& context, RtpPacket* packet)
+{
+	bool forwarded = packet->EncodePayload(&context);
+
+	packet->RestorePayload();
+
+	return forwarded;
+}
+
+SCENARIO("H264 frame-marking", "[codecs][h264]")
+{
+	SECTION("parse frame-marking")
+	{
+		// clang-format off
+		uint8_t data[] =
+		{
+			0x41, 0x00
+		};
+		uint8_t frameMarking[] =
+		{
+			0xAA, 0x01, 0x05
+		};
+		// clang-format on
+
+		const auto* payloadDescriptor =
+		  Codecs::H264::Parse(data, sizeof(data), frameMarking, sizeof(frameMarking));
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasTlIndex == true);
+		REQUIRE(payloadDescriptor->start == 1);
+		REQUIRE(payloadDescriptor->end == 0);
+		REQUIRE(payloadDescriptor->independent == 1);
+		REQUIRE(payloadDescriptor->discardable == 0);
+		REQUIRE(payloadDescriptor->baseLayerSync == 1);
+		REQUIRE(payloadDescriptor->tlIndex == 2);
+
+		delete payloadDescriptor;
+
+		payloadDescriptor = Codecs::H264::Parse(data, sizeof(data));
+
+		REQUIRE(payloadDescriptor);
+		REQUIRE(payloadDescriptor->hasTlIndex == false);
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("drop temporal layers")
+	{
+		Codecs::H264::EncodingContext context;
+		Codecs::EncodingContext::Preferences preferences;
+
+		// Every frame is forwarded by default.
+		auto* packet = createPacket(1, 2, false, false);
+
+		REQUIRE(encodePacket(context, packet));
+
+		delete packet;
+
+		preferences.temporalLayer = 0;
+		context.SetPreferences(preferences);
+
+		// L1T3 pattern: 0, 2, 1, 2.
+		packet = createPacket(2, 0, false, false);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(3, 2, false, false);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(4, 1, false, false);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		// Going up requires a base layer sync frame.
+		preferences.temporalLayer = 2;
+		context.SetPreferences(preferences);
+
+		packet = createPacket(5, 2, false, true);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(6, 1, false, true);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(7, 2, false, false);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(8, 2, false, true);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		// Going down is immediate.
+		preferences.temporalLayer = 1;
+		context.SetPreferences(preferences);
+
+		packet = createPacket(9, 2, false, false);
+		REQUIRE(!encodePacket(context, packet));
+		delete packet;
+
+		// An independent frame allows switching to any layer.
+		preferences.temporalLayer = 2;
+		context.SetPreferences(preferences);
+
+		packet = createPacket(10, 0, true, false);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+
+		packet = createPacket(11, 2, false, false);
+		REQUIRE(encodePacket(context, packet));
+		delete packet;
+	}
+}
@@ -1,10 +1,57 @@
 #include "common.hpp"
 #include "catch.hpp"
+#include "Utils.hpp"
 #include "RTC/Codecs/VP8.hpp"
+#include "RTC/RtpPacket.hpp"
 #include <cstring> // std::memcmp()
 
 using namespace RTC;
 
+static uint8_t packetBuffer[RTC::MtuSize];
+
+// Create a VP8 packet with pictureId, TL0PICIDX and TID for a frame contained
+// in a single packet.
+static RtpPacket* createPacket(uint16_t pictureId, uint8_t tlIndex, bool layerSync, bool keyFrame)
+{
+	static uint8_t tl0PictureIndex{ 0 };
+
+	if (tlIndex == 0)
+		tl0PictureIndex++;
+
+	packetBuffer[0] = 0x80;
+	packetBuffer[1] = 0x80 | 96;
+	Utils::Byte::Set2Bytes(packetBuffer, 2, pictureId);
+	Utils::Byte::Set4Bytes(packetBuffer, 4, pictureId * 3000);
+	Utils::Byte::Set4Bytes(packetBuffer, 8, 1234);
+	// X=1, S=1, I=1, L=1, T=1, two bytes pictureId.
+	packetBuffer[12] = 0x90;
+	packetBuffer[13] = 0xE0;
+	packetBuffer[14] = 0x80 | ((pictureId >> 8) & 0x7F);
+	packetBuffer[15] = pictureId & 0xFF;
+	packetBuffer[16] = tl0PictureIndex;
+	packetBuffer[17] = (tlIndex << 6) | (layerSync ? 0x20 : 0x00);
+	// VP8 payload header (P bit unset means key frame).
+	packetBuffer[18] = keyFrame ? 0x00 : 0x01;
+	packetBuffer[19] = 0x00;
+
+	auto* packet = RtpPacket::Parse(packetBuffer, 20);
+
+	Codecs::VP8::ProcessRtpPacket(packet);
+
+	return packet;
+}
+
+static bool encodePacket(Codecs::VP8::EncodingContext& context, RtpPacket* packet)
+{
+	bool forwarded = packet->EncodePayload(&context);
+
+	packet->RestorePayload();
+
+	delete packet;
+
+	return forwarded;
+}
+
 SCENARIO("parse VP8 payload descriptor", "[codecs][vp8]")
 {
 	SECTION("parse payload descriptor")
@@ -210,3 +257,43 @@ SCENARIO("parse VP8 payload descriptor", "[codecs][vp8]")
 		REQUIRE_FALSE(payloadDescriptor);
 	}
 }
+
+SCENARIO("VP8 temporal layer switching", "[codecs][vp8]")
+{
+	Codecs::VP8::EncodingContext context;
+
+	context.SyncRequired();
+
+	// L1T3 pattern: 0, 2, 1, 2.
+	REQUIRE(encodePacket(context, createPacket(1, 0, false, true)));
+	REQUIRE(encodePacket(context, createPacket(2, 2, true, false)));
+	REQUIRE(encodePacket(context, createPacket(3, 1, true, false)));
+
+	// Going down (i.e. on congestion) is immediate.
+	context.SetTemporalLayerLimit(0);
+
+	REQUIRE(!encodePacket(context, createPacket(4, 2, false, false)));
+	REQUIRE(encodePacket(context, createPacket(5, 0, false, false)));
+	REQUIRE(!encodePacket(context, createPacket(6, 2, false, false)));
+	REQUIRE(!encodePacket(context, createPacket(7, 1, false, false)));
+
+	// Going up requires a layer sync frame, one layer at a time.
+	context.SetTemporalLayerLimit(std::numeric_limits<uint8_t>::max());
+
+	REQUIRE(!encodePacket(context, createPacket(8, 2, true, false)));
+	REQUIRE(encodePacket(context, createPacket(9, 0, false, false)));
+	REQUIRE(!encodePacket(context, createPacket(10, 2, false, false)));
+	REQUIRE(encodePacket(context, createPacket(11, 1, true, false)));
+	REQUIRE(!encodePacket(context, createPacket(12, 2, false, false)));
+	REQUIRE(encodePacket(context, createPacket(13, 2, true, false)));
+
+	// A key frame allows switching to any layer.
+	context.SetTemporalLayerLimit(0);
+
+	REQUIRE(encodePacket(context, createPacket(14, 0, false, false)));
+
+	context.SetTemporalLayerLimit(std::numeric_limits<uint8_t>::max());
+
+	REQUIRE(encodePacket(context, createPacket(15, 0, false, true)));
+	REQUIRE(encodePacket(context, createPacket(16, 2, false, false)));
+}
@@ -0,0 +1,358 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/Codecs/VP9.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <cstring> // std::memcmp()
+
+using namespace RTC;
+
+static uint8_t rtpBuffer[RTC::MtuSize];
+
+// Create a non-flexible mode VP9 packet carrying a single (full) layer frame.
+static RtpPacket* createPacket(
+  uint16_t seq,
+  uint16_t pictureId,
+  uint8_t tlIndex,
+  uint8_t slIndex,
+  bool isKeyFrame,
+  bool marker,
+  bool switchingUpPoint = false)
+{
+	rtpBuffer[0] = 0x80;
+	rtpBuffer[1] = (marker ? 0x80 : 0x00) | 98;
+	Utils::Byte::Set2Bytes(rtpBuffer, 2, seq);
+	Utils::Byte::Set4Bytes(rtpBuffer, 4, pictureId * 3000);
+	Utils::Byte::Set4Bytes(rtpBuffer, 8, 1234);
+
+	// I=1, P, L=1, F=0, B=1, E=1.
+	rtpBuffer[12] = 0xAC | (isKeyFrame ? 0x00 : 0x40);
+	rtpBuffer[13] = 0x80 | (pictureId >> 8);
+	rtpBuffer[14] = pictureId & 0xFF;
+	rtpBuffer[15] = (tlIndex << 5) | (switchingUpPoint ? 0x10 : 0x00) | (slIndex << 1);
+	rtpBuffer[16] = 0x05; // TL0PICIDX.
+	rtpBuffer[17] = 0x00;
+
+	auto* packet = RtpPacket::Parse(rtpBuffer, 18);
+
+	Codecs::VP9::ProcessRtpPacket(packet);
+
+	return packet;
+}
+
+// Encode the packet and return whether it would be sent. The resulting
+// pictureId and marker are written into the given arguments.
+static bool encodePacket(
+  Codecs::VP9::EncodingContext& context, RtpPacket* packet, uint16_t& pictureId, bool& marker)
+{
+	if (!packet->EncodePayload(&context))
+		return false;
+
+	const uint8_t* payload = packet->GetPayload();
+
+	pictureId = ((payload[1] & 0x7F) << 8) | payload[2];
+	marker    = packet->HasMarker();
+
+	packet->RestorePayload();
+
+	return true;
+}
+
+SCENARIO("parse VP9 payload descriptor", "[codecs][vp9]")
+{
+	SECTION("parse non flexible mode payload descriptor")
+	{
+		/** VP9 Payload Descriptor
+		 *
+		 * 1 = I bit: Picture ID present
+		 * 0 = P bit: Not inter-picture predicted
+		 * 1 = L bit: Layer indices present
+		 * 0 = F bit: Non-flexible mode
+		 * 1 = B bit: Start of a frame
+		 * 0 = E bit: Not the end of a frame
+		 * 0 = V bit: No scalability structure
+		 * 1 = M bit: Two bytes Picture ID
+		 * 000 0001 0000 0001 = Picture ID: 257
+		 * 010 = TID: 2
+		 * 1 = U bit: Switching up point
+		 * 000 = SID: 0
+		 * 0 = D bit: No inter-layer dependency
+		 * 0000 0111 = TL0PICIDX: 7
+		 */
+
+		// clang-format off
+		uint8_t originalBuffer[] =
+		{
+			0xa8, 0x81, 0x01, 0x50, 0x07, 0x00
+		};
+		// clang-format on
+
+		// Keep a copy of the original buffer for comparing.
+		uint8_t buffer[6] = { 0 };
+
+		std::memcpy(buffer, originalBuffer, sizeof(buffer));
+
+		const auto* payloadDescriptor = Codecs::VP9::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(payloadDescriptor);
+
+		REQUIRE(payloadDescriptor->i == 1);
+		REQUIRE(payloadDescriptor->p == 0);
+		REQUIRE(payloadDescriptor->l == 1);
+		REQUIRE(payloadDescriptor->f == 0);
+		REQUIRE(payloadDescriptor->b == 1);
+		REQUIRE(payloadDescriptor->e == 0);
+		REQUIRE(payloadDescriptor->v == 0);
+
+		REQUIRE(payloadDescriptor->pictureId == 257);
+		REQUIRE(payloadDescriptor->tlIndex == 2);
+		REQUIRE(payloadDescriptor->switchingUpPoint == 1);
+		REQUIRE(payloadDescriptor->slIndex == 0);
+		REQUIRE(payloadDescriptor->interLayerDependency == 0);
+		REQUIRE(payloadDescriptor->tl0PictureIndex == 7);
+
+		REQUIRE(payloadDescriptor->isKeyFrame == true);
+		REQUIRE(payloadDescriptor->hasPictureId == true);
+		REQUIRE(payloadDescriptor->hasOneBytePictureId == false);
+		REQUIRE(payloadDescriptor->hasTwoBytesPictureId == true);
+		REQUIRE(payloadDescriptor->hasTl0PictureIndex == true);
+		REQUIRE(payloadDescriptor->hasSlIndex == true);
+		REQUIRE(payloadDescriptor->hasTlIndex == true);
+
+		SECTION("encode payload descriptor")
+		{
+			payloadDescriptor->Encode(buffer, 1000, 8);
+
+			REQUIRE(buffer[1] == (0x80 | (1000 >> 8)));
+			REQUIRE(buffer[2] == (1000 & 0xFF));
+			REQUIRE(buffer[4] == 8);
+
+			payloadDescriptor->Restore(buffer);
+
+			REQUIRE(std::memcmp(buffer, originalBuffer, sizeof(buffer)) == 0);
+		}
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("parse flexible mode payload descriptor")
+	{
+		/** VP9 Payload Descriptor
+		 *
+		 * 1 = I bit: Picture ID present
+		 * 1 = P bit: Inter-picture predicted
+		 * 1 = L bit: Layer indices present
+		 * 1 = F bit: Flexible mode
+		 * 0 = B bit: Not the start of a frame
+		 * 1 = E bit: End of a frame
+		 * 0 = V bit: No scalability structure
+		 * 0 = M bit: One byte Picture ID
+		 * 001 0001 = Picture ID: 17
+		 * 001 = TID: 1
+		 * 0 = U bit: Not a switching up point
+		 * 001 = SID: 1
+		 * 1 = D bit: Inter-layer dependency
+		 * 0000 001 1 = P_DIFF: 1, N: 1
+		 * 0000 010 0 = P_DIFF: 2, N: 0
+		 */
+
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0xf4, 0x11, 0x23, 0x03, 0x04, 0x00
+		};
+		// clang-format on
+
+		const auto* payloadDescriptor = Codecs::VP9::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(payloadDescriptor);
+
+		REQUIRE(payloadDescriptor->p == 1);
+		REQUIRE(payloadDescriptor->f == 1);
+		REQUIRE(payloadDescriptor->e == 1);
+		REQUIRE(payloadDescriptor->pictureId == 17);
+		REQUIRE(payloadDescriptor->tlIndex == 1);
+		REQUIRE(payloadDescriptor->slIndex == 1);
+		REQUIRE(payloadDescriptor->interLayerDependency == 1);
+
+		REQUIRE(payloadDescriptor->isKeyFrame == false);
+		REQUIRE(payloadDescriptor->hasOneBytePictureId == true);
+		REQUIRE(payloadDescriptor->hasTl0PictureIndex == false);
+
+		delete payloadDescriptor;
+	}
+
+	SECTION("parse payload descriptor. missing P_DIFF")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0xf4, 0x11, 0x23, 0x03
+		};
+		// clang-format on
+
+		auto payloadDescriptor = Codecs::VP9::Parse(buffer, sizeof(buffer));
+
+		REQUIRE_FALSE(payloadDescriptor);
+	}
+}
+
+SCENARIO("drop VP9 spatial and temporal layers", "[codecs][vp9]")
+{
+	Codecs::VP9::EncodingContext context;
+	Codecs::EncodingContext::Preferences preferences;
+	uint16_t pictureId;
+	bool marker;
+
+	preferences.spatialLayer  = 0;
+	preferences.temporalLayer = 1;
+
+	context.SetPreferences(preferences);
+	context.SyncRequired();
+
+	struct Input
+	{
+		uint16_t pictureId;
+		uint8_t tlIndex;
+		uint8_t slIndex;
+		bool isKeyFrame;
+		bool marker;
+		bool forwarded;
+		uint16_t outPictureId;
+		bool outMarker;
+	};
+
+	// Output pictureIds start from 1 after sync.
+	// clang-format off
+	Input inputs[] =
+	{
+		// Key frame, the highest forwarded spatial layer gets the marker bit.
+		{ 100, 0, 0, true,  false, true,  1,   true  },
+		{ 100, 0, 1, false, true,  false, 0,   false },
+		// Temporal layer 2 is dropped.
+		{ 101, 2, 0, false, false, false, 0,   false },
+		{ 101, 2, 1, false, true,  false, 0,   false },
+		// pictureId has no gaps.
+		{ 102, 1, 0, false, false, true,  2,   true  },
+		{ 102, 1, 1, false, true,  false, 0,   false },
+	};
+	// clang-format on
+
+	uint16_t seq = 1;
+
+	for (auto& input : inputs)
+	{
+		auto* packet = createPacket(
+		  seq++, input.pictureId, input.tlIndex, input.slIndex, input.isKeyFrame, input.marker);
+
+		REQUIRE(encodePacket(context, packet, pictureId, marker) == input.forwarded);
+
+		if (input.forwarded)
+		{
+			REQUIRE(pictureId == input.outPictureId);
+			REQUIRE(marker == input.outMarker);
+		}
+
+		// The original payload and marker are restored.
+		REQUIRE(packet->HasMarker() == input.marker);
+
+		delete packet;
+	}
+
+	// Higher spatial layers are not forwarded until a key frame arrives.
+	preferences.spatialLayer = 1;
+	context.SetPreferences(preferences);
+
+	auto* packet = createPacket(seq++, 103, 0, 0, false, false);
+
+	REQUIRE(encodePacket(context, packet, pictureId, marker));
+	REQUIRE(pictureId == 3);
+	REQUIRE(marker == true);
+
+	delete packet;
+
+	packet = createPacket(seq++, 103, 0, 1, false, true);
+
+	REQUIRE(!encodePacket(context, packet, pictureId, marker));
+
+	delete packet;
+
+	packet = createPacket(seq++, 104, 0, 0, true, false);
+
+	REQUIRE(encodePacket(context, packet, pictureId, marker));
+	REQUIRE(pictureId == 4);
+	REQUIRE(marker == false);
+
+	delete packet;
+
+	packet = createPacket(seq++, 104, 0, 1, false, true);
+
+	REQUIRE(encodePacket(context, packet, pictureId, marker));
+	REQUIRE(pictureId == 4);
+	REQUIRE(marker == true);
+
+	delete packet;
+}
+
+SCENARIO("VP9 temporal layer switching", "[codecs][vp9]")
+{
+	Codecs::VP9::EncodingContext context;
+	Codecs::EncodingContext::Preferences preferences;
+	uint16_t pictureId;
+	bool marker;
+
+	preferences.spatialLayer  = 0;
+	preferences.temporalLayer = 2;
+
+	context.SetPreferences(preferences);
+	context.SyncRequired();
+
+	// Forward the given picture (seq and pictureId) and return whether it was sent.
+	auto forward = [&](uint16_t seq, uint8_t tlIndex, bool isKeyFrame, bool switchingUpPoint) {
+		auto* packet = createPacket(seq, seq, tlIndex, 0, isKeyFrame, true, switchingUpPoint);
+		bool sent = encodePacket(context, packet, pictureId, marker);
+
+		delete packet;
+
+		return sent;
+	};
+
+	// L1T3 pattern: 0, 2, 1, 2.
+	REQUIRE(forward(1, 0, true, false));
+	REQUIRE(forward(2, 2, false, true));
+	REQUIRE(forward(3, 1, false, true));
+
+	// Going down is immediate.
+	preferences.temporalLayer = 0;
+	context.SetPreferences(preferences);
+
+	REQUIRE(!forward(4, 2, false, true));
+	REQUIRE(forward(5, 0, false, false));
+	REQUIRE(!forward(6, 2, false, true));
+	REQUIRE(!forward(7, 1, false, true));
+
+	// Going up requires a switching up point.
+	preferences.temporalLayer = 2;
+	context.SetPreferences(preferences);
+
+	REQUIRE(forward(8, 0, false, false));
+	REQUIRE(!forward(9, 2, false, false));
+	REQUIRE(!forward(10, 1, false, false));
+	REQUIRE(forward(11, 1, false, true));
+	REQUIRE(!forward(12, 2, false, false));
+	REQUIRE(forward(13, 2, false, true));
+	REQUIRE(forward(14, 1, false, false));
+
+	// A key frame allows switching to the target layer at once.
+	preferences.temporalLayer = 0;
+	context.SetPreferences(preferences);
+
+	REQUIRE(forward(15, 0, false, false));
+
+	preferences.temporalLayer = 2;
+	context.SetPreferences(preferences);
+
+	REQUIRE(forward(16, 0, true, false));
+	REQUIRE(forward(17, 2, false, false));
+	REQUIRE(pictureId == 11);
+}
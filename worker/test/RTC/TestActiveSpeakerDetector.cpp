@@ -0,0 +1,109 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/ActiveSpeakerDetector.hpp"
+#include <vector>
+
+using namespace RTC;
+
+class TestActiveSpeakerDetectorListener : public ActiveSpeakerDetector::Listener
+{
+public:
+	void OnActiveSpeakerChanged(
+	  ActiveSpeakerDetector* /*activeSpeakerDetector*/, uint32_t producerId) override
+	{
+		this->changes.push_back(producerId);
+	}
+
+	void OnActiveSpeakerLost(ActiveSpeakerDetector* /*activeSpeakerDetector*/) override
+	{
+		this->lost++;
+	}
+
+public:
+	std::vector<uint32_t> changes;
+	size_t lost{ 0 };
+};
+
+// Feed every interval of the window with the given volumes (0 is the loudest).
+static void speak(ActiveSpeakerDetector& detector, uint8_t volume1, uint8_t volume2, size_t intervals)
+{
+	for (size_t i = 0; i < intervals; ++i)
+	{
+		detector.ReceiveAudioLevel(1, volume1);
+		detector.ReceiveAudioLevel(1, volume1);
+		detector.ReceiveAudioLevel(2, volume2);
+		detector.ReceiveAudioLevel(2, volume2);
+		detector.Process();
+	}
+}
+
+SCENARIO("active speaker detection", "[activespeaker]")
+{
+	TestActiveSpeakerDetectorListener listener;
+	ActiveSpeakerDetector detector(&listener);
+
+	SECTION("silence does not produce an active speaker")
+	{
+		speak(detector, 127, 100, 10);
+
+		REQUIRE(!detector.HasActiveSpeaker());
+
+		// Background noise (-70 dBov).
+		speak(detector, 70, 75, 10);
+
+		REQUIRE(!detector.HasActiveSpeaker());
+		REQUIRE(listener.changes.empty());
+	}
+
+	SECTION("only speaker changes are notified")
+	{
+		speak(detector, 20, 60, 10);
+
+		REQUIRE(detector.HasActiveSpeaker());
+		REQUIRE(detector.GetActiveSpeaker() == 1);
+		REQUIRE(listener.changes.size() == 1);
+
+		// Slightly louder but within the hysteresis.
+		speak(detector, 20, 17, 10);
+
+		REQUIRE(detector.GetActiveSpeaker() == 1);
+		REQUIRE(listener.changes.size() == 1);
+
+		// Louder than the hysteresis.
+		speak(detector, 20, 10, 10);
+
+		REQUIRE(detector.GetActiveSpeaker() == 2);
+		REQUIRE(listener.changes.size() == 2);
+		REQUIRE(listener.changes[1] == 2);
+
+		// Nobody speaks, keep the active speaker.
+		speak(detector, 127, 127, 10);
+
+		REQUIRE(detector.GetActiveSpeaker() == 2);
+		REQUIRE(listener.changes.size() == 2);
+
+		// Any speaker replaces a silent active speaker.
+		speak(detector, 60, 127, 10);
+
+		REQUIRE(detector.GetActiveSpeaker() == 1);
+		REQUIRE(listener.changes.size() == 3);
+	}
+
+	SECTION("removing the active speaker is notified")
+	{
+		detector.SetHysteresis(0);
+
+		speak(detector, 30, 40, 10);
+
+		REQUIRE(detector.GetActiveSpeaker() == 1);
+
+		detector.RemoveProducer(2);
+
+		REQUIRE(listener.lost == 0);
+
+		detector.RemoveProducer(1);
+
+		REQUIRE(!detector.HasActiveSpeaker());
+		REQUIRE(listener.lost == 1);
+	}
+}
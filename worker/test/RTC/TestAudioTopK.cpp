@@ -0,0 +1,96 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/AudioTopK.hpp"
+
+using namespace RTC;
+
+SCENARIO("audio top-K selection", "[audiotopk]")
+{
+	AudioTopK topK;
+	bool added;
+
+	topK.SetK(2);
+
+	SECTION("the K first Producers are forwarded")
+	{
+		REQUIRE(topK.Update(1, 50, 0, added));
+		REQUIRE(added);
+		REQUIRE(topK.Update(2, 10, 0, added));
+		REQUIRE(added);
+		REQUIRE(!topK.Update(3, 10, 0, added));
+		REQUIRE(!added);
+		REQUIRE(topK.Update(1, 50, 20, added));
+		REQUIRE(!added);
+		REQUIRE(topK.IsForwarded(1));
+		REQUIRE(topK.IsForwarded(2));
+		REQUIRE(!topK.IsForwarded(3));
+	}
+
+	SECTION("a clearly louder Producer replaces the quietest one")
+	{
+		topK.Update(1, 50, 0, added);
+		topK.Update(2, 10, 0, added);
+
+		// Just louder than the quietest one does not pass the hysteresis.
+		REQUIRE(!topK.Update(3, 12, 0, added));
+
+		uint64_t now{ 0 };
+
+		while (!topK.Update(3, 60, now, added))
+		{
+			topK.Update(1, 50, now, added);
+			topK.Update(2, 10, now, added);
+			now += 20;
+		}
+
+		REQUIRE(added);
+		REQUIRE(topK.IsForwarded(1));
+		REQUIRE(!topK.IsForwarded(2));
+		REQUIRE(topK.IsForwarded(3));
+	}
+
+	SECTION("a Producer that stopped sending loses its slot")
+	{
+		topK.Update(1, 100, 0, added);
+		topK.Update(2, 100, 0, added);
+
+		uint64_t now{ 0 };
+
+		// Producer 2 stops sending, a quiet Producer 3 keeps sending.
+		for (; now < uint64_t{ AudioTopK::InactivityTimeout }; now += 20)
+		{
+			topK.Update(1, 100, now, added);
+			REQUIRE(!topK.Update(3, 1, now, added));
+		}
+
+		topK.Update(1, 100, now, added);
+
+		REQUIRE(topK.Update(3, 1, now, added));
+		REQUIRE(added);
+		REQUIRE(topK.IsForwarded(1));
+		REQUIRE(!topK.IsForwarded(2));
+		REQUIRE(topK.IsForwarded(3));
+	}
+
+	SECTION("removing a forwarded Producer frees its slot")
+	{
+		topK.Update(1, 50, 0, added);
+		topK.Update(2, 50, 0, added);
+		topK.Remove(1);
+
+		REQUIRE(!topK.IsForwarded(1));
+		REQUIRE(topK.Update(3, 1, 0, added));
+		REQUIRE(added);
+	}
+
+	SECTION("SetK() starts the selection again")
+	{
+		topK.Update(1, 50, 0, added);
+		topK.SetK(1);
+
+		REQUIRE(topK.GetK() == 1);
+		REQUIRE(!topK.IsForwarded(1));
+		REQUIRE(topK.Update(2, 1, 0, added));
+		REQUIRE(!topK.Update(1, 1, 0, added));
+	}
+}
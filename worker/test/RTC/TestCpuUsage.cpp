@@ -0,0 +1,86 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/CpuUsage.hpp"
+
+using namespace RTC;
+
+// Accounts its packets like a Transport and closes itself on demand while
+// handling one, as a Transport does when DTLS is closed.
+class TestCpuUsageOwner
+{
+public:
+	void OnPacketRecv(bool close)
+	{
+		CpuUsage::Scope cpuUsageScope(&this->cpuUsage);
+
+		if (close)
+			delete this;
+	}
+
+public:
+	CpuUsage cpuUsage;
+};
+
+SCENARIO("CPU usage", "[cpu]")
+{
+	SECTION("rate is the usage of the latest complete window")
+	{
+		CpuUsage cpuUsage;
+
+		// 2ms and 3ms (in nanoseconds) during the first window.
+		cpuUsage.Add(2000000, 10000);
+		cpuUsage.Add(3000000, 10500);
+
+		REQUIRE(cpuUsage.GetTime() == 5000);
+		REQUIRE(cpuUsage.GetRate(10900) == 0);
+		REQUIRE(cpuUsage.GetRate(11000) == 5000);
+
+		cpuUsage.Add(1000000, 11200);
+
+		REQUIRE(cpuUsage.GetRate(11500) == 5000);
+		REQUIRE(cpuUsage.GetRate(12000) == 1000);
+		// Nothing during the latest complete window.
+		REQUIRE(cpuUsage.GetRate(13000) == 0);
+		REQUIRE(cpuUsage.GetTime() == 6000);
+	}
+
+	SECTION("nested scopes are not accounted to the outer one")
+	{
+		CpuUsage outer;
+		CpuUsage inner;
+
+		{
+			CpuUsage::Scope outerScope(&outer);
+			CpuUsage::Scope innerScope(&inner);
+			uint64_t start = uv_hrtime();
+
+			// Busy wait for 2ms.
+			while (uv_hrtime() - start < 2000000)
+			{
+			}
+		}
+
+		REQUIRE(inner.GetTime() >= 2000);
+		REQUIRE(outer.GetTime() < inner.GetTime());
+	}
+
+	SECTION("owner closed from inside its scope")
+	{
+		CpuUsage outer;
+		auto* owner = new TestCpuUsageOwner();
+
+		{
+			CpuUsage::Scope outerScope(&outer);
+
+			owner->OnPacketRecv(false);
+			owner->OnPacketRecv(true);
+
+			// A new scope after the closed one still works.
+			TestCpuUsageOwner other;
+
+			other.OnPacketRecv(false);
+		}
+
+		REQUIRE(outer.GetTime() < 1000);
+	}
+}
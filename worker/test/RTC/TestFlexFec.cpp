@@ -0,0 +1,198 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/FlexFec.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <cstring> // std::memcmp()
+#include <vector>
+
+using namespace RTC;
+
+static constexpr uint32_t MediaSsrc{ 1111 };
+static constexpr uint32_t FecSsrc{ 2222 };
+static constexpr uint8_t FecPayloadType{ 110 };
+
+static uint8_t buffers[FlexFec::MaxGroupSize][RTC::MtuSize];
+static uint8_t fecBuffer[RTC::MtuSize];
+static uint8_t recoveredBuffer[RTC::MtuSize];
+
+// Create media packets with different sizes, markers and CSRC lists.
+static std::vector<RtpPacket*> createPackets(size_t numPackets, uint16_t seq)
+{
+	std::vector<RtpPacket*> packets;
+
+	for (size_t i = 0; i < numPackets; ++i)
+	{
+		uint8_t* buffer    = buffers[i];
+		size_t csrcCount   = i % 2;
+		size_t payloadSize = 100 + (i * 37) % 900;
+		size_t size        = 12 + csrcCount * 4 + payloadSize;
+
+		buffer[0] = 0x80 | static_cast<uint8_t>(csrcCount);
+		buffer[1] = (i == numPackets - 1 ? 0x80 : 0x00) | 96;
+		Utils::Byte::Set2Bytes(buffer, 2, seq + i);
+		Utils::Byte::Set4Bytes(buffer, 4, 90000 + (i / 3) * 3000);
+		Utils::Byte::Set4Bytes(buffer, 8, MediaSsrc);
+
+		for (size_t j = 12; j < size; ++j)
+		{
+			buffer[j] = static_cast<uint8_t>(j * 7 + i);
+		}
+
+		auto* packet = RtpPacket::Parse(buffer, size);
+
+		REQUIRE(packet);
+
+		packets.push_back(packet);
+	}
+
+	return packets;
+}
+
+static void deletePackets(std::vector<RtpPacket*>& packets)
+{
+	for (auto* packet : packets)
+	{
+		delete packet;
+	}
+
+	packets.clear();
+}
+
+SCENARIO("FlexFEC", "[rtp][fec]")
+{
+	SECTION("XOR")
+	{
+		uint8_t a[37];
+		uint8_t b[37];
+
+		for (size_t i = 0; i < sizeof(a); ++i)
+		{
+			a[i] = static_cast<uint8_t>(i);
+			b[i] = static_cast<uint8_t>(i * 3 + 1);
+		}
+
+		FlexFec::Xor(a, b, sizeof(a));
+
+		for (size_t i = 0; i < sizeof(a); ++i)
+		{
+			REQUIRE(a[i] == static_cast<uint8_t>(i ^ (i * 3 + 1)));
+		}
+	}
+
+	SECTION("disabled encoder generates no FEC")
+	{
+		FlexFecEncoder encoder(FecPayloadType, FecSsrc);
+		auto packets = createPackets(4, 1000);
+
+		for (auto* packet : packets)
+		{
+			REQUIRE(encoder.AddPacket(packet) == nullptr);
+		}
+
+		deletePackets(packets);
+	}
+
+	SECTION("protection level depends on fraction lost")
+	{
+		FlexFecEncoder encoder(FecPayloadType, FecSsrc);
+
+		encoder.SetFractionLost(0);
+		REQUIRE(encoder.GetGroupSize() == 0);
+
+		encoder.SetFractionLost(10);
+		REQUIRE(encoder.GetGroupSize() == 10);
+
+		encoder.SetFractionLost(128);
+		REQUIRE(encoder.GetGroupSize() == 2);
+
+		encoder.SetGroupSize(50);
+		REQUIRE(encoder.GetGroupSize() == 15);
+	}
+
+	SECTION("any single lost packet is recovered")
+	{
+		for (uint8_t groupSize : { 2, 5, 15 })
+		{
+			FlexFecEncoder encoder(FecPayloadType, FecSsrc);
+			auto packets = createPackets(groupSize, 65530);
+			RtpPacket* fecPacket{ nullptr };
+
+			encoder.SetGroupSize(groupSize);
+
+			for (auto* packet : packets)
+			{
+				REQUIRE(fecPacket == nullptr);
+
+				fecPacket = encoder.AddPacket(packet);
+			}
+
+			REQUIRE(fecPacket);
+			REQUIRE(fecPacket->GetSsrc() == FecSsrc);
+			REQUIRE(fecPacket->GetPayloadType() == FecPayloadType);
+			REQUIRE(fecPacket->GetTimestamp() == packets.back()->GetTimestamp());
+
+			// Keep the FEC packet, the encoder reuses its buffer.
+			auto* fec = fecPacket->Clone(fecBuffer);
+
+			delete fecPacket;
+
+			for (size_t lost = 0; lost < packets.size(); ++lost)
+			{
+				std::vector<RtpPacket*> received(packets);
+
+				received.erase(received.begin() + lost);
+
+				auto* recovered = FlexFec::RecoverPacket(fec, received, recoveredBuffer);
+
+				REQUIRE(recovered);
+				REQUIRE(recovered->GetSize() == packets[lost]->GetSize());
+				REQUIRE(
+				  std::memcmp(recovered->GetData(), packets[lost]->GetData(), recovered->GetSize()) == 0);
+
+				delete recovered;
+			}
+
+			delete fec;
+			deletePackets(packets);
+		}
+	}
+
+	SECTION("two lost packets cannot be recovered")
+	{
+		FlexFecEncoder encoder(FecPayloadType, FecSsrc);
+		auto packets = createPackets(4, 2000);
+		RtpPacket* fecPacket{ nullptr };
+
+		encoder.SetGroupSize(4);
+
+		for (auto* packet : packets)
+		{
+			fecPacket = encoder.AddPacket(packet);
+		}
+
+		REQUIRE(fecPacket);
+
+		std::vector<RtpPacket*> received{ packets[0], packets[3] };
+
+		REQUIRE(FlexFec::RecoverPacket(fecPacket, received, recoveredBuffer) == nullptr);
+
+		delete fecPacket;
+		deletePackets(packets);
+	}
+
+	SECTION("non consecutive packets start a new group")
+	{
+		FlexFecEncoder encoder(FecPayloadType, FecSsrc);
+		auto packets = createPackets(5, 3000);
+
+		encoder.SetGroupSize(3);
+
+		REQUIRE(encoder.AddPacket(packets[0]) == nullptr);
+		REQUIRE(encoder.AddPacket(packets[1]) == nullptr);
+		// Packet 2 is missing.
+		REQUIRE(encoder.AddPacket(packets[3]) == nullptr);
+		REQUIRE(encoder.AddPacket(packets[4]) == nullptr);
+
+		deletePackets(packets);
+	}
+}
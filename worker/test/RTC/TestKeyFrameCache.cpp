@@ -0,0 +1,160 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/Codecs/Codecs.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/RtpPacket.hpp"
+
+using namespace RTC;
+
+static uint8_t buffer[RTC::MtuSize];
+
+// Create a VP8 packet (with a two bytes pictureId) already processed at codec
+// level as the Producer does.
+static RtpPacket* createPacket(
+  const RtpCodecMimeType& mimeType, uint16_t seq, uint32_t timestamp, bool isKeyFrame, bool marker)
+{
+	buffer[0] = 0x80;
+	buffer[1] = (marker ? 0x80 : 0x00) | 96;
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, timestamp);
+	Utils::Byte::Set4Bytes(buffer, 8, 1234);
+
+	// VP8 payload descriptor: X=1, S=1, PID=0, I=1, pictureId=1.
+	buffer[12] = 0x90;
+	buffer[13] = 0x80;
+	buffer[14] = 0x80;
+	buffer[15] = 0x01;
+	// VP8 payload header: P=0 for key frames.
+	buffer[16] = isKeyFrame ? 0x00 : 0x01;
+
+	auto* packet = RtpPacket::Parse(buffer, 100);
+
+	Codecs::ProcessRtpPacket(packet, mimeType);
+
+	return packet;
+}
+
+static void receivePacket(
+  KeyFrameCache& cache,
+  const RtpCodecMimeType& mimeType,
+  uint16_t seq,
+  uint32_t timestamp,
+  bool isKeyFrame,
+  bool marker,
+  uint64_t now)
+{
+	auto* packet = createPacket(mimeType, seq, timestamp, isKeyFrame, marker);
+
+	cache.ReceivePacket(packet, now);
+
+	delete packet;
+}
+
+SCENARIO("key frame cache", "[rtp][keyframe]")
+{
+	RtpCodecMimeType mimeType;
+
+	mimeType.SetMimeType("video/VP8");
+
+	KeyFrameCache cache(mimeType);
+
+	SECTION("packets before the first key frame are not cached")
+	{
+		receivePacket(cache, mimeType, 1, 1000, false, true, 0);
+
+		REQUIRE(cache.GetPackets().empty());
+		REQUIRE(!cache.IsValid(0));
+	}
+
+	SECTION("key frame and following packets are cached")
+	{
+		// Sequence numbers wrap around.
+		receivePacket(cache, mimeType, 65535, 1000, true, false, 1000);
+
+		// The key frame is not complete yet.
+		REQUIRE(cache.GetPackets().size() == 1);
+		REQUIRE(!cache.IsValid(1000));
+
+		receivePacket(cache, mimeType, 0, 1000, false, true, 1000);
+		receivePacket(cache, mimeType, 1, 4000, false, true, 1030);
+		// Retransmitted packet already cached.
+		receivePacket(cache, mimeType, 0, 1000, false, true, 1040);
+
+		auto& packets = cache.GetPackets();
+
+		REQUIRE(cache.IsValid(1050));
+		REQUIRE(packets.size() == 3);
+		REQUIRE(packets[0]->packet->GetSequenceNumber() == 65535);
+		REQUIRE(packets[0]->packet->IsKeyFrame());
+		REQUIRE(packets[1]->packet->GetSequenceNumber() == 0);
+		REQUIRE(packets[2]->packet->GetSequenceNumber() == 1);
+
+		// Too old.
+		REQUIRE(!cache.IsValid(1000 + KeyFrameCache::MaxAge + 1));
+
+		// A new key frame replaces the cached packets.
+		receivePacket(cache, mimeType, 2, 7000, true, true, 1060);
+
+		REQUIRE(cache.IsValid(1060));
+		REQUIRE(cache.GetPackets().size() == 1);
+		REQUIRE(cache.GetPackets()[0]->packet->GetSequenceNumber() == 2);
+	}
+
+	SECTION("storage of packets no longer cached is reused")
+	{
+		receivePacket(cache, mimeType, 1, 1000, true, true, 0);
+
+		const auto* storage = cache.GetPackets()[0]->storage.get();
+
+		receivePacket(cache, mimeType, 2, 4000, true, true, 0);
+
+		REQUIRE(cache.GetPackets()[0]->storage.get() == storage);
+
+		// Packets being sent keep their storage.
+		auto packets = cache.GetPackets();
+
+		receivePacket(cache, mimeType, 3, 7000, true, true, 0);
+
+		REQUIRE(cache.GetPackets()[0]->storage.get() != storage);
+		REQUIRE(packets[0]->storage.get() == storage);
+		REQUIRE(packets[0]->packet->GetSequenceNumber() == 2);
+	}
+
+	SECTION("a gap invalidates the cache")
+	{
+		receivePacket(cache, mimeType, 10, 1000, true, true, 0);
+		receivePacket(cache, mimeType, 11, 4000, false, true, 0);
+
+		REQUIRE(cache.IsValid(0));
+
+		receivePacket(cache, mimeType, 13, 7000, false, true, 0);
+
+		REQUIRE(!cache.IsValid(0));
+		REQUIRE(cache.GetPackets().empty());
+
+		// Packets after the gap are not cached.
+		receivePacket(cache, mimeType, 14, 7000, false, true, 0);
+
+		REQUIRE(cache.GetPackets().empty());
+	}
+
+	SECTION("too many packets invalidate the cache")
+	{
+		uint16_t seq = 100;
+
+		receivePacket(cache, mimeType, seq++, 1000, true, true, 0);
+
+		while (cache.GetPackets().size() != 250)
+		{
+			receivePacket(cache, mimeType, seq++, 4000, false, false, 0);
+		}
+
+		REQUIRE(cache.IsValid(0));
+
+		receivePacket(cache, mimeType, seq++, 4000, false, false, 0);
+
+		REQUIRE(!cache.IsValid(0));
+		REQUIRE(cache.GetPackets().empty());
+	}
+}
@@ -0,0 +1,133 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/KeyFrameRequestManager.hpp"
+#include <vector>
+
+using namespace RTC;
+
+class TestKeyFrameRequestManagerListener : public KeyFrameRequestManager::Listener
+{
+public:
+	void OnKeyFrameRequestManagerSendPli(
+	  KeyFrameRequestManager* /*keyFrameRequestManager*/, uint32_t ssrc) override
+	{
+		this->plis.push_back(ssrc);
+	}
+
+	void OnKeyFrameRequestManagerSendFir(
+	  KeyFrameRequestManager* /*keyFrameRequestManager*/,
+	  uint32_t ssrc,
+	  uint8_t /*seqNumber*/) override
+	{
+		this->firs.push_back(ssrc);
+	}
+
+public:
+	std::vector<uint32_t> plis;
+	std::vector<uint32_t> firs;
+};
+
+SCENARIO("key frame request manager", "[rtcp][keyframe]")
+{
+	TestKeyFrameRequestManagerListener listener;
+	KeyFrameRequestManager manager(&listener);
+
+	SECTION("requests within the interval are coalesced")
+	{
+		manager.AddStream(1111, true, false);
+		manager.AddStream(2222, true, false);
+
+		manager.KeyFrameNeeded(1111);
+		manager.KeyFrameNeeded(1111);
+		manager.KeyFrameNeeded(1111);
+		manager.KeyFrameNeeded(2222);
+
+		REQUIRE(listener.plis.size() == 2);
+		REQUIRE(listener.plis[0] == 1111);
+		REQUIRE(listener.plis[1] == 2222);
+
+		// Forced requests are not coalesced.
+		manager.KeyFrameNeeded(1111, true);
+
+		REQUIRE(listener.plis.size() == 3);
+
+		auto stats = manager.GetStats(1111);
+
+		REQUIRE(stats["requestCount"].asUInt() == 4);
+		REQUIRE(stats["coalescedCount"].asUInt() == 2);
+		REQUIRE(stats["servedCount"].asUInt() == 0);
+
+		manager.KeyFrameReceived(1111);
+
+		stats = manager.GetStats(1111);
+
+		REQUIRE(stats["servedCount"].asUInt() == 1);
+	}
+
+	SECTION("FIR is used until the stream produces a key frame")
+	{
+		manager.AddStream(1111, true, true);
+
+		manager.KeyFrameNeeded(1111);
+
+		REQUIRE(listener.firs.size() == 1);
+		REQUIRE(listener.plis.empty());
+
+		manager.KeyFrameReceived(1111);
+		manager.KeyFrameNeeded(1111, true);
+
+		REQUIRE(listener.firs.size() == 1);
+		REQUIRE(listener.plis.size() == 1);
+
+		// The PLI was not answered, escalate to FIR.
+		manager.KeyFrameNeeded(1111, true);
+
+		REQUIRE(listener.firs.size() == 2);
+	}
+
+	SECTION("the interval is derived from the RTT")
+	{
+		manager.AddStream(1111, true, false);
+
+		// Unknown RTT.
+		REQUIRE(manager.GetStats(1111)["requestInterval"].asUInt() == 1000);
+
+		manager.SetRtt(1111, 50);
+
+		REQUIRE(manager.GetStats(1111)["requestInterval"].asUInt() == 300);
+
+		manager.SetRtt(1111, 200);
+
+		REQUIRE(manager.GetStats(1111)["requestInterval"].asUInt() == 600);
+
+		manager.SetRtt(1111, 1000);
+
+		REQUIRE(manager.GetStats(1111)["requestInterval"].asUInt() == 1000);
+	}
+
+	SECTION("every stream has its own interval")
+	{
+		manager.AddStream(1111, true, false);
+		manager.AddStream(2222, true, false);
+
+		manager.SetRtt(1111, 150);
+
+		REQUIRE(manager.GetStats(1111)["requestInterval"].asUInt() == 450);
+		REQUIRE(manager.GetStats(2222)["requestInterval"].asUInt() == 1000);
+
+		// Unknown streams are ignored.
+		manager.SetRtt(3333, 150);
+
+		REQUIRE(manager.GetStats(3333).empty());
+	}
+
+	SECTION("streams without PLI nor FIR are ignored")
+	{
+		manager.AddStream(1111, false, false);
+
+		manager.KeyFrameNeeded(1111);
+
+		REQUIRE(listener.plis.empty());
+		REQUIRE(listener.firs.empty());
+	}
+}
@@ -0,0 +1,81 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/LastN.hpp"
+
+using namespace RTC;
+
+SCENARIO("Last-N selection", "[lastn]")
+{
+	LastN lastN;
+
+	SECTION("Transports without limit get every Producer")
+	{
+		lastN.Begin();
+
+		for (uint32_t producerId{ 1 }; producerId <= 10; ++producerId)
+		{
+			REQUIRE(lastN.Forward(producerId, 1));
+		}
+	}
+
+	SECTION("just the N first Producers are forwarded")
+	{
+		lastN.SetLimit(1, 2);
+		lastN.SetLimit(2, 1);
+		lastN.Begin();
+
+		REQUIRE(lastN.Forward(10, 1));
+		REQUIRE(lastN.Forward(10, 2));
+		REQUIRE(lastN.Forward(10, 3));
+		REQUIRE(lastN.Forward(20, 1));
+		REQUIRE(!lastN.Forward(20, 2));
+		REQUIRE(lastN.Forward(20, 3));
+		REQUIRE(!lastN.Forward(30, 1));
+		REQUIRE(!lastN.Forward(30, 2));
+		REQUIRE(lastN.Forward(30, 3));
+	}
+
+	SECTION("Consumers of the same Producer get the same decision")
+	{
+		lastN.SetLimit(1, 1);
+		lastN.Begin();
+
+		REQUIRE(lastN.Forward(10, 1));
+		REQUIRE(lastN.Forward(10, 1));
+		REQUIRE(!lastN.Forward(20, 1));
+		REQUIRE(!lastN.Forward(20, 1));
+	}
+
+	SECTION("a new selection starts counting again")
+	{
+		lastN.SetLimit(1, 1);
+		lastN.Begin();
+
+		REQUIRE(lastN.Forward(10, 1));
+		REQUIRE(!lastN.Forward(20, 1));
+
+		// Producer 20 became the most active one.
+		lastN.Begin();
+
+		REQUIRE(lastN.Forward(20, 1));
+		REQUIRE(!lastN.Forward(10, 1));
+	}
+
+	SECTION("removing the limit forwards everything")
+	{
+		lastN.SetLimit(1, 0);
+
+		REQUIRE(!lastN.IsEmpty());
+
+		lastN.Begin();
+
+		REQUIRE(!lastN.Forward(10, 1));
+		REQUIRE(lastN.RemoveLimit(1));
+		REQUIRE(!lastN.RemoveLimit(1));
+		REQUIRE(lastN.IsEmpty());
+
+		lastN.Begin();
+
+		REQUIRE(lastN.Forward(10, 1));
+	}
+}
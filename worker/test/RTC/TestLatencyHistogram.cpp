@@ -0,0 +1,48 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/LatencyHistogram.hpp"
+
+using namespace RTC;
+
+SCENARIO("Latency histogram", "[histogram]")
+{
+	LatencyHistogram histogram;
+
+	SECTION("empty histogram")
+	{
+		REQUIRE(histogram.GetCount() == 0);
+		REQUIRE(histogram.GetMax() == 0);
+		REQUIRE(histogram.GetPercentile(50) == 0);
+	}
+
+	SECTION("percentiles are bucket upper bounds")
+	{
+		// 90 values in [4, 7] and 10 values in [64, 127].
+		for (size_t i = 0; i < 90; ++i)
+		{
+			histogram.Add(5);
+		}
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			histogram.Add(100);
+		}
+
+		REQUIRE(histogram.GetCount() == 100);
+		REQUIRE(histogram.GetMax() == 100);
+		REQUIRE(histogram.GetPercentile(50) == 7);
+		REQUIRE(histogram.GetPercentile(90) == 7);
+		REQUIRE(histogram.GetPercentile(99) == 100);
+
+		histogram.Reset();
+
+		REQUIRE(histogram.GetCount() == 0);
+	}
+
+	SECTION("the last bucket has no upper bound")
+	{
+		histogram.Add(1000000);
+
+		REQUIRE(histogram.GetPercentile(50) == 1000000);
+	}
+}
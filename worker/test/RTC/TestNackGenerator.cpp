@@ -39,7 +39,7 @@ public:
 	{
 		return;
 	};
-	bool Encode(RTC::Codecs::EncodingContext* /*context*/, uint8_t* /*data*/)
+	bool Encode(RTC::Codecs::EncodingContext* /*context*/, uint8_t* /*data*/, bool& /*marker*/)
 	{
 		return true;
 	};
@@ -58,14 +58,24 @@ private:
 
 class TestNackGeneratorListener : public NackGenerator::Listener
 {
-	void OnNackGeneratorNackRequired(const std::vector<uint16_t>& seqNumbers) override
+	void OnNackGeneratorNackRequired(const std::vector<NackGenerator::NackItem>& nackItems) override
 	{
 		this->nackRequiredTriggered = true;
 
-		auto it          = seqNumbers.begin();
-		auto firstNacked = *it;
+		auto it          = nackItems.begin();
+		auto firstNacked = it->packetId;
+		size_t numNacked = 0;
 
-		auto numNacked = seqNumbers.size();
+		for (auto& item : nackItems)
+		{
+			numNacked++;
+
+			for (uint16_t bitmask = item.lostPacketBitmask; bitmask != 0; bitmask >>= 1)
+			{
+				if ((bitmask & 1) != 0)
+					numNacked++;
+			}
+		}
 
 		REQUIRE(this->currentInput.firstNacked == firstNacked);
 		REQUIRE(this->currentInput.numNacked == numNacked);
@@ -273,4 +283,86 @@ SCENARIO("NACK generator", "[rtp][rtcp]")
 
 		validate(inputs);
 	}
+
+	SECTION("NACK list spanning sequence wrap")
+	{
+		// clang-format off
+		std::vector<TestNackGeneratorInput> inputs =
+		{
+			{ 65530, false,     0, 0, false, 0 },
+			{     3, false, 65531, 8, false, 8 },
+			{ 65533, false,     0, 0, false, 7 },
+			{     0, false,     0, 0, false, 6 },
+			{     5, false,     4, 1, false, 7 },
+			{ 65531, false,     0, 0, false, 6 }
+		};
+		// clang-format on
+
+		validate(inputs);
+	}
+
+	SECTION("old packet sharing the ring slot of a NACKed packet is ignored")
+	{
+		// clang-format off
+		std::vector<TestNackGeneratorInput> inputs =
+		{
+			{     1, false, 0, 0, false, 0     },
+			{     3, false, 2, 1, false, 1     },
+			// 2 - 8192.
+			{ 57346, false, 0, 0, false, 1     },
+			{     2, false, 0, 0, false, 0     }
+		};
+		// clang-format on
+
+		validate(inputs);
+	}
+
+	SECTION("NACK items older than max packet age are removed")
+	{
+		std::vector<TestNackGeneratorInput> inputs;
+
+		inputs.emplace_back(65000, false, 0, 0, false, 0);
+		inputs.emplace_back(65002, false, 65001, 1, false, 1);
+
+		// Packet 65001 remains in the NACK list until it becomes 5000 packets old.
+		for (uint16_t seq = 65003; seq != 4466; ++seq)
+		{
+			inputs.emplace_back(seq, false, 0, 0, false, 1);
+		}
+
+		inputs.emplace_back(4466, false, 0, 0, false, 0);
+
+		validate(inputs);
+	}
+
+	SECTION("requested packets are not NACKed again within the RTT")
+	{
+		TestNackGeneratorListener listener;
+		NackGenerator nackGenerator(&listener);
+		// clang-format off
+		std::vector<TestNackGeneratorInput> inputs =
+		{
+			{ 1, false, 0, 0, false, 0 },
+			{ 5, false, 2, 3, false, 3 }
+		};
+		// clang-format on
+
+		for (auto input : inputs)
+		{
+			listener.Reset(input);
+
+			packet->SetPayloadDescriptorHandler(new TestPayloadDescriptorHandler(input.isKeyFrame));
+			packet->SetSequenceNumber(input.seq);
+			nackGenerator.ReceivePacket(packet);
+
+			listener.Check(nackGenerator);
+		}
+
+		// Packets 2, 3 and 4 were just NACKed while 1, 5 and 6 are not missing.
+		TestNackGeneratorInput input(5, false, 0, 0, false, 3);
+
+		listener.Reset(input);
+		nackGenerator.RequestPackets({ 1, 2, 3, 4, 5, 6 });
+		listener.Check(nackGenerator);
+	}
 }
@@ -0,0 +1,33 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/PacketLatency.hpp"
+
+using namespace RTC;
+
+SCENARIO("Packet latency", "[latency]")
+{
+	SECTION("one of every SampleRate packets is sampled")
+	{
+		size_t sampled{ 0 };
+
+		for (uint32_t i{ 0 }; i < 4 * PacketLatency::SampleRate; ++i)
+		{
+			PacketLatency::Ingress ingress;
+
+			if (PacketLatency::IsSampled())
+				++sampled;
+		}
+
+		REQUIRE(sampled == 4);
+	}
+
+	SECTION("nothing is sampled out of an ingress scope")
+	{
+		for (uint32_t i{ 0 }; i < PacketLatency::SampleRate; ++i)
+		{
+			PacketLatency::Ingress ingress;
+		}
+
+		REQUIRE(!PacketLatency::IsSampled());
+	}
+}
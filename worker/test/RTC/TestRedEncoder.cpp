@@ -0,0 +1,181 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/RedEncoder.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <cstring> // std::memcmp()
+
+using namespace RTC;
+
+static constexpr uint8_t OpusPayloadType{ 111 };
+static constexpr uint8_t RedPayloadType{ 63 };
+
+static uint8_t buffer[RTC::MtuSize];
+
+// Create an Opus packet whose payload bytes are derived from its seq.
+static RtpPacket* createPacket(uint16_t seq, uint32_t timestamp, size_t payloadSize)
+{
+	buffer[0] = 0x80;
+	buffer[1] = OpusPayloadType;
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, timestamp);
+	Utils::Byte::Set4Bytes(buffer, 8, 1234);
+
+	for (size_t i = 0; i < payloadSize; ++i)
+	{
+		buffer[12 + i] = static_cast<uint8_t>(seq + i);
+	}
+
+	return RtpPacket::Parse(buffer, 12 + payloadSize);
+}
+
+static void checkPayload(const uint8_t* data, uint16_t seq, size_t payloadSize)
+{
+	for (size_t i = 0; i < payloadSize; ++i)
+	{
+		REQUIRE(data[i] == static_cast<uint8_t>(seq + i));
+	}
+}
+
+SCENARIO("RED encoder", "[rtp][red]")
+{
+	SECTION("disabled encoder does not produce RED packets")
+	{
+		RedEncoder encoder(RedPayloadType);
+
+		auto* packet = createPacket(1000, 48000, 80);
+
+		REQUIRE(encoder.GetDistance() == 0);
+		REQUIRE(encoder.Encode(packet) == nullptr);
+		REQUIRE(encoder.GetPacketCount() == 0);
+
+		delete packet;
+	}
+
+	SECTION("fraction lost drives the distance with hysteresis")
+	{
+		RedEncoder encoder(RedPayloadType);
+
+		encoder.SetFractionLost(4);
+		REQUIRE(encoder.GetDistance() == 0);
+		encoder.SetFractionLost(5);
+		REQUIRE(encoder.GetDistance() == 1);
+		encoder.SetFractionLost(4);
+		REQUIRE(encoder.GetDistance() == 1);
+		encoder.SetFractionLost(26);
+		REQUIRE(encoder.GetDistance() == 2);
+		encoder.SetFractionLost(10);
+		REQUIRE(encoder.GetDistance() == 1);
+		encoder.SetFractionLost(2);
+		REQUIRE(encoder.GetDistance() == 0);
+	}
+
+	SECTION("previous payloads are carried as redundant blocks")
+	{
+		RedEncoder encoder(RedPayloadType);
+
+		encoder.SetDistance(2);
+
+		// Sequence numbers wrap around.
+		uint16_t seq       = 65534;
+		uint32_t timestamp = 48000;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			size_t payloadSize = 60 + i * 10;
+			auto* packet       = createPacket(seq, timestamp, payloadSize);
+			auto* redPacket    = encoder.Encode(packet);
+
+			REQUIRE(redPacket);
+			REQUIRE(redPacket->GetPayloadType() == RedPayloadType);
+			REQUIRE(redPacket->GetSequenceNumber() == seq);
+			REQUIRE(redPacket->GetTimestamp() == timestamp);
+			REQUIRE(redPacket->GetSsrc() == 1234);
+
+			size_t numRedundant = i < 2 ? i : 2;
+			const uint8_t* data = redPacket->GetPayload();
+			const uint8_t* ptr  = data + numRedundant * 4 + 1;
+
+			// Redundant blocks, the oldest one first.
+			for (size_t j = 0; j < numRedundant; ++j)
+			{
+				size_t distance   = numRedundant - j;
+				uint32_t tsOffset = (data[j * 4 + 1] << 6) | (data[j * 4 + 2] >> 2);
+				size_t length     = ((data[j * 4 + 2] & 0x03) << 8) | data[j * 4 + 3];
+
+				REQUIRE((data[j * 4] & 0x80) == 0x80);
+				REQUIRE((data[j * 4] & 0x7F) == OpusPayloadType);
+				REQUIRE(tsOffset == distance * 960);
+				REQUIRE(length == 60 + (i - distance) * 10);
+
+				checkPayload(ptr, static_cast<uint16_t>(seq - distance), length);
+				ptr += length;
+			}
+
+			// Primary block.
+			REQUIRE(data[numRedundant * 4] == OpusPayloadType);
+			REQUIRE(static_cast<size_t>(data + redPacket->GetPayloadLength() - ptr) == payloadSize);
+			checkPayload(ptr, seq, payloadSize);
+
+			delete redPacket;
+			delete packet;
+
+			seq++;
+			timestamp += 960;
+		}
+
+		REQUIRE(encoder.GetPacketCount() == 4);
+		// 1 primary header per packet plus 4 bytes header per redundant block.
+		REQUIRE(
+		  encoder.GetRedundantBytes() == 4 + (1 * 4 + 60) + (2 * 4 + 60 + 70) + (2 * 4 + 70 + 80));
+	}
+
+	SECTION("non consecutive payloads are not carried")
+	{
+		RedEncoder encoder(RedPayloadType);
+
+		encoder.SetDistance(1);
+
+		auto* packet    = createPacket(1000, 48000, 50);
+		auto* redPacket = encoder.Encode(packet);
+
+		delete redPacket;
+		delete packet;
+
+		// A gap in the sequence numbers.
+		packet    = createPacket(1002, 49920, 50);
+		redPacket = encoder.Encode(packet);
+
+		REQUIRE(redPacket);
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 50);
+
+		delete redPacket;
+		delete packet;
+	}
+
+	SECTION("packets already RED are not wrapped again")
+	{
+		RedEncoder encoder(RedPayloadType);
+
+		encoder.SetDistance(1);
+
+		auto* packet = createPacket(1000, 48000, 50);
+
+		packet->SetPayloadType(RedPayloadType);
+
+		REQUIRE(encoder.Encode(packet) == nullptr);
+		REQUIRE(encoder.GetPacketCount() == 0);
+
+		delete packet;
+
+		// The RED payload is not carried as a redundant block.
+		packet          = createPacket(1001, 48960, 50);
+		auto* redPacket = encoder.Encode(packet);
+
+		REQUIRE(redPacket);
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 50);
+
+		delete redPacket;
+		delete packet;
+	}
+}
@@ -0,0 +1,87 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/RetransmissionBudget.hpp"
+
+using namespace RTC;
+
+SCENARIO("Retransmission budget", "[rtp][rtx]")
+{
+	uint64_t now = 1000;
+
+	SECTION("budget is a fraction of the media bitrate")
+	{
+		RetransmissionBudget budget;
+
+		// 1 Mbps media: 500 kbps budget, 31250 bytes bucket.
+		REQUIRE(budget.Consume(1000, 1000000, now));
+		REQUIRE(budget.GetBitrate() == 500000);
+		REQUIRE(budget.GetPacketsDropped() == 0);
+	}
+
+	SECTION("budget has a minimum bitrate")
+	{
+		RetransmissionBudget budget;
+
+		REQUIRE(budget.Consume(1000, 0, now));
+		REQUIRE(budget.GetBitrate() == 64000);
+	}
+
+	SECTION("retransmissions are dropped once the budget is exhausted")
+	{
+		RetransmissionBudget budget;
+		size_t sent{ 0 };
+
+		// 31250 bytes bucket allows 31 packets of 1000 bytes.
+		for (size_t i = 0; i < 40; ++i)
+		{
+			if (budget.Consume(1000, 1000000, now))
+				sent++;
+		}
+
+		REQUIRE(sent == 31);
+		REQUIRE(budget.GetPacketsDropped() == 9);
+		REQUIRE(budget.GetBytesDropped() == 9000);
+
+		// 500 kbps refill: 62 bytes per ms, so 1000 bytes take 17 ms.
+		REQUIRE(!budget.Consume(1000, 1000000, now + 10));
+		REQUIRE(budget.Consume(1000, 1000000, now + 20));
+		REQUIRE(budget.GetPacketsDropped() == 10);
+	}
+
+	SECTION("budget does not grow beyond the burst window")
+	{
+		RetransmissionBudget budget;
+		size_t sent{ 0 };
+
+		REQUIRE(budget.Consume(1000, 1000000, now));
+
+		for (size_t i = 0; i < 40; ++i)
+		{
+			if (budget.Consume(1000, 1000000, now + 10000))
+				sent++;
+		}
+
+		REQUIRE(sent == 31);
+	}
+
+	SECTION("reset starts with a full bucket again")
+	{
+		RetransmissionBudget budget;
+
+		for (size_t i = 0; i < 40; ++i)
+		{
+			budget.Consume(1000, 1000000, now);
+		}
+
+		REQUIRE(!budget.Consume(1000, 1000000, now));
+
+		budget.Reset();
+
+		REQUIRE(budget.GetBitrate() == 0);
+
+		// The media bitrate may be different after the reset.
+		REQUIRE(budget.Consume(5000, 200000, now + 1));
+		REQUIRE(budget.GetBitrate() == 100000);
+		REQUIRE(budget.GetPacketsDropped() == 10);
+	}
+}
@@ -0,0 +1,113 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "MediaSoupError.hpp"
+#include "RTC/RtpParametersCache.hpp"
+#include <json/json.h>
+
+using namespace RTC;
+
+// VP8 and RTX parameters as sent by the Node side when enabling a Consumer.
+static Json::Value createRtpParameters(uint32_t ssrc, uint32_t rtxSsrc)
+{
+	Json::Value json(Json::objectValue);
+	Json::Value vp8(Json::objectValue);
+	Json::Value rtx(Json::objectValue);
+	Json::Value encoding(Json::objectValue);
+
+	vp8["mimeType"]    = "video/VP8";
+	vp8["payloadType"] = 101;
+	vp8["clockRate"]   = 90000;
+
+	rtx["mimeType"]          = "video/rtx";
+	rtx["payloadType"]       = 102;
+	rtx["clockRate"]         = 90000;
+	rtx["parameters"]["apt"] = 101;
+
+	encoding["ssrc"]             = ssrc;
+	encoding["codecPayloadType"] = 101;
+	encoding["rtx"]["ssrc"]      = rtxSsrc;
+
+	json["codecs"].append(vp8);
+	json["codecs"].append(rtx);
+	json["encodings"].append(encoding);
+	json["headerExtensions"] = Json::arrayValue;
+	json["rtcp"]["cname"]    = "test";
+
+	return json;
+}
+
+SCENARIO("RTP parameters cache", "[rtp][parameters]")
+{
+	SECTION("Consumers with the same capabilities share the parameters")
+	{
+		RtpParametersCache cache;
+		auto json1 = createRtpParameters(1111, 2222);
+		auto json2 = createRtpParameters(3333, 4444);
+
+		auto rtpParameters1 = cache.Get(json1);
+		auto rtpParameters2 = cache.Get(json2);
+
+		REQUIRE(rtpParameters1 == rtpParameters2);
+		REQUIRE(cache.GetSize() == 1);
+
+		// SSRCs are not shared.
+		REQUIRE(rtpParameters1->GetRtpParameters().encodings[0].ssrc == 0);
+
+		auto encoding1 = rtpParameters1->GetEncoding(json1);
+		auto encoding2 = rtpParameters2->GetEncoding(json2);
+
+		REQUIRE(encoding1.ssrc == 1111);
+		REQUIRE(encoding1.rtx.ssrc == 2222);
+		REQUIRE(encoding2.ssrc == 3333);
+		REQUIRE(encoding2.rtx.ssrc == 4444);
+	}
+
+	SECTION("derived data")
+	{
+		RtpParametersCache cache;
+		auto json          = createRtpParameters(1111, 2222);
+		auto rtpParameters = cache.Get(json);
+
+		REQUIRE(rtpParameters->IsSupportedPayloadType(101));
+		REQUIRE(rtpParameters->IsSupportedPayloadType(102));
+		REQUIRE(!rtpParameters->IsSupportedPayloadType(100));
+		REQUIRE(!rtpParameters->IsComfortNoisePayloadType(101));
+		REQUIRE(rtpParameters->GetCodec(101)->clockRate == 90000);
+		REQUIRE(rtpParameters->GetRtxCodec(101)->payloadType == 102);
+		REQUIRE(rtpParameters->GetRtxCodec(102) == nullptr);
+	}
+
+	SECTION("different parameters are not shared and unused ones are released")
+	{
+		RtpParametersCache cache;
+		auto json1 = createRtpParameters(1111, 2222);
+		auto json2 = createRtpParameters(3333, 4444);
+
+		json2["rtcp"]["cname"] = "other";
+
+		auto rtpParameters1 = cache.Get(json1);
+
+		{
+			auto rtpParameters2 = cache.Get(json2);
+
+			REQUIRE(rtpParameters1 != rtpParameters2);
+			REQUIRE(cache.GetSize() == 2);
+		}
+
+		json2["rtcp"]["cname"] = "another";
+
+		auto rtpParameters3 = cache.Get(json2);
+
+		// The entry of rtpParameters2 was removed.
+		REQUIRE(cache.GetSize() == 2);
+		REQUIRE(rtpParameters3 != rtpParameters1);
+	}
+
+	SECTION("invalid parameters throw")
+	{
+		RtpParametersCache cache;
+		Json::Value json(Json::objectValue);
+
+		REQUIRE_THROWS_AS(cache.Get(json), MediaSoupError);
+	}
+}
@@ -1,5 +1,6 @@
 #include "common.hpp"
 #include "catch.hpp"
+#include "DepLibUV.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamRecv.hpp"
@@ -7,6 +8,24 @@
 
 using namespace RTC;
 
+// Allows running the status check without waiting for the timer.
+class TestRtpStreamRecv : public RtpStreamRecv
+{
+public:
+	TestRtpStreamRecv(Listener* listener, RtpStream::Params& params)
+	  : RtpStreamRecv(listener, params)
+	{
+	}
+
+public:
+	using RtpStreamRecv::CheckStatus;
+
+	void SetMaxPacketMs(uint64_t maxPacketMs)
+	{
+		this->maxPacketMs = maxPacketMs;
+	}
+};
+
 SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 {
 	class RtpStreamRecvListener : public RtpStreamRecv::Listener
@@ -14,24 +33,39 @@ SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 	public:
 		virtual void OnRtpStreamActive(RTC::RtpStream* /*rtpStream*/) override
 		{
+			this->activeCount++;
 		}
 
 		virtual void OnRtpStreamInactive(RTC::RtpStream* /*rtpStream*/) override
 		{
+			this->inactiveCount++;
 		}
 
 		virtual void OnRtpStreamRecvNackRequired(
-		  RTC::RtpStreamRecv* /*rtpStream*/, const std::vector<uint16_t>& seqNumbers) override
+		  RTC::RtpStreamRecv* /*rtpStream*/,
+		  const std::vector<RTC::NackGenerator::NackItem>& nackItems) override
 		{
 			INFO("NACK required");
 
 			REQUIRE(this->shouldTriggerNack == true);
 
 			this->shouldTriggerNack = false;
-			this->seqNumbers        = seqNumbers;
+			this->seqNumbers.clear();
+
+			for (auto& item : nackItems)
+			{
+				this->seqNumbers.push_back(item.packetId);
+
+				for (uint16_t shift = 0; shift <= 15; ++shift)
+				{
+					if ((item.lostPacketBitmask & (1 << shift)) != 0)
+						this->seqNumbers.push_back(item.packetId + shift + 1);
+				}
+			}
 		}
 
-		virtual void OnRtpStreamRecvPliRequired(RtpStreamRecv* /*rtpStream*/) override
+		virtual void OnRtpStreamRecvKeyFrameRequired(
+		  RtpStreamRecv* /*rtpStream*/, bool /*force*/) override
 		{
 			INFO("PLI required");
 
@@ -45,6 +79,8 @@ SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 		bool shouldTriggerNack     = false;
 		bool shouldTriggerKeyFrame = false;
 		std::vector<uint16_t> seqNumbers;
+		size_t activeCount{ 0 };
+		size_t inactiveCount{ 0 };
 	};
 
 	// clang-format off
@@ -128,5 +164,48 @@ SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 		rtpStream.ReceivePacket(packet);
 	}
 
+	SECTION("audio stream in DTX silence is not inactive until 5 seconds")
+	{
+		params.mimeType.type    = RtpCodecMimeType::Type::AUDIO;
+		params.mimeType.subtype = RtpCodecMimeType::Subtype::OPUS;
+		params.clockRate        = 48000;
+
+		RtpStreamRecvListener listener;
+		TestRtpStreamRecv rtpStream(&listener, params);
+
+		packet->SetSequenceNumber(1);
+		rtpStream.ReceivePacket(packet);
+
+		auto now = DepLibUV::GetTime();
+
+		REQUIRE(now > 5000);
+
+		// No packet for 4 seconds (DTX silence).
+		rtpStream.SetMaxPacketMs(now - 4000);
+		rtpStream.CheckStatus();
+
+		REQUIRE(rtpStream.IsActive());
+		REQUIRE(listener.inactiveCount == 0);
+
+		// No packet for more than 5 seconds.
+		rtpStream.SetMaxPacketMs(now - 5001);
+		rtpStream.CheckStatus();
+
+		REQUIRE(!rtpStream.IsActive());
+		REQUIRE(listener.inactiveCount == 1);
+
+		// Still inactive, not notified again.
+		rtpStream.CheckStatus();
+
+		REQUIRE(listener.inactiveCount == 1);
+
+		// Packets are received again.
+		rtpStream.SetMaxPacketMs(now);
+		rtpStream.CheckStatus();
+
+		REQUIRE(rtpStream.IsActive());
+		REQUIRE(listener.activeCount == 1);
+	}
+
 	delete packet;
 }
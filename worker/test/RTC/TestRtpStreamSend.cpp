@@ -126,6 +126,14 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp]")
 
 		REQUIRE(rtxPacket6 == nullptr);
 
+		// Packets never sent are reported as missing, but not the ones already
+		// resent or older than the buffer.
+		REQUIRE(
+		  stream->RequestRtpRetransmission(21009, 0b0000000000000111, rtpRetransmissionContainer) ==
+		  0b1100);
+		REQUIRE(rtpRetransmissionContainer[0] == nullptr);
+		REQUIRE(stream->RequestRtpRetransmission(21000, 0, rtpRetransmissionContainer) == 0);
+
 		// Clean stuff.
 		delete packet1;
 		delete packet2;
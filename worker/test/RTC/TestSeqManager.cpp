@@ -282,4 +282,92 @@ SCENARIO("RTC::SeqManager", "[rtc]")
 		RTC::SeqManager<uint16_t> seqManager;
 		validate(seqManager, inputs);
 	}
+
+	SECTION("get input from output, sync, drop")
+	{
+		// clang-format off
+		std::vector<TestSeqManagerInput> inputs =
+		{
+			{  0,  0, false, false },
+			{  1,  1, false, false },
+			{ 80,  2,  true, false }, // sync.
+			{ 81,  3, false, false },
+			{ 82,  0, false,  true }, // drop.
+			{ 83,  0, false,  true }, // drop.
+			{ 84,  4, false, false },
+			{ 86,  6, false, false }, // 85 lost.
+		};
+		// clang-format on
+
+		RTC::SeqManager<uint16_t> seqManager;
+		validate(seqManager, inputs);
+
+		uint16_t input;
+
+		// Outputs before the sync.
+		REQUIRE(!seqManager.GetInput(0, input));
+		REQUIRE(!seqManager.GetInput(1, input));
+		// Not yet produced output.
+		REQUIRE(!seqManager.GetInput(7, input));
+
+		REQUIRE(seqManager.GetInput(2, input));
+		REQUIRE(input == 80);
+		REQUIRE(seqManager.GetInput(3, input));
+		REQUIRE(input == 81);
+		REQUIRE(seqManager.GetInput(4, input));
+		REQUIRE(input == 84);
+		REQUIRE(seqManager.GetInput(5, input));
+		REQUIRE(input == 85);
+		REQUIRE(seqManager.GetInput(6, input));
+		REQUIRE(input == 86);
+	}
+
+	SECTION("drop long runs across wraps, outputs stay consecutive")
+	{
+		RTC::SeqManager<uint16_t> seqManager;
+		uint16_t output;
+		uint16_t input;
+
+		seqManager.Sync(65530);
+
+		REQUIRE(seqManager.Input(65530, output));
+		REQUIRE(output == 1);
+
+		// Dropped inputs across the wrap.
+		for (uint16_t seq = 65531; seq != 5; ++seq)
+		{
+			seqManager.Drop(seq);
+		}
+
+		REQUIRE(seqManager.Input(5, output));
+		REQUIRE(output == 2);
+		REQUIRE(seqManager.GetInput(1, input));
+		REQUIRE(input == 65530);
+		REQUIRE(seqManager.GetInput(2, input));
+		REQUIRE(input == 5);
+
+		// A long run of dropped inputs (i.e. DTX silence).
+		for (uint16_t seq = 6; seq != 20006; ++seq)
+		{
+			seqManager.Drop(seq);
+		}
+
+		REQUIRE(seqManager.Input(20006, output));
+		REQUIRE(output == 3);
+
+		// Keep sending across the next wrap.
+		uint16_t expected = 4;
+		size_t gaps{ 0 };
+
+		for (uint16_t seq = 20007; seq != 10000; ++seq, ++expected)
+		{
+			if (!seqManager.Input(seq, output) || output != expected)
+				gaps++;
+		}
+
+		REQUIRE(gaps == 0);
+
+		REQUIRE(seqManager.GetInput(expected - 1, input));
+		REQUIRE(input == 9999);
+	}
 }
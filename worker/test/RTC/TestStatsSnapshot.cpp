@@ -0,0 +1,141 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/StatsSnapshot.hpp"
+
+using namespace RTC;
+
+static StatsSnapshot::Record createConsumerRecord(
+  uint32_t id, uint64_t packetCount, uint32_t bitrate)
+{
+	StatsSnapshot::Record record;
+
+	record.type        = StatsSnapshot::RecordType::CONSUMER;
+	record.id          = id;
+	record.ssrc        = 1234;
+	record.bitrate     = bitrate;
+	record.packetCount = packetCount;
+	record.byteCount   = packetCount * 1000;
+	record.nackCount   = 2;
+
+	return record;
+}
+
+SCENARIO("router stats snapshot", "[stats]")
+{
+	SECTION("header and records layout")
+	{
+		StatsSnapshot snapshot;
+
+		snapshot.Begin(1000, false);
+		snapshot.AddRecord(createConsumerRecord(1, 10, 500000));
+
+		const uint8_t* data = snapshot.GetData();
+
+		REQUIRE(snapshot.GetSize() == StatsSnapshot::HeaderSize + StatsSnapshot::RecordSize);
+		REQUIRE(data[0] == uint8_t{ StatsSnapshot::Version });
+		REQUIRE(data[1] == 0x00);
+		REQUIRE(Utils::Byte::Get2Bytes(data, 2) == size_t{ StatsSnapshot::RecordSize });
+		REQUIRE(Utils::Byte::Get4Bytes(data, 4) == 1);
+		REQUIRE(Utils::Byte::Get8Bytes(data, 8) == 1000);
+
+		const uint8_t* record = data + StatsSnapshot::HeaderSize;
+
+		REQUIRE(record[0] == static_cast<uint8_t>(StatsSnapshot::RecordType::CONSUMER));
+		REQUIRE(Utils::Byte::Get4Bytes(record, 4) == 1);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 8) == 1234);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 12) == 500000);
+		REQUIRE(Utils::Byte::Get8Bytes(record, 16) == 10);
+		REQUIRE(Utils::Byte::Get8Bytes(record, 24) == 10000);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 36) == 2);
+	}
+
+	SECTION("deltas since the previous snapshot")
+	{
+		StatsSnapshot snapshot;
+
+		snapshot.Begin(1000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 10, 500000));
+
+		snapshot.Begin(2000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 25, 600000));
+		snapshot.AddRecord(createConsumerRecord(2, 5, 100000));
+
+		const uint8_t* data    = snapshot.GetData();
+		const uint8_t* record1 = data + StatsSnapshot::HeaderSize;
+		const uint8_t* record2 = record1 + StatsSnapshot::RecordSize;
+
+		REQUIRE(data[1] == 0x01);
+		REQUIRE(Utils::Byte::Get4Bytes(data, 4) == 2);
+		// Counters are deltas, bitrates are not.
+		REQUIRE(Utils::Byte::Get8Bytes(record1, 16) == 15);
+		REQUIRE(Utils::Byte::Get8Bytes(record1, 24) == 15000);
+		REQUIRE(Utils::Byte::Get4Bytes(record1, 36) == 0);
+		REQUIRE(Utils::Byte::Get4Bytes(record1, 12) == 600000);
+		// New objects report their full counters.
+		REQUIRE(Utils::Byte::Get8Bytes(record2, 16) == 5);
+
+		// An object missing in a snapshot starts from scratch afterwards.
+		snapshot.Begin(3000, true);
+		snapshot.Begin(4000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 30, 600000));
+
+		REQUIRE(Utils::Byte::Get8Bytes(snapshot.GetData() + StatsSnapshot::HeaderSize, 16) == 30);
+	}
+
+	SECTION("reset counters are reported as a new record")
+	{
+		StatsSnapshot snapshot;
+
+		snapshot.Begin(1000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 100, 500000));
+
+		snapshot.Begin(2000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 30, 500000));
+
+		const uint8_t* record = snapshot.GetData() + StatsSnapshot::HeaderSize;
+
+		REQUIRE(Utils::Byte::Get8Bytes(record, 16) == 30);
+		REQUIRE(Utils::Byte::Get8Bytes(record, 24) == 30000);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 36) == 2);
+
+		// Deltas go on from the reset counters.
+		snapshot.Begin(3000, true);
+		snapshot.AddRecord(createConsumerRecord(1, 40, 500000));
+
+		REQUIRE(Utils::Byte::Get8Bytes(snapshot.GetData() + StatsSnapshot::HeaderSize, 16) == 10);
+	}
+
+	SECTION("transport records")
+	{
+		StatsSnapshot snapshot;
+		StatsSnapshot::Record record;
+
+		record.type          = StatsSnapshot::RecordType::TRANSPORT;
+		record.id            = 7;
+		record.bytesReceived = 3000;
+		record.bytesSent     = 5000;
+
+		snapshot.Begin(1000, true);
+		snapshot.AddRecord(record);
+
+		record.bytesReceived = 3500;
+		record.bytesSent     = 9000;
+
+		snapshot.Begin(2000, true);
+		snapshot.AddRecord(record);
+
+		const uint8_t* data = snapshot.GetData() + StatsSnapshot::HeaderSize;
+
+		REQUIRE(data[0] == static_cast<uint8_t>(StatsSnapshot::RecordType::TRANSPORT));
+		REQUIRE(Utils::Byte::Get4Bytes(data, 4) == 7);
+		REQUIRE(Utils::Byte::Get8Bytes(data, 16) == 500);
+		REQUIRE(Utils::Byte::Get8Bytes(data, 24) == 4000);
+
+		// Reserved fields are zero.
+		for (size_t idx : { 1, 2, 3, 8, 15, 32, 47 })
+		{
+			REQUIRE(data[idx] == 0);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Logger.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include <cstring> // std::strcpy()
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Read everything written so far by the Channel.
+static std::string readChannel(int fd)
+{
+	std::string data;
+	char buffer[65536];
+	ssize_t len;
+
+	while ((len = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+	{
+		data.append(buffer, static_cast<size_t>(len));
+	}
+
+	return data;
+}
+
+SCENARIO("Logger ring", "[logger]")
+{
+	int fds[2];
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	auto* channel = new Channel::UnixStreamSocket(fds[0]);
+
+	Logger::channel = channel;
+
+	uint64_t droppedRecords = Logger::droppedRecords;
+
+	SECTION("records are sent on flush with their strings copied")
+	{
+		Logger::CallSite callSite;
+		char text[] = "hello";
+
+		Logger::Enqueue(callSite, "D%s %d", static_cast<const char*>(text), 5);
+		std::strcpy(text, "bye..");
+
+		REQUIRE(readChannel(fds[1]).empty());
+
+		Logger::Flush();
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(data.find("Dhello 5") != std::string::npos);
+		REQUIRE(data.find("bye") == std::string::npos);
+
+		// The ring is empty after a flush.
+		Logger::Flush();
+
+		REQUIRE(readChannel(fds[1]).empty());
+	}
+
+	SECTION("null strings are logged as (null)")
+	{
+		Logger::CallSite callSite;
+		const char* text{ nullptr };
+
+		Logger::Enqueue(callSite, "D%s", text);
+		Logger::Flush();
+
+		REQUIRE(readChannel(fds[1]).find("D(null)") != std::string::npos);
+	}
+
+	SECTION("every call site is limited to MaxRecordsPerSecond")
+	{
+		Logger::CallSite callSite1;
+		Logger::CallSite callSite2;
+
+		// The loop time does not advance here.
+		for (uint32_t i{ 0 }; i < Logger::MaxRecordsPerSecond + 10; ++i)
+		{
+			Logger::Enqueue(callSite1, "Dsite1");
+		}
+
+		Logger::Enqueue(callSite2, "Dsite2");
+
+		REQUIRE(Logger::droppedRecords - droppedRecords == 10);
+
+		Logger::Flush();
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(data.find("Dsite2") != std::string::npos);
+		REQUIRE(data.find("10 log records dropped") != std::string::npos);
+	}
+
+	SECTION("records not fitting into the ring are dropped")
+	{
+		// Big records whose formatted text is empty, so nothing is sent.
+		std::string text(8000, 'x');
+		size_t count = Logger::RingSize / text.size() + 10;
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			Logger::CallSite callSite;
+
+			Logger::Enqueue(callSite, "%.0s", text.c_str());
+		}
+
+		uint64_t dropped = Logger::droppedRecords - droppedRecords;
+
+		REQUIRE(dropped > 0);
+		REQUIRE(dropped < count);
+
+		Logger::Flush();
+
+		std::string data = readChannel(fds[1]);
+
+		REQUIRE(data.find(std::to_string(dropped) + " log records dropped") != std::string::npos);
+
+		// There is room again after a flush.
+		Logger::CallSite callSite;
+
+		Logger::Enqueue(callSite, "Dagain");
+		Logger::Flush();
+
+		REQUIRE(readChannel(fds[1]).find("Dagain") != std::string::npos);
+	}
+
+	Logger::channel = nullptr;
+	channel->Destroy();
+	close(fds[1]);
+}
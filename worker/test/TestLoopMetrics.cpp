@@ -0,0 +1,54 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "LoopMetrics.hpp"
+#include <json/json.h>
+#include <unistd.h> // usleep()
+
+SCENARIO("loop metrics idle and busy time", "[loopmetrics]")
+{
+	// Start an iteration and discard whatever was accounted so far.
+	LoopMetrics::OnUvPrepare();
+	LoopMetrics::TakeWindow();
+
+	// Blocked in the poll phase waiting for I/O.
+	usleep(20000);
+
+	// I/O handled in the poll phase.
+	{
+		LoopMetrics::Scope scope(LoopMetrics::Category::UDP);
+
+		usleep(10000);
+	}
+
+	LoopMetrics::OnUvCheck();
+
+	// Work after the poll phase (i.e. timers in the next iteration).
+	{
+		LoopMetrics::Scope scope(LoopMetrics::Category::TIMER);
+
+		usleep(5000);
+	}
+
+	LoopMetrics::OnUvPrepare();
+
+	Json::Value json = LoopMetrics::TakeWindow();
+
+	uint64_t idleTime = json["idleTime"].asUInt64();
+	uint64_t busyTime = json["busyTime"].asUInt64();
+
+	REQUIRE(json["iterations"].asUInt64() == 1);
+	REQUIRE(idleTime >= 20000);
+	REQUIRE(busyTime >= 15000);
+	REQUIRE(json["handlerTime"]["udp"].asUInt64() >= 10000);
+	REQUIRE(json["handlerTime"]["timer"].asUInt64() >= 5000);
+	REQUIRE(json["handlerTime"]["udp"].asUInt64() <= busyTime);
+	REQUIRE(json["handlerTime"]["tcp"].asUInt64() == 0);
+	REQUIRE(json["utilization"].asDouble() > 0.0);
+	REQUIRE(json["utilization"].asDouble() < 1.0);
+
+	// The window is reset once taken.
+	json = LoopMetrics::TakeWindow();
+
+	REQUIRE(json["iterations"].asUInt64() == 0);
+	REQUIRE(json["busyTime"].asUInt64() == 0);
+}
@@ -0,0 +1,114 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "SharedMetrics.hpp"
+#include "Utils.hpp"
+#include "RTC/StatsSnapshot.hpp"
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+class TestSharedMetricsListener : public SharedMetrics::Listener
+{
+public:
+	void OnSharedMetricsCollect(
+	  SharedMetrics* /*sharedMetrics*/, RTC::StatsSnapshot& snapshot, uint64_t /*now*/) override
+	{
+		for (uint32_t id{ 1 }; id <= this->recordCount; ++id)
+		{
+			RTC::StatsSnapshot::Record record;
+
+			record.type        = RTC::StatsSnapshot::RecordType::CONSUMER;
+			record.id          = id;
+			record.packetCount = this->packetCount;
+
+			snapshot.AddRecord(record);
+		}
+	}
+
+public:
+	uint32_t recordCount{ 0 };
+	uint64_t packetCount{ 0 };
+};
+
+SCENARIO("shared metrics region", "[stats]")
+{
+	static const std::string path{ "/tmp/mediasoup-worker-test.metrics" };
+	static const size_t regionSize{ SharedMetrics::HeaderSize + SharedMetrics::Capacity };
+
+	SECTION("readers get the latest published snapshot")
+	{
+		TestSharedMetricsListener listener;
+
+		listener.recordCount = 2;
+		listener.packetCount = 10;
+
+		auto* sharedMetrics = new SharedMetrics(&listener, path, 1000);
+
+		int fd = open(path.c_str(), O_RDONLY);
+
+		REQUIRE(fd != -1);
+
+		void* addr = mmap(nullptr, regionSize, PROT_READ, MAP_SHARED, fd, 0);
+
+		REQUIRE(addr != MAP_FAILED);
+
+		auto* region = static_cast<const uint8_t*>(addr);
+		auto* header = reinterpret_cast<const SharedMetrics::Header*>(region);
+		std::vector<uint8_t> snapshot;
+		uint64_t loopLag;
+
+		REQUIRE(header->magic == uint32_t{ SharedMetrics::Magic });
+		REQUIRE(header->version == uint32_t{ SharedMetrics::Version });
+		REQUIRE(sharedMetrics->GetSequence() == 2);
+		REQUIRE(SharedMetrics::Read(region, snapshot, loopLag));
+		REQUIRE(snapshot.size() == RTC::StatsSnapshot::HeaderSize + 2 * RTC::StatsSnapshot::RecordSize);
+		REQUIRE(Utils::Byte::Get4Bytes(snapshot.data(), 4) == 2);
+		REQUIRE(Utils::Byte::Get8Bytes(snapshot.data(), RTC::StatsSnapshot::HeaderSize + 16) == 10);
+
+		listener.recordCount = 3;
+		listener.packetCount = 20;
+		sharedMetrics->Publish();
+
+		REQUIRE(sharedMetrics->GetSequence() == 4);
+		REQUIRE(SharedMetrics::Read(region, snapshot, loopLag));
+		REQUIRE(Utils::Byte::Get4Bytes(snapshot.data(), 4) == 3);
+		REQUIRE(Utils::Byte::Get8Bytes(snapshot.data(), RTC::StatsSnapshot::HeaderSize + 16) == 20);
+		REQUIRE(header->flags == 0);
+
+		munmap(addr, regionSize);
+		close(fd);
+		delete sharedMetrics;
+
+		// The file is removed when closed.
+		REQUIRE(access(path.c_str(), F_OK) == -1);
+	}
+
+	SECTION("snapshots being written are not read")
+	{
+		TestSharedMetricsListener listener;
+		auto* sharedMetrics = new SharedMetrics(&listener, path, 1000);
+		int fd              = open(path.c_str(), O_RDWR);
+		void* addr          = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		REQUIRE(addr != MAP_FAILED);
+
+		auto* header = static_cast<SharedMetrics::Header*>(addr);
+		std::vector<uint8_t> snapshot;
+		uint64_t loopLag;
+
+		// Pretend the writer is in the middle of an update.
+		header->sequence.fetch_add(1);
+
+		REQUIRE(!SharedMetrics::Read(static_cast<const uint8_t*>(addr), snapshot, loopLag));
+
+		header->sequence.fetch_add(1);
+
+		REQUIRE(SharedMetrics::Read(static_cast<const uint8_t*>(addr), snapshot, loopLag));
+
+		munmap(addr, regionSize);
+		close(fd);
+		delete sharedMetrics;
+	}
+}